@@ -15,6 +15,7 @@
 #include "RetroAchievements.h"
 #include "utils/ZipFile.h"
 #include "Paths.h"
+#include "FileHashCache.h"
 #include "utils/VectorEx.h"
 #include "LocaleES.h"
 #include "MusicStartupHelper.h"
@@ -1123,6 +1124,15 @@ std::string ApiSystem::getMD5(const std::string fileName, bool fromZipContents)
 
 	// 7za x -so test.7z | md5sum
 	std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(fileName));
+
+	bool fromArchive = fromZipContents && (ext == ".zip" || ext == ".7z");
+	if (fromArchive)
+	{
+		std::string hash;
+		if (FileHashCache::getInstance()->find("md5z", fileName, hash))
+			return hash;
+	}
+
 	if (ext == ".zip" && fromZipContents)
 	{
 		Utils::Zip::ZipFile file;
@@ -1145,7 +1155,11 @@ std::string ApiSystem::getMD5(const std::string fileName, bool fromZipContents)
 			}
 
 			if (!romName.empty())
-				return file.getFileMd5(romName);
+			{
+				std::string hash = file.getFileMd5(romName);
+				FileHashCache::getInstance()->update("md5z", fileName, hash);
+				return hash;
+			}
 		}
 	}
 
@@ -1155,7 +1169,11 @@ std::string ApiSystem::getMD5(const std::string fileName, bool fromZipContents)
 		auto cmd = getSevenZipCommand() + " x -so \"" + fileName + "\" | md5sum";
 		auto ret = executeEnumerationScript(cmd);
 		if (ret.size() == 1 && ret.cbegin()->length() >= 32)
-			return ret.cbegin()->substr(0, 32);
+		{
+			std::string hash = ret.cbegin()->substr(0, 32);
+			FileHashCache::getInstance()->update("md5z", fileName, hash);
+			return hash;
+		}
 	}
 #endif
 
@@ -1182,11 +1200,14 @@ std::string ApiSystem::getMD5(const std::string fileName, bool fromZipContents)
 		// if there's no file or many files ? get md5 of archive
 	}
 
-	ret = Utils::FileSystem::getFileMd5(contentFile);
+	ret = FileHashCache::getInstance()->getFileMd5(contentFile);
 
 	if (!tmpZipDirectory.empty())
 		Utils::FileSystem::deleteDirectoryFiles(tmpZipDirectory, true);
 
+	if (fromArchive)
+		FileHashCache::getInstance()->update("md5z", fileName, ret);
+
 	LOG(LogDebug) << "getMD5 << " << ret;
 
 	return ret;
@@ -1198,6 +1219,13 @@ std::string ApiSystem::getCRC32(std::string fileName, bool fromZipContents)
 
 	std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(fileName));
 
+	if (fromZipContents && (ext == ".zip" || ext == ".7z"))
+	{
+		std::string hash;
+		if (FileHashCache::getInstance()->find("crc32z", fileName, hash))
+			return hash;
+	}
+
 	if (ext == ".7z" && fromZipContents)
 	{
 		LOG(LogDebug) << "getCRC32 is using 7z";
@@ -1208,10 +1236,18 @@ std::string ApiSystem::getCRC32(std::string fileName, bool fromZipContents)
 		for (std::string all : lines)
 		{
 			int idx = all.find("CRC = ");
+			std::string hash;
+
 			if (idx != std::string::npos)
-				return all.substr(idx + 6);
+				hash = all.substr(idx + 6);
 			else if (all.find(fn) == (all.size() - fn.size()) && all.length() > 8 && all[9] == ' ')
-				return all.substr(0, 8);
+				hash = all.substr(0, 8);
+
+			if (!hash.empty())
+			{
+				FileHashCache::getInstance()->update("crc32z", fileName, hash);
+				return hash;
+			}
 		}
 	}
 	else if (ext == ".zip" && fromZipContents)
@@ -1238,12 +1274,16 @@ std::string ApiSystem::getCRC32(std::string fileName, bool fromZipContents)
 			}
 
 			if (!romName.empty())
-				return file.getFileCrc(romName);
+			{
+				std::string hash = file.getFileCrc(romName);
+				FileHashCache::getInstance()->update("crc32z", fileName, hash);
+				return hash;
+			}
 		}
 	}
 
 	LOG(LogDebug) << "getCRC32 is using fileBuffer";
-	return Utils::FileSystem::getFileCrc32(fileName);
+	return FileHashCache::getInstance()->getFileCrc32(fileName);
 }
 
 bool ApiSystem::unzipFile(const std::string fileName, const std::string destFolder, const std::function<bool(const std::string)>& shouldExtract)
@@ -390,6 +390,14 @@ void CollectionSystemManager::updateSystemsList()
 	// remove all Collection Systems
 	removeCollectionsFromDisplayedSystems();
 
+	// The enabled auto collections and "all", where custom collections look up their games, in a single walk of the games
+	std::vector<CollectionSystemData*> autoCollectionsToPopulate;
+	for (auto& it : mAutoCollectionSystemsData)
+		if ((it.second.isEnabled || it.first == "all") && !it.second.isPopulated)
+			autoCollectionsToPopulate.push_back(&it.second);
+
+	populateAutoCollections(autoCollectionsToPopulate, Settings::getInstance()->getBool("ThreadedLoading"));
+
 	std::unordered_map<std::string, FileData*> map;
 	getAllGamesCollection()->getRootFolder()->createChildrenByFilenameMap(map);
 
@@ -434,33 +442,125 @@ void CollectionSystemManager::updateSystemsList()
 }
 
 /* Methods to manage collection files related to a source FileData */
+static bool matchesAutoCollection(FileData* game, const CollectionSystemDecl& sysDecl, bool isArcade);
+
+CollectionSystemData* CollectionSystemManager::findCollectionData(SystemData* system)
+{
+	auto autoIt = mAutoCollectionSystemsData.find(system->getName());
+	if (autoIt != mAutoCollectionSystemsData.cend() && autoIt->second.system == system)
+		return &autoIt->second;
+
+	auto customIt = mCustomCollectionSystemsData.find(system->getName());
+	if (customIt != mCustomCollectionSystemsData.cend() && customIt->second.system == system)
+		return &customIt->second;
+
+	return nullptr;
+}
+
+// Same filters as populateAutoCollections, for a single game
+bool CollectionSystemManager::isAutoCollectionCandidate(FileData* file)
+{
+	SystemData* system = file->getSourceFileData()->getSystem();
+	if (system == nullptr || !system->isGameSystem() || system->isCollection())
+		return false;
+
+	if (system->hasPlatformId(PlatformIds::PLATFORM_IGNORE) || system->hasPlatformId(PlatformIds::IMAGEVIEWER))
+		return false;
+
+	if (!Settings::HiddenSystemsShowGames())
+	{
+		auto hiddenSystems = Utils::String::split(Settings::getInstance()->getString("HiddenSystems"), ';');
+		if (std::find(hiddenSystems.cbegin(), hiddenSystems.cend(), system->getName()) != hiddenSystems.cend())
+			return false;
+	}
+
+	if (!includeFileInAutoCollections(file))
+		return false;
+
+	auto hiddenExts = Settings::getInstance()->getString(system->getName() + ".HiddenExt");
+	if (!hiddenExts.empty())
+	{
+		std::string extlow = Utils::String::toLower(Utils::FileSystem::getExtension(file->getFileName()));
+
+		for (auto ext : Utils::String::split(hiddenExts, ';'))
+			if ("." + Utils::String::toLower(ext) == extlow)
+				return false;
+	}
+
+	return true;
+}
+
 // updates all collection files related to the source file
+// Only the collections that hold the file, and the auto collections whose predicate it now matches, are updated
 void CollectionSystemManager::refreshCollectionSystems(FileData* file)
 {
 	if (!file->getSystem()->isGameSystem() || file->getType() != GAME)
 		return;
 
-	std::map<std::string, CollectionSystemData> allCollections;
-	allCollections.insert(mAutoCollectionSystemsData.cbegin(), mAutoCollectionSystemsData.cend());
-	allCollections.insert(mCustomCollectionSystemsData.cbegin(), mCustomCollectionSystemsData.cend());
+	// Entries may be deleted by updateCollectionSystem : only keep their systems
+	std::vector<SystemData*> entrySystems;
+	for (auto entry : CollectionFileData::getCollectionEntries(file->getSourceFileData()))
+		if (std::find(entrySystems.cbegin(), entrySystems.cend(), entry->getSystem()) == entrySystems.cend())
+			entrySystems.push_back(entry->getSystem());
+
+	// Evaluated once for every collection the file is checked against
+	bool isCandidate = isAutoCollectionCandidate(file);
+
+	for (auto system : entrySystems)
+	{
+		auto sysData = findCollectionData(system);
+		if (sysData != nullptr)
+			updateCollectionSystem(file, *sysData, isCandidate);
+	}
+
+	if (!isCandidate)
+		return;
+
+	bool isArcade = file->getSourceFileData()->getSystem()->hasPlatformId(PlatformIds::ARCADE);
+
+	for (auto& it : mAutoCollectionSystemsData)
+	{
+		if (!it.second.isPopulated || std::find(entrySystems.cbegin(), entrySystems.cend(), it.second.system) != entrySystems.cend())
+			continue;
 
-	for (auto sys : allCollections)
-		updateCollectionSystem(file, sys.second);
+		if (matchesAutoCollection(file, it.second.decl, isArcade))
+			updateCollectionSystem(file, it.second, isCandidate);
+	}
 }
 
 void CollectionSystemManager::updateCollectionSystem(FileData* file, const CollectionSystemData& sysData)
+{
+	if (sysData.isPopulated)
+		updateCollectionSystem(file, sysData, !sysData.decl.isCustom && isAutoCollectionCandidate(file));
+}
+
+void CollectionSystemManager::updateCollectionSystem(FileData* file, const CollectionSystemData& sysData, bool isAutoCandidate)
 {
 	if (!sysData.isPopulated)
 		return;
 
-	// collection files use the full path as key, to avoid clashes
-	std::string key = file->getFullPath();
-
 	SystemData* curSys = sysData.system;
-	FileData*   collectionEntry = curSys->getRootFolder()->FindByPath(key);
 	FolderData* rootFolder = curSys->getRootFolder();
 	std::string name = curSys->getName();
 
+	FileData* collectionEntry = nullptr;
+	for (auto entry : CollectionFileData::getCollectionEntries(file->getSourceFileData()))
+	{
+		if (entry->getSystem() == curSys)
+		{
+			collectionEntry = entry;
+			break;
+		}
+	}
+
+	// Auto collections follow their predicate, custom collections only change on user request
+	bool isMember = collectionEntry != nullptr;
+	if (!sysData.decl.isCustom)
+		isMember = isAutoCandidate && matchesAutoCollection(file, sysData.decl, file->getSourceFileData()->getSystem()->hasPlatformId(PlatformIds::ARCADE));
+
+	if (collectionEntry == nullptr && !isMember)
+		return;
+
 	auto view = ViewController::get()->getGameListView(curSys, false);
 
 	if (collectionEntry != nullptr)
@@ -469,7 +569,7 @@ void CollectionSystemManager::updateCollectionSystem(FileData* file, const Colle
 		curSys->removeFromIndex(collectionEntry);
 
 		// found and we are removing
-		if (name == "favorites" && !file->getFavorite())
+		if (!isMember)
 		{
 			if (view != nullptr)
 				view.get()->remove(collectionEntry);
@@ -486,14 +586,9 @@ void CollectionSystemManager::updateCollectionSystem(FileData* file, const Colle
 	}
 	else
 	{
-		// we didn't find it here - we need to check if we should add it
-		if (name == "recent" && file->getMetadata(MetaDataId::PlayCount) > "0" && includeFileInAutoCollections(file) ||
-			name == "favorites" && file->getFavorite())
-		{
-			auto newGame = new CollectionFileData(file, curSys);
-			rootFolder->addChild(newGame);
-			curSys->addToIndex(newGame);
-		}
+		auto newGame = new CollectionFileData(file, curSys);
+		rootFolder->addChild(newGame);
+		curSys->addToIndex(newGame);
 	}
 
 	curSys->updateDisplayedGameCount();
@@ -541,28 +636,19 @@ void CollectionSystemManager::trimCollectionCount(FolderData* rootFolder, int li
 }
 
 // deletes all collection files from collection systems related to the source file
-void CollectionSystemManager::deleteCollectionFiles(FileData* file)
+// saveCustomCollections is false for roms that disappeared from disk : custom collection files keep them, as they do on a full reload
+void CollectionSystemManager::deleteCollectionFiles(FileData* file, bool saveCustomCollections)
 {
-	// collection files use the full path as key, to avoid clashes
-	std::string key = file->getFullPath();
-
-	// find games in collection systems
-	std::map<std::string, CollectionSystemData> allCollections;
-	allCollections.insert(mAutoCollectionSystemsData.cbegin(), mAutoCollectionSystemsData.cend());
-	allCollections.insert(mCustomCollectionSystemsData.cbegin(), mCustomCollectionSystemsData.cend());
-
-	for (auto sysDataIt = allCollections.begin(); sysDataIt != allCollections.end(); sysDataIt++)
+	for (auto collectionEntry : CollectionFileData::getCollectionEntries(file->getSourceFileData()))
 	{
-		if (!sysDataIt->second.isPopulated)
+		auto sysData = findCollectionData(collectionEntry->getSystem());
+		if (sysData == nullptr || !sysData->isPopulated)
 			continue;
 
-		FileData* collectionEntry = (sysDataIt->second.system)->getRootFolder()->FindByPath(key);
-		if (collectionEntry == nullptr)
-			continue;
-		
-		sysDataIt->second.needsSave = true;
+		if (sysData->decl.isCustom && saveCustomCollections)
+			sysData->needsSave = true;
 
-		SystemData* systemViewToUpdate = getSystemToView(sysDataIt->second.system);
+		SystemData* systemViewToUpdate = getSystemToView(sysData->system);
 		if (systemViewToUpdate == nullptr)
 			continue;
 
@@ -951,16 +1037,79 @@ SystemData* CollectionSystemManager::createNewCollectionEntry(std::string name,
 	return newSys;
 }
 
+// Tells if a game that passed the common filters belongs to an Automatic Collection System
+static bool matchesAutoCollection(FileData* game, const CollectionSystemDecl& sysDecl, bool isArcade)
+{
+	switch (sysDecl.type)
+	{
+	case AUTO_ALL_GAMES:
+		return true;
+	case AUTO_VERTICALARCADE:
+		return game->isVerticalArcadeGame();
+	case AUTO_LIGHTGUN:
+		return game->isLightGunGame();
+	case AUTO_WHEEL:
+		return game->isWheelGame();
+	case AUTO_TRACKBALL:
+		return game->isTrackballGame();
+	case AUTO_SPINNER:
+		return game->isSpinnerGame();
+	case AUTO_RETROACHIEVEMENTS:
+		return game->hasCheevos();
+	case AUTO_LAST_PLAYED:
+		return game->getMetadata(MetaDataId::PlayCount) > "0";
+	case AUTO_NEVER_PLAYED:
+		return !(game->getMetadata(MetaDataId::PlayCount) > "0");
+	case AUTO_FAVORITES:
+		// we may still want to add files we don't want in auto collections in "favorites"
+		return game->getFavorite();
+	case AUTO_ARCADE:
+		return isArcade;
+	case AUTO_AT2PLAYERS: 
+	case AUTO_AT4PLAYERS:
+	{
+		std::string players = game->getMetadata(MetaDataId::Players);
+		if (players.empty())
+			return false;
+
+		auto range = game->parsePlayersRange();
+
+		int val = (sysDecl.type == AUTO_AT2PLAYERS ? 2 : 4);
+		return range.first <= 0 ? (val == range.second) : (range.first <= val && val <= range.second);
+	}
+	default:
+		if (!sysDecl.isCustom && !sysDecl.displayIfEmpty)
+		{
+			if (sysDecl.isGenreCollection())
+				return Genres::genreExists(&game->getMetadata(), ((int)sysDecl.type) - 10000);
+			else if (sysDecl.isArcadeSubSystem())
+				return isArcade && game->getMetadata(MetaDataId::ArcadeSystemName) == sysDecl.themeFolder;
+		}
+
+		break;
+	}
+
+	return true;
+}
+
 // populates an Automatic Collection System
 void CollectionSystemManager::populateAutoCollection(CollectionSystemData* sysData)
 {
-	SystemData* newSys = sysData->system;
-	CollectionSystemDecl sysDecl = sysData->decl;
-	FolderData* rootFolder = newSys->getRootFolder();
+	populateAutoCollections({ sysData });
+}
+
+// populates several Automatic Collection Systems with a single walk of the game systems : each game is routed to every collection it matches.
+// With threaded, the game systems are walked in parallel ; collections are filled afterwards in the usual system order.
+void CollectionSystemManager::populateAutoCollections(const std::vector<CollectionSystemData*>& collections, bool threaded)
+{
+	if (collections.size() == 0)
+		return;
 
 	bool hiddenSystemsShowGames = Settings::HiddenSystemsShowGames();
 	auto hiddenSystems = Utils::String::split(Settings::getInstance()->getString("HiddenSystems"), ';');
 
+	std::vector<SystemData*> systems;
+
 	for (auto& system : SystemData::sSystemVector)
 	{
 		// we won't iterate all collections
@@ -973,6 +1122,17 @@ void CollectionSystemManager::populateAutoCollection(CollectionSystemData* sysDa
 		if (system->hasPlatformId(PlatformIds::PLATFORM_IGNORE) || system->hasPlatformId(PlatformIds::IMAGEVIEWER))
 			continue;
 
+		systems.push_back(system);
+	}
+
+	// matches[system][collection] : games of a system for each collection
+	std::vector<std::vector<std::vector<FileData*>>> matches(systems.size(), std::vector<std::vector<FileData*>>(collections.size()));
+
+	auto scanSystem = [this, &systems, &collections, &matches](size_t systemIndex)
+	{
+		SystemData* system = systems[systemIndex];
+		auto& systemMatches = matches[systemIndex];
+
 		bool isArcade = system->hasPlatformId(PlatformIds::ARCADE);
 
 		std::vector<std::string> hiddenExts;
@@ -985,8 +1145,7 @@ void CollectionSystemManager::populateAutoCollection(CollectionSystemData* sysDa
 			if (system->isGroupSystem() && game->getSystem() != system)
 				continue;
 
-			bool include = includeFileInAutoCollections(game);
-			if (!include)
+			if (!includeFileInAutoCollections(game))
 				continue;
 
 			if (hiddenExts.size() > 0 && game->getType() == GAME)
@@ -996,86 +1155,52 @@ void CollectionSystemManager::populateAutoCollection(CollectionSystemData* sysDa
 					continue;
 			}
 
-			switch (sysDecl.type)
-			{
-			case AUTO_ALL_GAMES:
-				break;
-			case AUTO_VERTICALARCADE:
-				include = game->isVerticalArcadeGame();
-				break;
-			case AUTO_LIGHTGUN:
-				include = game->isLightGunGame();
-				break;
-			case AUTO_WHEEL:
-				include = game->isWheelGame();
-				break;
-			case AUTO_TRACKBALL:
-				include = game->isTrackballGame();
-				break;
-			case AUTO_SPINNER:
-				include = game->isSpinnerGame();
-				break;
-			case AUTO_RETROACHIEVEMENTS:
-				include = game->hasCheevos();
-				break;
-			case AUTO_LAST_PLAYED:
-				include = game->getMetadata(MetaDataId::PlayCount) > "0";
-				break;
-			case AUTO_NEVER_PLAYED:
-				include = !(game->getMetadata(MetaDataId::PlayCount) > "0");
-				break;
-			case AUTO_FAVORITES:
-				// we may still want to add files we don't want in auto collections in "favorites"
-				include = game->getFavorite();
-				break;
-			case AUTO_ARCADE:
-				include = isArcade;
-				break;
-			case AUTO_AT2PLAYERS: 
-			case AUTO_AT4PLAYERS:
-			{
-				std::string players = game->getMetadata(MetaDataId::Players);
-				if (players.empty())
-					include = false;
-				else
-				{
-					auto range = game->parsePlayersRange();
+			for (size_t i = 0; i < collections.size(); i++)
+				if (matchesAutoCollection(game, collections[i]->decl, isArcade))
+					systemMatches[i].push_back(game);
+		}
+	};
 
-					int val = (sysDecl.type == AUTO_AT2PLAYERS ? 2 : 4);
-					include = range.first <= 0 ? (val == range.second) : (range.first <= val && val <= range.second);
-				}
-			}
-			break;
+	if (threaded && systems.size() > 1)
+	{
+		Utils::ThreadPool pool;
 
-			default:
-				if (!sysDecl.isCustom && !sysDecl.displayIfEmpty)
-				{
-					if (sysDecl.isGenreCollection())
-						include = Genres::genreExists(&game->getMetadata(), ((int)sysDecl.type) - 10000);
-					else if (sysDecl.isArcadeSubSystem())
-						include = isArcade && game->getMetadata(MetaDataId::ArcadeSystemName) == sysDecl.themeFolder;
-				}
+		for (size_t i = 0; i < systems.size(); i++)
+			pool.queueWorkItem([&scanSystem, i] { scanSystem(i); });
 
-				break;
-			}
+		pool.wait();
+	}
+	else
+	{
+		for (size_t i = 0; i < systems.size(); i++)
+			scanSystem(i);
+	}
+
+	for (size_t i = 0; i < collections.size(); i++)
+	{
+		CollectionSystemData* sysData = collections[i];
+		SystemData* newSys = sysData->system;
+		FolderData* rootFolder = newSys->getRootFolder();
 
-			if (include)
+		for (auto& systemMatches : matches)
+		{
+			for (auto game : systemMatches[i])
 			{
 				CollectionFileData* newGame = new CollectionFileData(game, newSys);
 				rootFolder->addChild(newGame);
 				newSys->addToIndex(newGame);
 			}
 		}
-	}
 
-	if (sysDecl.type == AUTO_LAST_PLAYED)
-	{
-		sortLastPlayed(newSys);
-		trimCollectionCount(rootFolder, LAST_PLAYED_MAX);
-	}
+		if (sysData->decl.type == AUTO_LAST_PLAYED)
+		{
+			sortLastPlayed(newSys);
+			trimCollectionCount(rootFolder, LAST_PLAYED_MAX);
+		}
 
-	sysData->isPopulated = true;
-	updateCollectionFolderMetadata(newSys);
+		sysData->isPopulated = true;
+		updateCollectionFolderMetadata(newSys);
+	}
 }
 
 // populates a Custom Collection System
@@ -1204,29 +1329,25 @@ void CollectionSystemManager::removeCollectionsFromDisplayedSystems()
 
 void CollectionSystemManager::addEnabledCollectionsToDisplayedSystems(std::map<std::string, CollectionSystemData>* colSystemData, std::unordered_map<std::string, FileData*>* pMap)
 {
-	if (Settings::getInstance()->getBool("ThreadedLoading"))
-	{
-		std::vector<CollectionSystemData*> collectionsToPopulate;
-		for (auto it = colSystemData->begin(); it != colSystemData->end(); it++)
-			if (it->second.isEnabled && !it->second.isPopulated)
-				collectionsToPopulate.push_back(&(it->second));
+	bool threaded = Settings::getInstance()->getBool("ThreadedLoading");
 
-		if (collectionsToPopulate.size() > 1)
-		{
-			getAllGamesCollection();
+	// Auto collections are populated by updateSystemsList
+	std::vector<CollectionSystemData*> customCollectionsToPopulate;
 
-			Utils::ThreadPool pool;
+	for (auto it = colSystemData->begin(); it != colSystemData->end(); it++)
+		if (it->second.isEnabled && !it->second.isPopulated && it->second.decl.isCustom)
+			customCollectionsToPopulate.push_back(&(it->second));
 
-			for (auto collection : collectionsToPopulate)
-			{
-				if (collection->decl.isCustom)
-					pool.queueWorkItem([this, collection, pMap] { populateCustomCollection(collection, pMap); });
-				else
-					pool.queueWorkItem([this, collection, pMap] { populateAutoCollection(collection); });
-			}
+	if (threaded && customCollectionsToPopulate.size() > 1)
+	{
+		getAllGamesCollection();
 
-			pool.wait();
-		}
+		Utils::ThreadPool pool;
+
+		for (auto collection : customCollectionsToPopulate)
+			pool.queueWorkItem([this, collection, pMap] { populateCustomCollection(collection, pMap); });
+
+		pool.wait();
 	}
 
 	// add auto enabled ones
@@ -42,8 +42,8 @@ struct CollectionSystemDecl
 	bool isCustom;	
     bool displayIfEmpty;
 
-	bool isArcadeSubSystem() { return (int)type >= 1000 && (int)type < 10000; }
-	bool isGenreCollection() { return (int)type >= 10000 && (int)type < 20000; }
+	bool isArcadeSubSystem() const { return (int)type >= 1000 && (int)type < 10000; }
+	bool isGenreCollection() const { return (int)type >= 10000 && (int)type < 20000; }
 };
 
 struct CollectionSystemData
@@ -77,7 +77,7 @@ public:
 
 	void refreshCollectionSystems(FileData* file);
 	void updateCollectionSystem(FileData* file, const CollectionSystemData& sysData);
-	void deleteCollectionFiles(FileData* file);
+	void deleteCollectionFiles(FileData* file, bool saveCustomCollections = true);
 
 	inline std::map<std::string, CollectionSystemData>& getAutoCollectionSystems() { return mAutoCollectionSystemsData; };
 	inline std::map<std::string, CollectionSystemData> getCustomCollectionSystems() { return mCustomCollectionSystemsData; };
@@ -94,6 +94,7 @@ public:
 
 	void reloadCollection(const std::string collectionName, bool repopulateGamelist = true);
     void populateAutoCollection(CollectionSystemData* sysData);
+	void populateAutoCollections(const std::vector<CollectionSystemData*>& collections, bool threaded = false);
 	bool deleteCustomCollection(CollectionSystemData* data);
 
 	bool isCustomCollection(const std::string collectionName);
@@ -133,6 +134,10 @@ private:
 	bool themeFolderExists(std::string folder);
 
 	bool includeFileInAutoCollections(FileData* file);
+	bool isAutoCollectionCandidate(FileData* file);
+	void updateCollectionSystem(FileData* file, const CollectionSystemData& sysData, bool isAutoCandidate);
+
+	CollectionSystemData* findCollectionData(SystemData* system);
 
 	void updateSystemsFromTheme();	
 	std::vector<std::string> mSystemsFromTheme;
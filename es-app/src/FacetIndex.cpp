@@ -0,0 +1,76 @@
+#include "FacetIndex.h"
+
+#include <algorithm>
+
+void FacetIndex::add(uint32_t ordinal, const std::vector<std::string>& keys)
+{
+	remove(ordinal);
+
+	if (ordinal >= mGameKeys.size())
+		mGameKeys.resize(ordinal + 1);
+
+	auto& gameKeys = mGameKeys[ordinal];
+
+	for (const auto& key : keys)
+	{
+		uint32_t id;
+
+		auto it = mKeyIds.find(key);
+		if (it == mKeyIds.cend())
+		{
+			id = (uint32_t)mPostings.size();
+			mKeyIds[key] = id;
+			mPostings.push_back(std::vector<uint32_t>());
+		}
+		else
+			id = it->second;
+
+		if (std::find(gameKeys.cbegin(), gameKeys.cend(), id) != gameKeys.cend())
+			continue;
+
+		gameKeys.push_back(id);
+
+		auto& posting = mPostings[id];
+		if (posting.empty() || posting.back() < ordinal)
+			posting.push_back(ordinal);
+		else
+			posting.insert(std::lower_bound(posting.begin(), posting.end(), ordinal), ordinal);
+	}
+}
+
+void FacetIndex::remove(uint32_t ordinal)
+{
+	if (ordinal >= mGameKeys.size())
+		return;
+
+	for (auto id : mGameKeys[ordinal])
+	{
+		auto& posting = mPostings[id];
+
+		auto pos = std::lower_bound(posting.begin(), posting.end(), ordinal);
+		if (pos != posting.end() && *pos == ordinal)
+			posting.erase(pos);
+	}
+
+	mGameKeys[ordinal].clear();
+}
+
+void FacetIndex::clear()
+{
+	mKeyIds.clear();
+	mPostings.clear();
+	mGameKeys.clear();
+}
+
+void FacetIndex::collect(const std::unordered_set<std::string>& keys, OrdinalBitset& bits) const
+{
+	for (const auto& key : keys)
+	{
+		auto it = mKeyIds.find(key);
+		if (it == mKeyIds.cend())
+			continue;
+
+		for (auto ordinal : mPostings[it->second])
+			bits.set(ordinal);
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef ES_APP_FACET_INDEX_H
+#define ES_APP_FACET_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+
+// Set of game ordinals, one bit per game
+class OrdinalBitset
+{
+public:
+	OrdinalBitset() : mCount(0) { }
+
+	void assign(size_t count, bool value)
+	{
+		mCount = count;
+		mWords.assign((count + 63) / 64, value ? ~(uint64_t)0 : 0);
+	}
+
+	inline void set(uint32_t ordinal) { if (ordinal < mCount) mWords[ordinal >> 6] |= (uint64_t)1 << (ordinal & 63); }
+	inline void reset(uint32_t ordinal) { if (ordinal < mCount) mWords[ordinal >> 6] &= ~((uint64_t)1 << (ordinal & 63)); }
+	inline bool test(uint32_t ordinal) const { return ordinal < mCount && (mWords[ordinal >> 6] & ((uint64_t)1 << (ordinal & 63))) != 0; }
+
+	void andWith(const OrdinalBitset& other)
+	{
+		for (size_t i = 0; i < mWords.size(); i++)
+			mWords[i] &= (i < other.mWords.size() ? other.mWords[i] : 0);
+	}
+
+	inline size_t size() const { return mCount; }
+	inline void clear() { mWords.clear(); mCount = 0; }
+
+private:
+	std::vector<uint64_t>	mWords;
+	size_t					mCount;
+};
+
+// Posting lists of game ordinals for every value of a filter ( genre, year... )
+class FacetIndex
+{
+public:
+	void add(uint32_t ordinal, const std::vector<std::string>& keys);
+	void remove(uint32_t ordinal);
+	void clear();
+
+	// Sets the bits of the games indexed under any of the keys
+	void collect(const std::unordered_set<std::string>& keys, OrdinalBitset& bits) const;
+
+private:
+	std::unordered_map<std::string, uint32_t>	mKeyIds;
+	std::vector<std::vector<uint32_t>>			mPostings;	// key id -> sorted ordinals
+	std::vector<std::vector<uint32_t>>			mGameKeys;	// ordinal -> key ids, so removal doesn't depend on current metadata
+};
+
+#endif // ES_APP_FACET_INDEX_H
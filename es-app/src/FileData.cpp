@@ -95,6 +95,10 @@ void FileData::setPath(const std::string& newPath)
     {
         LOG(LogDebug) << "FileData path changed from '" << mPath << "' to '" << newPath << "'";
         mPath = newPath;
+
+        // The display name comes from the file name
+        delete mDisplayName;
+        mDisplayName = nullptr;
         // You might want to mark metadata dirty here if path changes should trigger a save,
         // or ensure this is handled by the caller.
         // For example: mMetadata.setDirty();
@@ -255,23 +259,24 @@ const std::string FileData::getThumbnailPath(bool fallbackWithImage)
 
 const bool FileData::getFavorite() const
 {
-	return getMetadata(MetaDataId::Favorite) == "true";
+	return getMetadata().getBool(MetaDataId::Favorite);
 }
 
 const bool FileData::getHidden() const
 {
-	return getMetadata(MetaDataId::Hidden) == "true";
+	return getMetadata().getBool(MetaDataId::Hidden);
 }
 
 const bool FileData::getKidGame() const
 {
-	auto data = getMetadata(MetaDataId::KidGame);
+	std::string buffer;
+	auto data = getMetadata().getView(MetaDataId::KidGame, buffer);
 	return data != "false" && !data.empty();
 }
 
 const bool FileData::hasCheevos()
 {
-	if (Utils::String::toInteger(getMetadata(MetaDataId::CheevosId)) > 0)
+	if (getMetadata().getInt(MetaDataId::CheevosId) > 0)
 		return getSourceFileData()->getSystem()->isCheevosSupported();
 
 	return false;
@@ -1093,11 +1098,28 @@ void FileData::deleteGameFiles()
 		Utils::FileSystem::removeFile(contentFile);
 }
 
+std::mutex CollectionFileData::sEntriesLock;
+std::unordered_map<FileData*, std::vector<CollectionFileData*>> CollectionFileData::sEntries;
+
 CollectionFileData::CollectionFileData(FileData* file, SystemData* system)
 	: FileData(file->getSourceFileData()->getType(), "", system)
 {
 	mSourceFileData = file->getSourceFileData();
 	mParent = NULL;	
+
+	std::unique_lock<std::mutex> lock(sEntriesLock);
+	sEntries[mSourceFileData].push_back(this);
+}
+
+std::vector<CollectionFileData*> CollectionFileData::getCollectionEntries(FileData* sourceFile)
+{
+	std::unique_lock<std::mutex> lock(sEntriesLock);
+
+	auto it = sEntries.find(sourceFile);
+	if (it == sEntries.cend())
+		return std::vector<CollectionFileData*>();
+
+	return it->second;
 }
 
 SystemEnvironmentData* CollectionFileData::getSystemEnvData() const
@@ -1122,6 +1144,17 @@ CollectionFileData::~CollectionFileData()
 		mParent->removeChild(this);
 
 	mParent = NULL;
+
+	std::unique_lock<std::mutex> lock(sEntriesLock);
+
+	auto it = sEntries.find(mSourceFileData);
+	if (it != sEntries.cend())
+	{
+		auto& entries = it->second;
+		entries.erase(std::remove(entries.begin(), entries.end(), this), entries.end());
+		if (entries.size() == 0)
+			sEntries.erase(it);
+	}
 }
 
 std::string CollectionFileData::getKey() 
@@ -1265,40 +1298,54 @@ const std::vector<FileData*> FolderData::getChildrenListToDisplay()
 	const FileSorts::SortType& sort = FileSorts::getSortTypes().at(currentSortId);
 
 	if (idx != nullptr && idx->hasRelevency())
-	{
-		auto compf = sort.comparisonFunction;
-
-		std::sort(ret.begin(), ret.end(), [scoringBoard, compf](const FileData* file1, const FileData* file2) -> bool
-		{ 
-			auto s1 = scoringBoard.find((FileData*) file1);
-			auto s2 = scoringBoard.find((FileData*) file2);		
-
-			if (s1 != scoringBoard.cend() && s2 != scoringBoard.cend() && s1->second != s2->second)
-				return s1->second < s2->second;
-			
-			return compf(file1, file2);
-		});
-	}
+		FileSorts::sortFiles(ret, sort.id, true, false, false, &scoringBoard);
 	else
 	{
 		bool foldersFirst = Settings::ShowFoldersFirst();
 		bool favoritesFirst = getSystem()->getShowFavoritesFirst();
 
-		std::stable_sort(ret.begin(), ret.end(), [sort, foldersFirst, favoritesFirst](const FileData* file1, const FileData* file2) -> bool
-			{
-				if (favoritesFirst && file1->getFavorite() != file2->getFavorite())
-					return file1->getFavorite();
-
-				if (foldersFirst && file1->getType() != file2->getType())
-					return (file1->getType() == FOLDER);
+		int flags = (foldersFirst ? 1 : 0) | (favoritesFirst ? 2 : 0) | (Settings::IgnoreLeadingArticles() ? 4 : 0);
+		if (!getCachedSort(currentSortId, flags, ret))
+		{
+			// Read the counter before extracting the keys : a change made meanwhile invalidates the result
+			unsigned int changeCount = MetaDataList::getChangeCount();
 
-				return sort.comparisonFunction(file1, file2) == sort.ascending;
-			});
+			std::vector<FileData*> input = ret;
+			FileSorts::sortFiles(ret, sort.id, sort.ascending, foldersFirst, favoritesFirst);
+			setCachedSort(currentSortId, flags, changeCount, input, ret);
+		}
 	}
 
 	return ret;
 }
 
+bool FolderData::getCachedSort(unsigned int sortId, int flags, std::vector<FileData*>& list)
+{
+	std::unique_lock<std::mutex> lock(mSortedListsLock);
+
+	auto it = mSortedLists.find(sortId);
+	if (it == mSortedLists.cend())
+		return false;
+
+	const SortedList& sorted = it->second;
+	if (sorted.changeCount != MetaDataList::getChangeCount() || sorted.flags != flags || sorted.input != list)
+		return false;
+
+	list = sorted.output;
+	return true;
+}
+
+void FolderData::setCachedSort(unsigned int sortId, int flags, unsigned int changeCount, const std::vector<FileData*>& input, const std::vector<FileData*>& output)
+{
+	std::unique_lock<std::mutex> lock(mSortedListsLock);
+
+	SortedList& sorted = mSortedLists[sortId];
+	sorted.changeCount = changeCount;
+	sorted.flags = flags;
+	sorted.input = input;
+	sorted.output = output;
+}
+
 std::shared_ptr<std::vector<FileData*>> FolderData::findChildrenListToDisplayAtCursor(FileData* toFind, std::stack<FileData*>& stack)
 {
 	auto items = getChildrenListToDisplay();
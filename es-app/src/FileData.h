@@ -9,6 +9,8 @@
 #include <memory>
 #include <vector>
 #include <stack>
+#include <map>
+#include <mutex>
 #include "KeyboardMapping.h"
 #include "SystemData.h"
 #include "SaveState.h"
@@ -230,9 +232,15 @@ public:
     // CORREZIONE QUI: L'override deve corrispondere al metodo base reso const
 	virtual const std::string& getDisplayName() const override;
 
+	// Collection entries of a source file, in every collection system. Kept up to date by the constructor & destructor
+	static std::vector<CollectionFileData*> getCollectionEntries(FileData* sourceFile);
+
 private:
 	// needs to be updated when metadata changes
 	FileData* mSourceFileData;
+
+	static std::mutex													 sEntriesLock;
+	static std::unordered_map<FileData*, std::vector<CollectionFileData*>> sEntries;
 };
 
 class FolderData : public FileData
@@ -276,9 +284,24 @@ private:
 	void getFilesRecursiveWithContext(std::vector<FileData*>& out, unsigned int typeMask, GetFileContext* filter, bool displayedOnly, SystemData* system, bool includeVirtualStorage) const;
 
 
+	// Last sorted display list per sort id : reused while the list & the metadata are unchanged
+	struct SortedList
+	{
+		unsigned int			changeCount;
+		int						flags;
+		std::vector<FileData*>	input;
+		std::vector<FileData*>	output;
+	};
+
+	bool getCachedSort(unsigned int sortId, int flags, std::vector<FileData*>& list);
+	void setCachedSort(unsigned int sortId, int flags, unsigned int changeCount, const std::vector<FileData*>& input, const std::vector<FileData*>& output);
+
 	std::vector<FileData*> mChildren;
 	bool	mOwnsChildrens;
 	bool	mIsDisplayableAsVirtualFolder;
+
+	std::map<unsigned int, SortedList>	mSortedLists;
+	std::mutex							mSortedListsLock;
 };
 
 #endif // ES_APP_FILE_DATA_H
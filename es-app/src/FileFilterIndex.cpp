@@ -8,6 +8,8 @@
 #include "LocaleES.h"
 
 #include <pugixml/src/pugixml.hpp>
+#include <algorithm>
+#include <cstring>
 
 #include "SystemData.h"
 #include "FileData.h"
@@ -21,6 +23,7 @@
 FileFilterIndex::FileFilterIndex()
 	: filterByFavorites(false), filterByGenre(false), filterByKidGame(false), filterByPlayers(false), filterByPubDev(false), filterByRatings(false), filterByYear(false)
 	, filterByLightGun(false), filterByWheel(false), filterByTrackball(false), filterBySpinner(false), filterByVertical(false), filterByCheevos(false), filterByPlayed(false), filterByRegion(false), filterByLang(false), filterByFamily(false), filterByHasMedia(false), filterByMissingMedia(false)
+	, mOrdinalCount(0), mFacetMatchesDirty(true)
 {
 	clearAllFilters();
 	FilterDataDecl filterDecls[] = 
@@ -51,6 +54,10 @@ FileFilterIndex::FileFilterIndex()
 	for (auto decl : filterDataDecl)
 		mFilterDecl[(int) decl.type] = decl;
 
+	FilterIndexType facetTypes[] = { GENRE_FILTER, FAMILY_FILTER, PLAYER_FILTER, PUBDEV_FILTER, YEAR_FILTER, LANG_FILTER, REGION_FILTER };
+	for (auto type : facetTypes)
+		mFacets[(int)type] = FacetIndex();
+
 	resetIndex();
 }
 
@@ -75,8 +82,7 @@ void FileFilterIndex::copyFrom(FileFilterIndex* indexToImport)
 	if (indexToImport == nullptr)
 		return;
 
-	mTextFilter = indexToImport->mTextFilter;
-	mUseRelevency = indexToImport->mUseRelevency;
+	setTextFilter(indexToImport->mTextFilter, indexToImport->mUseRelevency);
 
 	for (auto decl : indexToImport->mFilterDecl)
 	{
@@ -92,6 +98,8 @@ void FileFilterIndex::copyFrom(FileFilterIndex* indexToImport)
 
 		*src->second.filteredByRef = *decl.second.filteredByRef;
 	}
+
+	mFacetMatchesDirty = true;
 }
 
 void FileFilterIndex::importIndex(FileFilterIndex* indexToImport)
@@ -149,6 +157,17 @@ void FileFilterIndex::resetIndex()
 	mTextFilter = "";
 	clearAllFilters();
 
+	mTextIndex.clear();
+
+	for (auto& facet : mFacets)
+		facet.second.clear();
+
+	mGameOrdinals.clear();
+	mFreeOrdinals.clear();
+	mOrdinalVersions.clear();
+	mOrdinalCount = 0;
+	mFacetMatchesDirty = true;
+
 	clearIndex(genreIndexAllKeys);
 	clearIndex(familyIndexAllKeys);
 	clearIndex(playersIndexAllKeys);
@@ -446,10 +465,46 @@ void FileFilterIndex::addToIndex(FileData* game)
 	manageYearEntryInIndex(game);
 	manageLangEntryInIndex(game);
 	manageRegionEntryInIndex(game);		
+
+	uint32_t ordinal;
+
+	auto it = mGameOrdinals.find(game);
+	if (it != mGameOrdinals.cend())
+		ordinal = it->second;
+	else if (mFreeOrdinals.size())
+	{
+		ordinal = mFreeOrdinals.back();
+		mFreeOrdinals.pop_back();
+	}
+	else
+		ordinal = mOrdinalCount++;
+
+	mGameOrdinals[game] = ordinal;
+
+	if (ordinal >= mOrdinalVersions.size())
+		mOrdinalVersions.resize(ordinal + 1);
+
+	mOrdinalVersions[ordinal] = game->getMetadata().getVersion();
+
+	std::vector<std::string> keys;
+	for (auto& facet : mFacets)
+	{
+		keys.clear();
+		getFacetKeys(game, (FilterIndexType)facet.first, keys);
+		facet.second.add(ordinal, keys);
+	}
+
+	mTextIndex.add(ordinal, game->getSourceFileData()->getName());
+	mFacetMatchesDirty = true;
 }
 
 void FileFilterIndex::removeFromIndex(FileData* game)
 {
+	// Games detached from their system are removed before being deleted : don't decrement twice
+	auto it = mGameOrdinals.find(game);
+	if (it == mGameOrdinals.cend())
+		return;
+
 	manageGenreEntryInIndex(game, true);
 	manageFamilyEntryInIndex(game, true);
 	managePlayerEntryInIndex(game, true);
@@ -457,6 +512,143 @@ void FileFilterIndex::removeFromIndex(FileData* game)
 	manageYearEntryInIndex(game, true);
 	manageLangEntryInIndex(game, true);
 	manageRegionEntryInIndex(game, true);	
+
+	uint32_t ordinal = it->second;
+	mGameOrdinals.erase(it);
+
+	for (auto& facet : mFacets)
+		facet.second.remove(ordinal);
+
+	mTextIndex.remove(ordinal);
+	mFreeOrdinals.push_back(ordinal);
+	mFacetMatchesDirty = true;
+}
+
+int FileFilterIndex::getGameOrdinal(FileData* game)
+{
+	auto it = mGameOrdinals.find(game);
+	if (it == mGameOrdinals.cend())
+		return -1;
+
+	return (int)it->second;
+}
+
+// Returns the keys a game is indexed under for a filter : the game passes the filter in showFile if any of them is selected
+void FileFilterIndex::getFacetKeys(FileData* game, FilterIndexType type, std::vector<std::string>& keys)
+{
+	switch (type)
+	{
+	case GENRE_FILTER:
+		for (auto val : Genres::getGenreFiltersNames(&game->getMetadata()))
+			keys.push_back(val);
+		return;
+
+	case PLAYER_FILTER:
+	{
+		// Player filter values are 1 to 9 ( see managePlayerEntryInIndex )
+		auto range = game->parsePlayersRange();
+		if (range.first <= 0 && range.second > 0)
+		{
+			if (range.second <= 9)
+				keys.push_back(std::to_string(range.second));
+		}
+		else if (range.second > 0)
+		{
+			for (int i = std::max(range.first, 1); i <= std::min(range.second, 9); i++)
+				keys.push_back(std::to_string(i));
+		}
+		return;
+	}
+
+	case LANG_FILTER:
+	case REGION_FILTER:
+		for (auto val : Utils::String::split(getIndexableKey(game, type, false), ','))
+			keys.push_back(val);
+		return;
+
+	default:
+		break;
+	}
+
+	keys.push_back(getIndexableKey(game, type, false));
+
+	auto decl = mFilterDecl.find(type);
+	if (decl != mFilterDecl.cend() && decl->second.hasSecondaryKey)
+	{
+		std::string secKey = getIndexableKey(game, type, true);
+		if (secKey != UNKNOWN_LABEL)
+			keys.push_back(secKey);
+	}
+}
+
+// ANDs the posting lists of every active indexed filter, so showFile tests one bit instead of reading metadata
+void FileFilterIndex::updateFacetMatches()
+{
+	mFacetMatchesDirty = false;
+	mFacetMatchTypes.clear();
+	mFacetMatches.clear();
+
+	OrdinalBitset values;
+
+	for (auto& facet : mFacets)
+	{
+		auto decl = mFilterDecl.find(facet.first);
+		if (decl == mFilterDecl.cend() || !(*(decl->second.filteredByRef)))
+			continue;
+
+		auto keys = decl->second.currentFilteredKeys;
+
+		if (facet.first == PLAYER_FILTER)
+		{
+			bool indexedKeys = true;
+
+			for (auto key : *keys)
+			{
+				int val = Utils::String::toInteger(key);
+				if (val < 1 || val > 9 || std::to_string(val) != key)
+					indexedKeys = false;
+			}
+
+			if (!indexedKeys)
+				continue;
+		}
+
+		if (mFacetMatchTypes.empty())
+			mFacetMatches.assign(mOrdinalCount, true);
+
+		values.assign(mOrdinalCount, false);
+		facet.second.collect(*keys, values);
+		mFacetMatches.andWith(values);
+
+		mFacetMatchTypes.insert(facet.first);
+	}
+}
+
+// Scrapers & editors write metadata without reindexing : rebuilds the postings of a game and its bit in mFacetMatches from the current values
+void FileFilterIndex::refreshFacets(FileData* game, uint32_t ordinal)
+{
+	mOrdinalVersions[ordinal] = game->getMetadata().getVersion();
+
+	bool matches = true;
+
+	std::vector<std::string> keys;
+	for (auto& facet : mFacets)
+	{
+		keys.clear();
+		getFacetKeys(game, (FilterIndexType)facet.first, keys);
+		facet.second.add(ordinal, keys);
+
+		if (!matches || mFacetMatchTypes.find(facet.first) == mFacetMatchTypes.cend())
+			continue;
+
+		auto filteredKeys = mFilterDecl[facet.first].currentFilteredKeys;
+		matches = std::any_of(keys.cbegin(), keys.cend(), [filteredKeys](const std::string& key) { return filteredKeys->find(key) != filteredKeys->cend(); });
+	}
+
+	if (matches)
+		mFacetMatches.set(ordinal);
+	else
+		mFacetMatches.reset(ordinal);
 }
 
 void FileFilterIndex::setFilter(FilterIndexType type, std::vector<std::string>* values)
@@ -475,6 +667,7 @@ void FileFilterIndex::setFilter(FilterIndexType type, std::vector<std::string>*
 	FilterDataDecl& filterData = it->second;
 	*(filterData.filteredByRef) = values != nullptr && values->size() > 0;
 	filterData.currentFilteredKeys->clear();
+	mFacetMatchesDirty = true;
 
 	if (values == nullptr)
 		return;
@@ -502,6 +695,8 @@ void FileFilterIndex::clearAllFilters()
 {
 	mUseRelevency = false;
 	mTextFilter = "";
+	mTextIndex.clearQuery();
+	mFacetMatchesDirty = true;
 
 	for (auto& it : mFilterDecl)
 	{
@@ -531,57 +726,142 @@ void FileFilterIndex::setUIModeFilters()
 	}	
 }
 
+static std::vector<std::string> simplifySearchText(const std::string& text)
+{
+	auto s = Utils::String::toLower(text);
+	s = Utils::String::replace(s, ":", "");
+	s = Utils::String::replace(s, ".", "");
+	s = Utils::String::replace(s, " - ", " ");
+	s = Utils::String::replace(s, "- ", " ");
+
+	std::vector<std::string> ret;
+
+	for (auto v : Utils::String::split(s, ' '))
+	{
+		if (v.empty() || v.length() <= 2 || v == "and" || v == "not" || v == "for" || v == "the" || v == "les" || v == "des")
+			continue;
+
+		ret.push_back(v);
+	}
+
+	return ret;
+}
+
+static bool isAsciiText(const std::string& text)
+{
+	for (auto c : text)
+		if ((c & 0x80) != 0)
+			return false;
+
+	return true;
+}
+
 void FileFilterIndex::setTextFilter(const std::string text, bool useRelevancy) 
 { 
 	mTextFilter = text;
 	mUseRelevency = useRelevancy;
+
+	updateTextSearchQuery();
 }
 
-float jw_distance(std::string s1, std::string s2, bool caseSensitive = true) {
-	float m = 0;
-	int low, high, range;
-	int k = 0, numTrans = 0;
+// Gives the text index the terms a name must contain to possibly match the filter in showFile
+void FileFilterIndex::updateTextSearchQuery()
+{
+	if (mTextFilter.empty())
+	{
+		mTextIndex.clearQuery();
+		return;
+	}
+
+	std::string language = SystemConf::getInstance()->get("system.language");
+	if (language == "zh_CN" || language == "zh_TW") // Pinyin matches are not indexed
+	{
+		mTextIndex.clearQuery();
+		return;
+	}
+
+	// Names are compared after unicode lowercase, the index only folds ascii
+	if (!isAsciiText(mTextFilter))
+	{
+		mTextIndex.clearQuery();
+		return;
+	}
 
+	std::vector<std::string> terms;
+
+	if (!mUseRelevency)
+	{
+		if (mTextFilter.find(',') == std::string::npos)
+			terms.push_back(mTextFilter);
+		else
+		{
+			for (auto token : Utils::String::split(mTextFilter, ',', true))
+				terms.push_back(Utils::String::trim(token));
+		}
+	}
+	else
+	{
+		terms.push_back(mTextFilter);
+
+		if (mTextFilter.find(' ') != std::string::npos)
+		{
+			for (auto word : simplifySearchText(mTextFilter))
+				terms.push_back(word);
+		}
+	}
+
+	mTextIndex.setQuery(terms);
+}
+
+static float jw_distance(const std::string& str1, const std::string& str2, bool caseSensitive = true)
+{
 	// Exit early if either are empty
-	if (s1.length() == 0 || s2.length() == 0) {
+	if (str1.length() == 0 || str2.length() == 0)
 		return 0;
-	}
+
+	std::string s1 = str1;
+	std::string s2 = str2;
 
 	// Convert to lower if case-sensitive is false
-	if (caseSensitive == false) {
-		transform(s1.begin(), s1.end(), s1.begin(), ::tolower);
-		transform(s2.begin(), s2.end(), s2.begin(), ::tolower);
+	if (caseSensitive == false)
+	{
+		std::transform(s1.begin(), s1.end(), s1.begin(), ::tolower);
+		std::transform(s2.begin(), s2.end(), s2.begin(), ::tolower);
 	}
 
 	// Exit early if they're an exact match.
-	if (s1 == s2) {
+	if (s1 == s2)
 		return 1;
-	}
 
-	range = (std::max(s1.length(), s2.length()) / 2) - 1;
-	int s1Matches[65000] = {};
-	int s2Matches[65000] = {};
+	int len1 = (int)s1.length();
+	int len2 = (int)s2.length();
+	int range = std::max(0, (std::max(len1, len2) / 2) - 1);
 
-	for (int i = 0; i < s1.length(); i++) {
+	// Match flags are sized on the strings, names fit in the stack buffer
+	char stackMatches[512];
+	std::vector<char> heapMatches;
 
-		// Low Value;
-		if (i >= range) {
-			low = i - range;
-		}
-		else {
-			low = 0;
-		}
+	char* s1Matches = stackMatches;
+	if (len1 + len2 > (int)sizeof(stackMatches))
+	{
+		heapMatches.resize(len1 + len2);
+		s1Matches = heapMatches.data();
+	}
 
-		// High Value;
-		if (i + range <= (s2.length() - 1)) {
-			high = i + range;
-		}
-		else {
-			high = s2.length() - 1;
-		}
+	char* s2Matches = s1Matches + len1;
+	memset(s1Matches, 0, len1 + len2);
 
-		for (int j = low; j <= high; j++) {
-			if (s1Matches[i] != 1 && s2Matches[j] != 1 && s1[i] == s2[j]) {
+	float m = 0;
+
+	for (int i = 0; i < len1; i++)
+	{
+		int low = std::max(0, i - range);
+		int high = std::min(len2 - 1, i + range);
+
+		for (int j = low; j <= high; j++)
+		{
+			if (!s2Matches[j] && s1[i] == s2[j])
+			{
 				m += 1;
 				s1Matches[i] = 1;
 				s2Matches[j] = 1;
@@ -591,37 +871,41 @@ float jw_distance(std::string s1, std::string s2, bool caseSensitive = true) {
 	}
 
 	// Exit early if no matches were found
-	if (m == 0) {
+	if (m == 0)
 		return 0;
-	}
 
 	// Count the transpositions.
-	for (int i = 0; i < s1.length(); i++) {
-		if (s1Matches[i] == 1) {
-			int j;
-			for (j = k; j < s2.length(); j++) {
-				if (s2Matches[j] == 1) {
-					k = j + 1;
-					break;
-				}
-			}
+	int k = 0, numTrans = 0;
+
+	for (int i = 0; i < len1; i++)
+	{
+		if (!s1Matches[i])
+			continue;
 
-			if (s1[i] != s2[j]) {
-				numTrans += 1;
+		int j;
+		for (j = k; j < len2; j++)
+		{
+			if (s2Matches[j])
+			{
+				k = j + 1;
+				break;
 			}
 		}
+
+		if (j < len2 && s1[i] != s2[j])
+			numTrans += 1;
 	}
 
-	float weight = (m / s1.length() + m / s2.length() + (m - (numTrans / 2)) / m) / 3;
-	float l = 0;
-	float p = 0.1;
-	if (weight > 0.7) {
-		while (s1[l] == s2[l] && l < 4) {
-			l += 1;
-		}
+	float weight = (m / len1 + m / len2 + (m - (numTrans / 2)) / m) / 3;
+	if (weight > 0.7)
+	{
+		int l = 0;
+		while (l < 4 && l < len1 && l < len2 && s1[l] == s2[l])
+			l++;
 
-		weight += l * p * (1 - weight);
+		weight += l * 0.1f * (1 - weight);
 	}
+
 	return weight;
 }
 
@@ -649,9 +933,14 @@ int FileFilterIndex::showFile(FileData* game)
 	
 	int textScore = 0;
 
+	int ordinal = getGameOrdinal(game);
+
 	if (!mTextFilter.empty())
 	{
-		auto name = game->getSourceFileData()->getName();
+		const std::string& name = game->getSourceFileData()->getName();
+		if (ordinal >= 0 && mTextIndex.isExcluded(ordinal, name))
+			return 0;
+
 		std::string language = SystemConf::getInstance()->get("system.language");
 		bool isChinese = (language == "zh_CN" || language == "zh_TW");
 
@@ -706,29 +995,8 @@ int FileFilterIndex::showFile(FileData* game)
 			}
 			else if (mTextFilter.find(' ') != std::string::npos)
 			{
-				auto simplify = [](const std::string& text)
-				{
-					auto s = Utils::String::toLower(text);
-					s = Utils::String::replace(s, ":", "");
-					s = Utils::String::replace(s, ".", "");
-					s = Utils::String::replace(s, " - ", " ");
-					s = Utils::String::replace(s, "- ", " ");				
-
-					std::vector<std::string> ret;
-
-					for (auto v : Utils::String::split(s, ' '))
-					{
-						if (v.empty() || v.length() <= 2 || v == "and" || v == "not" || v == "for" || v == "the" || v == "les" || v == "des")
-							continue;
-
-						ret.push_back(v);
-					}
-
-					return ret;
-				};
-
-				auto filters = simplify(mTextFilter);
-				auto words = simplify(name);
+				auto filters = simplifySearchText(mTextFilter);
+				auto words = simplifySearchText(name);
 
 				int totalWords = 0;
 				int commonWords = 0;
@@ -813,6 +1081,24 @@ int FileFilterIndex::showFile(FileData* game)
 	}
 
 	bool hasFilter = false;
+	bool facetsMatched = false;
+
+	if (ordinal >= 0)
+	{
+		if (mFacetMatchesDirty)
+			updateFacetMatches();
+
+		if (!mFacetMatchTypes.empty())
+		{
+			if (mOrdinalVersions[ordinal] != game->getMetadata().getVersion())
+				refreshFacets(game, ordinal);
+
+			if (!mFacetMatches.test(ordinal))
+				return 0;
+
+			facetsMatched = true;
+		}
+	}
 
 	for (auto& it : mFilterDecl)
 	{
@@ -822,6 +1108,12 @@ int FileFilterIndex::showFile(FileData* game)
 		
 		hasFilter = true;
 
+		if (facetsMatched && mFacetMatchTypes.find(filterData.type) != mFacetMatchTypes.cend())
+		{
+			keepGoing = true;
+			continue;
+		}
+
 		bool filterValid = false;
 
 		if (filterData.type == HASMEDIA_FILTER)
@@ -1116,6 +1408,8 @@ bool CollectionFilter::createFromSystem(const std::string name, SystemData* syst
 		*(filterData.filteredByRef) = (filterData.currentFilteredKeys->size() > 0);
 	}
 
+	mFacetMatchesDirty = true;
+
 	mName = name;
 	mPath = getCollectionsFolder() + "/" + mName + ".xcc";
 	
@@ -1212,6 +1506,8 @@ bool CollectionFilter::load(const std::string file)
 		*(filterData.filteredByRef) = (filterData.currentFilteredKeys->size() > 0);
 	}
 
+	mFacetMatchesDirty = true;
+
 	return true;
 }
 
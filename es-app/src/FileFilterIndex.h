@@ -5,8 +5,13 @@
 #include <map>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
+#include <set>
 #include <string>
 
+#include "TextSearchIndex.h"
+#include "FacetIndex.h"
+
 class FileData;
 class SystemData;
 
@@ -104,6 +109,13 @@ protected:
 
 	void clearIndex(std::map<std::string, int> indexMap);
 
+	void updateTextSearchQuery();
+
+	int  getGameOrdinal(FileData* game);
+	void getFacetKeys(FileData* game, FilterIndexType type, std::vector<std::string>& keys);
+	void updateFacetMatches();
+	void refreshFacets(FileData* game, uint32_t ordinal);
+
 	bool filterByGenre;
 	bool filterByFamily;
 	bool filterByPlayers;
@@ -166,6 +178,20 @@ protected:
 
 	std::string mTextFilter;
 	bool		mUseRelevency;
+
+	TextSearchIndex mTextIndex;
+
+	// Games of the index get a dense ordinal, reused after removal
+	std::unordered_map<FileData*, uint32_t> mGameOrdinals;
+	std::vector<uint32_t>	mFreeOrdinals;
+	uint32_t				mOrdinalCount;
+	std::vector<unsigned int> mOrdinalVersions;	// ordinal -> metadata version the facets were built from
+
+	// Filters whose values are maintained by addToIndex/removeFromIndex are evaluated on posting lists
+	std::map<int, FacetIndex>	mFacets;
+	std::set<int>			mFacetMatchTypes;	// active filters resolved by mFacetMatches
+	OrdinalBitset			mFacetMatches;
+	bool					mFacetMatchesDirty;
 };
 
 class CollectionFilter : public FileFilterIndex
@@ -2,7 +2,12 @@
 #include "FileSorts.h"
 
 #include "utils/StringUtil.h"
+#include "utils/FileSystemUtil.h"
 #include "LocaleES.h"
+#include <algorithm>
+#include <climits>
+#include <mutex>
+#include <unordered_map>
 
 namespace FileSorts
 {
@@ -223,4 +228,222 @@ namespace FileSorts
 		std::string system2 = ((FileData*)file2)->getSourceFileData()->getSystemName();
 		return Utils::String::compareIgnoreCase(system1, system2) < 0;		
 	}
+
+	// Fields are compared in declaration order. Unused ones stay empty.
+	struct SortKey
+	{
+		SortKey() : group(0), value1(0), value2(0) { }
+
+		int				group;
+		double			value1;
+		std::u32string	text1;
+		double			value2;
+		std::u32string	text2;
+	};
+
+	// Upper case code points : comparing them gives the same order as Utils::String::compareIgnoreCase
+	static std::u32string foldCase(const std::string& text)
+	{
+		std::string upper = Utils::String::toUpper(text);
+
+		std::u32string ret;
+		ret.reserve(upper.size());
+
+		size_t cursor = 0;
+		while (cursor < upper.size())
+			ret += (char32_t)Utils::String::chars2Unicode(upper, cursor);
+
+		return ret;
+	}
+
+	static std::u32string getNameKey(FileData* file, bool ignoreArticles)
+	{
+		if (ignoreArticles)
+		{
+			static auto articles = Utils::String::commaStringToVector(_("A,AN,THE"));
+			return foldCase(stripLeadingArticle(file->getName(), articles));
+		}
+
+		return foldCase(file->getName());
+	}
+
+	// File creation dates don't change, keep them for the next sorts
+	static std::mutex creationDatesLock;
+	static std::unordered_map<std::string, time_t> creationDates;
+
+	void clearFileCache()
+	{
+		std::unique_lock<std::mutex> lock(creationDatesLock);
+		creationDates.clear();
+	}
+
+	static time_t getFileCreationTime(FileData* file)
+	{
+		const std::string& path = file->getPath();
+
+		{
+			std::unique_lock<std::mutex> lock(creationDatesLock);
+			auto it = creationDates.find(path);
+			if (it != creationDates.cend())
+				return it->second;
+		}
+
+		time_t time = Utils::FileSystem::getFileCreationDate(path).getTime();
+
+		std::unique_lock<std::mutex> lock(creationDatesLock);
+		creationDates[path] = time;
+		return time;
+	}
+
+	static void extractSortKey(FileData* file, int sortId, bool ignoreArticles, SortKey& key)
+	{
+		const MetaDataList& md = file->getMetadata();
+
+		switch (sortId)
+		{
+		case RATING_ASCENDING:
+		case RATING_DESCENDING:
+			key.value1 = md.getFloat(MetaDataId::Rating);
+			break;
+
+		case TIMESPLAYED_ASCENDING:
+		case TIMESPLAYED_DESCENDING:
+			// only games have playcount metadata
+			key.value1 = md.getType() == GAME_METADATA ? md.getInt(MetaDataId::PlayCount) : -1;
+			break;
+
+		case GAMETIME_ASCENDING:
+		case GAMETIME_DESCENDING:
+			key.value1 = md.getType() == GAME_METADATA ? md.getInt(MetaDataId::GameTime) : -1;
+			break;
+
+		case LASTPLAYED_ASCENDING:
+		case LASTPLAYED_DESCENDING:
+			key.value1 = (double)md.getDateKey(MetaDataId::LastPlayed);
+			break;
+
+		case NUMBERPLAYERS_ASCENDING:
+		case NUMBERPLAYERS_DESCENDING:
+			key.value1 = md.getInt(MetaDataId::Players);
+			break;
+
+		case RELEASEDATE_ASCENDING:
+		case RELEASEDATE_DESCENDING:
+			key.value1 = (double)md.getDateKey(MetaDataId::ReleaseDate);
+			break;
+
+		case GENRE_ASCENDING:
+		case GENRE_DESCENDING:
+			key.text1 = foldCase(md.get(MetaDataId::Genre));
+			break;
+
+		case DEVELOPER_ASCENDING:
+		case DEVELOPER_DESCENDING:
+			key.text1 = foldCase(md.get(MetaDataId::Developer));
+			break;
+
+		case PUBLISHER_ASCENDING:
+		case PUBLISHER_DESCENDING:
+			key.text1 = foldCase(md.get(MetaDataId::Publisher));
+			break;
+
+		case SYSTEM_ASCENDING:
+		case SYSTEM_DESCENDING:
+			key.text1 = foldCase(file->getSourceFileData()->getSystemName());
+			break;
+
+		case FILECREATION_DATE_ASCENDING:
+		case FILECREATION_DATE_DESCENDING:
+			key.value1 = (double)getFileCreationTime(file);
+			break;
+
+		case SYSTEM_RELEASEDATE_ASCENDING:
+		case SYSTEM_RELEASEDATE_DESCENDING:
+			// yyyymmddhhmmss -> yyyy
+			key.text1 = foldCase(file->getSourceFileData()->getSystemName());
+			key.value2 = (double)(md.getDateKey(MetaDataId::ReleaseDate) / 10000000000LL);
+			key.text2 = foldCase(file->getName());
+			break;
+
+		case RELEASEDATE_SYSTEM_ASCENDING:
+		case RELEASEDATE_SYSTEM_DESCENDING:
+			key.value1 = (double)(md.getDateKey(MetaDataId::ReleaseDate) / 10000000000LL);
+			key.text1 = foldCase(file->getSourceFileData()->getSystemName());
+			key.text2 = foldCase(file->getName());
+			break;
+
+		default:
+			key.text1 = getNameKey(file, ignoreArticles);
+			break;
+		}
+	}
+
+	static inline int compareKeys(const SortKey& a, const SortKey& b)
+	{
+		if (a.value1 != b.value1)
+			return a.value1 < b.value1 ? -1 : 1;
+
+		int cmp = a.text1.compare(b.text1);
+		if (cmp != 0)
+			return cmp;
+
+		if (a.value2 != b.value2)
+			return a.value2 < b.value2 ? -1 : 1;
+
+		return a.text2.compare(b.text2);
+	}
+
+	void sortFiles(std::vector<FileData*>& files, int sortId, bool ascending, bool foldersFirst, bool favoritesFirst, const std::map<FileData*, int>* scores)
+	{
+		if (files.size() < 2)
+			return;
+
+		bool ignoreArticles = Settings::IgnoreLeadingArticles();
+
+		std::vector<SortKey> keys(files.size());
+
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			FileData* file = files[i];
+			SortKey& key = keys[i];
+
+			if (scores != nullptr)
+			{
+				// Unscored files ( unique games substituted to their folder ) come after every match
+				auto score = scores->find(file);
+				key.group = score != scores->cend() ? score->second : INT_MAX;
+			}
+			else
+			{
+				if (favoritesFirst && !file->getFavorite())
+					key.group += 2;
+
+				if (foldersFirst && file->getType() != FOLDER)
+					key.group += 1;
+			}
+
+			extractSortKey(file, sortId, ignoreArticles, key);
+		}
+
+		std::vector<uint32_t> order(files.size());
+		for (size_t i = 0; i < order.size(); i++)
+			order[i] = (uint32_t)i;
+
+		std::stable_sort(order.begin(), order.end(), [&keys, ascending](uint32_t a, uint32_t b)
+		{
+			const SortKey& ka = keys[a];
+			const SortKey& kb = keys[b];
+
+			if (ka.group != kb.group)
+				return ka.group < kb.group;
+
+			return ascending ? compareKeys(ka, kb) < 0 : compareKeys(kb, ka) < 0;
+		});
+
+		std::vector<FileData*> sorted(files.size());
+		for (size_t i = 0; i < order.size(); i++)
+			sorted[i] = files[order[i]];
+
+		files.swap(sorted);
+	}
 };
@@ -4,6 +4,7 @@
 
 #include "FileData.h"
 #include <vector>
+#include <map>
 
 namespace FileSorts
 {
@@ -83,5 +84,12 @@ namespace FileSorts
 	bool compareReleaseYearSystem(const FileData* file1, const FileData* file2);
 
 	std::string stripLeadingArticle(const std::string &string, const std::vector<std::string> &articles);
+
+	// Decorate-sort-undecorate : keys are extracted once per file, comparisons don't copy strings, read metadata or stat files.
+	// Favorites then folders come first when asked. Files with a score ( text filter relevancy ) are ordered by score first.
+	void sortFiles(std::vector<FileData*>& files, int sortId, bool ascending, bool foldersFirst, bool favoritesFirst, const std::map<FileData*, int>* scores = nullptr);
+
+	// Forgets the file creation dates kept by sortFiles, for files that were replaced on disk
+	void clearFileCache();
 };
 #endif // ES_APP_FILE_SORTS_H
@@ -1,4 +1,5 @@
 #include "Gamelist.h"
+#include "GamelistJournal.h"
 
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
@@ -10,6 +11,8 @@
 #include <pugixml/src/pugixml.hpp>
 #include "Genres.h"
 #include "Paths.h"
+#include "utils/BinaryStream.h"
+#include "utils/MemoryMappedFile.h"
 #include <fstream> 
 
 #ifdef WIN32
@@ -24,6 +27,11 @@ std::string getGamelistRecoveryPath(SystemData* system)
 	return Utils::FileSystem::getGenericPath(Paths::getUserEmulationStationPath() + "/recovery/" + system->getName());
 }
 
+static std::string getGamelistJournalPath(SystemData* system)
+{
+	return getGamelistRecoveryPath(system) + "/journal.bin";
+}
+
 static bool isPathActuallyVirtual(const std::string& path) {
     return Utils::String::startsWith(path, "epic:/") ||    // Assicurati che i tuoi prefissi reali siano "epic://" vs "epic:/"
            Utils::String::startsWith(path, "steam:/") ||   // Assicurati che i tuoi prefissi reali siano "steam://" vs "steam:/"
@@ -298,10 +306,196 @@ FileData* findOrCreateFile(SystemData* system, const std::string& path, FileType
 }
 
 
-std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, size_t checkSize, bool fromFile)
+// Without createFiles, only the entries already in fileMap receive their metadata
+static FileData* findGamelistFile(SystemData* system, const std::string& path, FileType type, std::unordered_map<std::string, FileData*>& fileMap, bool createFiles)
+{
+	if (createFiles)
+		return findOrCreateFile(system, path, type, fileMap);
+
+	auto it = fileMap.find(path);
+	if (it == fileMap.cend() || it->second->getType() != type)
+		return nullptr;
+
+	return it->second;
+}
+
+static std::string resolveGamelistPath(const std::string& nodePath, const std::string& relativeTo)
+{
+	std::string path = Utils::FileSystem::resolveRelativePath(nodePath, relativeTo, false);
+	if (path.empty() && !nodePath.empty()) // Se resolveRelativePath ha fallito per un path non relativo (come un AUMID)
+	{
+		path = nodePath; // Usa il path grezzo dall'XML
+		LOG(LogDebug) << "loadGamelistFile: Used raw path from XML for unresolvable path: " << path;
+	}
+
+	return path;
+}
+
+// Common processing once the metadata of a gamelist entry has been loaded ( from xml or from the snapshot )
+static void finalizeGamelistEntry(FileData* file, const std::string& path, bool trustGamelist, bool fromRecovery)
+{
+	MetaDataList& mdl = file->getMetadata();
+
+	if (mdl.getName().empty())
+		mdl.set(MetaDataId::Name, file->getDisplayName());
+
+	// Questo blocco per 'hidden' dovrebbe applicarsi solo a percorsi fisici reali.
+	// La funzione helper isPathActuallyVirtual è usata qui.
+	if (!trustGamelist && !isPathActuallyVirtual(path) && Utils::FileSystem::exists(path) && !file->getHidden() && Utils::FileSystem::isHidden(path))
+		mdl.set(MetaDataId::Hidden, "true");
+
+	Genres::convertGenreToGenreIds(&mdl);
+
+	if (fromRecovery) // Caricamento da file di recovery
+		mdl.setDirty();
+	else // Caricamento dal gamelist principale
+		mdl.resetChangedFlag();
+}
+
+// Binary snapshot of gamelist.xml : tags are already resolved to MetaDataIds, so startup skips xml parsing.
+// The snapshot is only used while the gamelist keeps the same path, size & modification time.
+#define GAMELIST_SNAPSHOT_MAGIC		0x53475345 // "ESGS"
+#define GAMELIST_SNAPSHOT_VERSION	1
+
+static std::string getGamelistSnapshotPath(SystemData* system)
+{
+	return Utils::FileSystem::getGenericPath(Paths::getUserEmulationStationPath() + "/cache/gamelists/" + system->getName() + ".bin");
+}
+
+static void saveGamelistSnapshot(const std::string& xmlpath, SystemData* system, pugi::xml_node& rootNode)
+{
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(GAMELIST_SNAPSHOT_MAGIC);
+	writer.write<uint32_t>(GAMELIST_SNAPSHOT_VERSION);
+	writer.write<uint32_t>((uint32_t)MetaDataList::getMDD().size());
+	writer.writeString(xmlpath);
+	writer.write<uint64_t>((uint64_t)Utils::FileSystem::getFileSize(xmlpath));
+	writer.write<int64_t>((int64_t)Utils::FileSystem::getFileModificationDate(xmlpath).getTime());
+
+	size_t countOffset = writer.size();
+	writer.write<uint32_t>(0);
+
+	uint32_t count = 0;
+
+	for (pugi::xml_node fileNode : rootNode.children())
+	{
+		std::string tag = fileNode.name();
+		if (tag != "game" && tag != "folder")
+			continue;
+
+		pugi::xml_node pathNode = fileNode.child("path");
+		if (!pathNode)
+			continue;
+
+		writer.write<uint8_t>(tag == "folder" ? FOLDER : GAME);
+		writer.writeString(pathNode.text().get());
+
+		size_t sizeOffset = writer.size();
+		writer.write<uint32_t>(0);
+
+		MetaDataList::writeSnapshot(fileNode, writer);
+		writer.writeAt<uint32_t>(sizeOffset, (uint32_t)(writer.size() - sizeOffset - sizeof(uint32_t)));
+
+		count++;
+	}
+
+	writer.writeAt<uint32_t>(countOffset, count);
+
+	if (!writer.saveToFile(getGamelistSnapshotPath(system)))
+		LOG(LogWarning) << "Unable to write gamelist snapshot for system " << system->getName();
+}
+
+static bool loadGamelistSnapshot(const std::string& xmlpath, SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, std::vector<FileData*>& ret, bool createFiles)
+{
+	std::string snapshotPath = getGamelistSnapshotPath(system);
+
+	Utils::MemoryMappedFile snapshot;
+	if (!snapshot.open(snapshotPath))
+		return false;
+
+	Utils::BinaryReader reader(snapshot.data(), snapshot.size());
+
+	uint32_t magic, version, mddCount, count;
+	uint64_t xmlSize;
+	int64_t xmlTime;
+	std::string snapshotXmlPath;
+
+	if (!reader.read(magic) || magic != GAMELIST_SNAPSHOT_MAGIC ||
+		!reader.read(version) || version != GAMELIST_SNAPSHOT_VERSION ||
+		!reader.read(mddCount) || mddCount != (uint32_t)MetaDataList::getMDD().size() ||
+		!reader.readString(snapshotXmlPath) || snapshotXmlPath != xmlpath ||
+		!reader.read(xmlSize) || xmlSize != (uint64_t)Utils::FileSystem::getFileSize(xmlpath) ||
+		!reader.read(xmlTime) || xmlTime != (int64_t)Utils::FileSystem::getFileModificationDate(xmlpath).getTime() ||
+		!reader.read(count))
+	{
+		LOG(LogDebug) << "Gamelist snapshot for system " << system->getName() << " is outdated";
+		return false;
+	}
+
+	LOG(LogInfo) << "Loading gamelist snapshot \"" << snapshotPath << "\"...";
+
+	std::string relativeTo = system->getStartPath();
+	bool trustGamelist = Settings::ParseGamelistOnly();
+
+	std::string nodePath;
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		uint8_t type;
+		uint32_t size;
+
+		if (!reader.read(type) || !reader.readString(nodePath) || !reader.read(size))
+			break;
+
+		Utils::BinaryReader entry = reader.subReader(size);
+		if (!entry.isValid())
+			break;
+
+		std::string path = resolveGamelistPath(nodePath, relativeTo);
+		if (path.empty())
+			continue;
+
+		FileData* file = findGamelistFile(system, path, (FileType)type, fileMap, createFiles);
+		if (file == nullptr)
+			continue;
+
+		if (file->isArcadeAsset() && trustGamelist)
+			continue;
+
+		if (!file->getMetadata().loadFromSnapshot(type == FOLDER ? FOLDER_METADATA : GAME_METADATA, entry, system))
+		{
+			// The entries already loaded are fine ; the remaining ones will be reloaded from the xml file
+			LOG(LogWarning) << "Corrupted gamelist snapshot for system " << system->getName();
+			Utils::FileSystem::removeFile(snapshotPath);
+			return false;
+		}
+
+		finalizeGamelistEntry(file, path, trustGamelist, false);
+		ret.push_back(file);
+	}
+
+	if (!reader.isValid())
+	{
+		LOG(LogWarning) << "Truncated gamelist snapshot for system " << system->getName();
+		Utils::FileSystem::removeFile(snapshotPath);
+		return false;
+	}
+
+	LOG(LogInfo) << "Finished loading gamelist snapshot \"" << snapshotPath << "\". Loaded " << ret.size() << " valid entries.";
+	return true;
+}
+
+std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, size_t checkSize, bool fromFile, bool createFiles)
 {
     std::vector<FileData*> ret;
 
+    // Main gamelist : use the binary snapshot when it's still in sync with the xml file
+    bool useSnapshot = fromFile && checkSize == SIZE_MAX;
+    if (useSnapshot && loadGamelistSnapshot(xmlpath, system, fileMap, ret, createFiles))
+        return ret;
+
+    ret.clear();
+
     LOG(LogInfo) << "Parsing XML file \"" << xmlpath << "\"...";
 
     pugi::xml_document doc;
@@ -348,17 +542,7 @@ std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* s
             LOG(LogWarning) << "Gamelist entry in \"" << xmlpath << "\" is missing <path> tag. Skipping node.";
             continue;
         }
-        // NOTA: resolveRelativePath potrebbe non essere necessario o desiderabile per path assoluti/URI come gli AUMID o i virtuali.
-        // Se 'pathNode.text().get()' è già il path corretto (es. AUMID o URI virtuale), usalo direttamente.
-        // Se invece può contenere path relativi per ROM normali, allora resolveRelativePath è corretto.
-        // Per semplicità, manteniamo resolveRelativePath, ma assicurati che non alteri gli AUMID/URI.
-        // Se li altera, usa direttamente pathNode.text().get() per i casi speciali.
-        std::string path = Utils::FileSystem::resolveRelativePath(pathNode.text().get(), relativeTo, false);
-        if (path.empty() && !pathNode.text().empty()) { // Se resolveRelativePath ha fallito per un path non relativo (come un AUMID)
-             path = pathNode.text().get(); // Usa il path grezzo dall'XML
-             LOG(LogDebug) << "loadGamelistFile: Used raw path from XML for unresolvable path: " << path;
-        }
-
+        std::string path = resolveGamelistPath(pathNode.text().get(), relativeTo);
 
         if (path.empty()) {
             LOG(LogWarning) << "Gamelist entry in \"" << xmlpath << "\" has empty or unresolvable <path>. Original XML path: " << pathNode.text().get() << ". Skipping node.";
@@ -371,7 +555,7 @@ std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* s
 
         // La decisione di come creare/trovare il FileData è ora delegata a findOrCreateFile,
         // che è stato modificato per gestire AUMID e virtuali correttamente.
-        file = findOrCreateFile(system, path, type, fileMap);
+        file = findGamelistFile(system, path, type, fileMap, createFiles);
 
         if (file == nullptr)
         {
@@ -389,23 +573,7 @@ std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* s
             mdl.loadFromXML(type == FOLDER ? FOLDER_METADATA : GAME_METADATA, fileNode, system);
             mdl.migrate(file, fileNode);
 
-            if (mdl.getName().empty()) {
-                mdl.set(MetaDataId::Name, file->getDisplayName());
-            }
-
-            // Questo blocco per 'hidden' dovrebbe applicarsi solo a percorsi fisici reali.
-            // La funzione helper isPathActuallyVirtual è usata qui.
-            if (!trustGamelist && !isPathActuallyVirtual(path) && Utils::FileSystem::exists(path) && !file->getHidden() && Utils::FileSystem::isHidden(path)) {
-                mdl.set(MetaDataId::Hidden, "true");
-            }
-
-            Genres::convertGenreToGenreIds(&mdl);
-
-            if (checkSize != SIZE_MAX) { // Caricamento da file di recovery
-                mdl.setDirty();
-            } else { // Caricamento dal gamelist principale
-                mdl.resetChangedFlag();
-            }
+            finalizeGamelistEntry(file, path, trustGamelist, checkSize != SIZE_MAX);
             ret.push_back(file);
         } else if (trustGamelist && file->isArcadeAsset()) {
             LOG(LogDebug) << "loadGamelistFile: Skipping explicit metadata load for arcade asset (trustGamelist=true): " << path;
@@ -415,31 +583,109 @@ std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* s
     }
 
     LOG(LogInfo) << "Finished parsing XML file \"" << xmlpath << "\". Loaded " << ret.size() << " valid entries.";
+
+    if (useSnapshot)
+        saveGamelistSnapshot(xmlpath, system, rootNode);
+
     return ret;
 }
 
 void clearTemporaryGamelistRecovery(SystemData* system)
 {	
+	// Records still in memory must not be written after the directory is cleaned
+	GamelistJournal::getInstance()->discard(getGamelistJournalPath(system));
+
 	auto path = getGamelistRecoveryPath(system);
 	Utils::FileSystem::deleteDirectoryFiles(path, true);
 }
 
-void parseGamelist(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap)
+// Replays the journal : the last record of each file wins, records written against another gamelist.xml are dropped.
+// The journal is compacted when some records were superseded.
+static void loadGamelistJournal(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, size_t checkSize, bool createFiles)
+{
+	std::string journalPath = getGamelistJournalPath(system);
+
+	bool damaged = false;
+
+	auto records = GamelistJournal::getInstance()->read(journalPath, &damaged);
+	if (records.size() == 0)
+	{
+		if (damaged && createFiles)
+			GamelistJournal::getInstance()->rewrite(journalPath, records);
+
+		return;
+	}
+
+	std::unordered_map<std::string, size_t> lastRecords;
+	for (size_t i = 0; i < records.size(); i++)
+		lastRecords[records[i].path] = i;
+
+	bool trustGamelist = Settings::ParseGamelistOnly();
+
+	std::vector<GamelistJournal::Record> liveRecords;
+
+	for (size_t i = 0; i < records.size(); i++)
+	{
+		auto& record = records[i];
+		if (lastRecords[record.path] != i || record.type != GamelistJournal::SAVE || record.gamelistSize != (uint64_t)checkSize)
+			continue;
+
+		FileData* file = findGamelistFile(system, record.path, (FileType)record.fileType, fileMap, createFiles);
+		if (file == nullptr)
+			continue;
+
+		Utils::BinaryReader reader(record.metadata.data(), record.metadata.size());
+		if (!file->getMetadata().loadFromSnapshot(record.fileType == FOLDER ? FOLDER_METADATA : GAME_METADATA, reader, system))
+		{
+			LOG(LogWarning) << "Corrupted gamelist journal record for " << record.path;
+			continue;
+		}
+
+		finalizeGamelistEntry(file, record.path, trustGamelist, true);
+		liveRecords.push_back(record);
+	}
+
+	// Records of files outside of fileMap are still live
+	if (!createFiles)
+		return;
+
+	LOG(LogInfo) << "Gamelist journal for system " << system->getName() << " : " << liveRecords.size() << " entries restored from " << records.size() << " records";
+
+	if (damaged || liveRecords.size() != records.size())
+		GamelistJournal::getInstance()->rewrite(journalPath, liveRecords);
+}
+
+static size_t loadGamelists(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, bool createFiles)
 {
 	std::string xmlpath = system->getGamelistPath(false);
 
 	auto size = Utils::FileSystem::getFileSize(xmlpath);
 	if (size != 0)
-		loadGamelistFile(xmlpath, system, fileMap, SIZE_MAX, true);
+		loadGamelistFile(xmlpath, system, fileMap, SIZE_MAX, true, createFiles);
 
 	auto files = Utils::FileSystem::getDirContent(getGamelistRecoveryPath(system), true);
 	for (auto file : files)
-		loadGamelistFile(file, system, fileMap, size, true);
+		if (Utils::String::toLower(Utils::FileSystem::getExtension(file)) == ".xml")
+			loadGamelistFile(file, system, fileMap, size, true, createFiles);
+
+	loadGamelistJournal(system, fileMap, size, createFiles);
+	return size;
+}
+
+void parseGamelist(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap)
+{
+	auto size = loadGamelists(system, fileMap, true);
 
 	if (size != SIZE_MAX)
 		system->setGamelistHash(size);	
 }
 
+void loadGamelistMetadata(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap)
+{
+	if (fileMap.size() > 0)
+		loadGamelists(system, fileMap, false);
+}
+
 bool addFileDataNode(pugi::xml_node& parent, FileData* file, const char* tag, SystemData* system, bool fullPaths = false)
 {
 	//create game and add to parent node
@@ -507,110 +753,70 @@ bool saveToXml(FileData* file, const std::string& fileName, bool fullPaths)
 
 bool saveToGamelistRecovery(FileData* file)
 {
-    if (!Settings::getInstance()->getBool("SaveGamelistsOnExit"))
-        return false;
-
-    if (!file || !file->getSourceFileData() || !file->getSourceFileData()->getSystem()) {
-        LOG(LogWarning) << "[Gamelist saveToGamelistRecovery] File, SourceFileData o SystemData nullo. Impossibile salvare il recovery.";
-        return false;
-    }
-
-    SystemData* system = file->getSourceFileData()->getSystem();
-    if (!Settings::HiddenSystemsShowGames() && !system->isVisible())
-        return false;
-
-    std::string originalGamePath = file->getPath();
-    
-    // Ottieni la directory base per i file di recovery del sistema
-    // La chiamata a Paths::getGamelistRecoveryPath(system) dovrebbe funzionare se Paths.h è incluso
-    // e se non ci sono conflitti di namespace (es. se Gamelist.cpp ha 'using namespace Paths;')
-    std::string recoveryDir = Paths::getGamelistRecoveryPath(system); // Usa Paths:: se necessario
-    if (recoveryDir.empty()) {
-        LOG(LogError) << "[Gamelist saveToGamelistRecovery] Impossibile ottenere la directory di recovery per il sistema: " << system->getName();
-        return false;
-    }
-    if (!Utils::FileSystem::exists(recoveryDir)) { // Assicurati che la directory esista
-         Utils::FileSystem::createDirectory(recoveryDir); // createDirectory dovrebbe creare anche i parenti
-         if (!Utils::FileSystem::exists(recoveryDir)) {
-              LOG(LogError) << "[Gamelist saveToGamelistRecovery] Impossibile creare la directory di recovery: " << recoveryDir;
-              return false;
-         }
-    }
-
-    // Sanitizza il path originale del gioco per creare un nome file VALIDO
-    std::string safeBaseFileName = Utils::FileSystem::createValidFileName(originalGamePath); 
-    
-    std::string finalRecoveryPath = recoveryDir + "/" + safeBaseFileName + ".xml";
+	if (!Settings::getInstance()->getBool("SaveGamelistsOnExit"))
+		return false;
 
-    LOG(LogDebug) << "[Gamelist saveToGamelistRecovery] Tentativo salvataggio. Original Path: [" << originalGamePath 
-                  << "], Final Recovery Path: [" << finalRecoveryPath << "]";
+	if (!file || !file->getSourceFileData() || !file->getSourceFileData()->getSystem())
+	{
+		LOG(LogWarning) << "[Gamelist saveToGamelistRecovery] File, SourceFileData o SystemData nullo. Impossibile salvare il recovery.";
+		return false;
+	}
 
-  pugi::xml_document doc;
-    pugi::xml_node gameNode = doc.append_child("game"); 
-    if (!gameNode) {
-        LOG(LogError) << "[Gamelist saveToGamelistRecovery] Impossibile creare il nodo <game> PugiXML per: " << finalRecoveryPath;
-        return false; // o return; se void
-    }
+	SystemData* system = file->getSourceFileData()->getSystem();
+	if (!Settings::HiddenSystemsShowGames() && !system->isVisible())
+		return false;
 
-    SystemEnvironmentData* envData = system->getSystemEnvData();
-    std::string startPath = envData ? envData->mStartPath : "";
-    // Assicurati che il quarto parametro 'detailed' sia quello che vuoi (true di solito per i gamelist)
-    file->getMetadata().appendToXML(gameNode, true, startPath, true); // Passa gameNode
+	pugi::xml_document doc;
+	pugi::xml_node fileNode = doc.append_child(file->getType() == FOLDER ? "folder" : "game");
 
-  std::ofstream fileStream(finalRecoveryPath, std::ios_base::out | std::ios_base::trunc);
-    if (!fileStream) { // Controlla se l'APERTURA del file è riuscita
-        LOG(LogError) << "[Gamelist saveToGamelistRecovery] ERRORE nell'apertura del file XML per scrittura: \"" << finalRecoveryPath << "\"!";
-        return false; // O la gestione dell'errore appropriata
-    }
+	SystemEnvironmentData* envData = system->getSystemEnvData();
+	std::string startPath = envData ? envData->mStartPath : "";
+	file->getMetadata().appendToXML(fileNode, true, startPath, true);
 
-    // La funzione doc.save(std::ostream&...) è void. Non restituisce un valore booleano.
-    doc.save(fileStream, "  ", pugi::format_default | pugi::format_write_bom, pugi::encoding_utf8);
+	Utils::BinaryWriter writer;
+	MetaDataList::writeSnapshot(fileNode, writer);
 
-    // Controlla lo stato dello stream DOPO la scrittura per verificare errori.
-    if (!fileStream.good()) { // Se lo stream è andato in uno stato di errore durante la scrittura
-        LOG(LogError) << "[Gamelist saveToGamelistRecovery] ERRORE durante la scrittura PugiXML su file stream per: \"" << finalRecoveryPath << "\"!";
-        fileStream.close(); // Chiudi comunque lo stream
-        // Considera di cancellare il file parzialmente scritto se è un errore critico
-        // Utils::FileSystem::removeFile(finalRecoveryPath); 
-        return false; 
-    }
-    fileStream.close();
+	GamelistJournal::Record record;
+	record.type = GamelistJournal::SAVE;
+	record.fileType = (uint8_t)file->getType();
+	record.gamelistSize = (uint64_t)system->getGamelistHash();
+	record.path = file->getPath();
+	record.metadata = writer.data();
 
-    if (!fileStream.good()) { 
-        LOG(LogWarning) << "[Gamelist saveToGamelistRecovery] Errore durante le operazioni di stream per: \"" << finalRecoveryPath << "\".";
-        return false; 
-    }
+	// Written to disk by the journal thread, together with the other changes of the same second
+	GamelistJournal::getInstance()->append(getGamelistJournalPath(system), record);
 
-    LOG(LogDebug) << "[Gamelist saveToGamelistRecovery] File di recovery salvato: " << finalRecoveryPath;
-    return true;
+	LOG(LogDebug) << "[Gamelist saveToGamelistRecovery] " << record.path;
+	return true;
 }
 
-// La tua funzione removeFromGamelistRecovery MODIFICATA:
 bool removeFromGamelistRecovery(FileData* file)
 {
-    if (!file || !file->getSourceFileData() || !file->getSourceFileData()->getSystem()) {
-        LOG(LogWarning) << "[Gamelist removeFromGamelistRecovery] File, SourceFileData o SystemData nullo.";
-        return false;
-    }
-    SystemData* system = file->getSourceFileData()->getSystem();
-
-    std::string originalGamePath = file->getPath();
-    std::string safeBaseFileName = Utils::FileSystem::createValidFileName(originalGamePath);
-    
-    std::string recoveryDir = Paths::getGamelistRecoveryPath(system); // Usa Paths:: se necessario
-    if (recoveryDir.empty()) {
-         LOG(LogWarning) << "[Gamelist removeFromGamelistRecovery] Impossibile ottenere la directory di recovery per il sistema: " << system->getName();
-         return false;
-    }
+	if (!Settings::getInstance()->getBool("SaveGamelistsOnExit"))
+		return false;
 
-    std::string finalRecoveryPath = recoveryDir + "/" + safeBaseFileName + ".xml";
+	if (!file || !file->getSourceFileData() || !file->getSourceFileData()->getSystem())
+	{
+		LOG(LogWarning) << "[Gamelist removeFromGamelistRecovery] File, SourceFileData o SystemData nullo.";
+		return false;
+	}
 
-    LOG(LogDebug) << "[Gamelist removeFromGamelistRecovery] Tentativo rimozione file: [" << finalRecoveryPath << "]";
+	SystemData* system = file->getSourceFileData()->getSystem();
 
-    if (Utils::FileSystem::exists(finalRecoveryPath))
-        return Utils::FileSystem::removeFile(finalRecoveryPath);
+	GamelistJournal::Record record;
+	record.type = GamelistJournal::REMOVE;
+	record.fileType = (uint8_t)file->getType();
+	record.gamelistSize = (uint64_t)system->getGamelistHash();
+	record.path = file->getPath();
 
-    return false; 
+	GamelistJournal::getInstance()->append(getGamelistJournalPath(system), record);
+
+	// Recovery files written before the journal existed
+	std::string legacyPath = getGamelistRecoveryPath(system) + "/" + Utils::FileSystem::createValidFileName(record.path) + ".xml";
+	if (Utils::FileSystem::exists(legacyPath))
+		Utils::FileSystem::removeFile(legacyPath);
+
+	return true;
 }
 
 bool hasDirtyFile(SystemData* system)
@@ -809,6 +1015,7 @@ void updateGamelist(SystemData* system)
 			}
 			clearTemporaryGamelistRecovery(system);
 			system->setGamelistHash(Utils::FileSystem::getFileSize(xmlWritePath)); // Update hash
+			saveGamelistSnapshot(xmlWritePath, system, root);
 		}
 	}
 	else
@@ -1066,7 +1273,10 @@ void cleanupGamelist(SystemData* system)
 		if (!doc.save_file(WINSTRINGW(xmlWritePath).c_str()))
 			LOG(LogError) << "Error saving gamelist.xml to \"" << xmlWritePath << "\" (for system " << system->getName() << ")!";
 		else
+		{
 			clearTemporaryGamelistRecovery(system);
+			saveGamelistSnapshot(xmlWritePath, system, root);
+		}
 	}
 	else
 		clearTemporaryGamelistRecovery(system);
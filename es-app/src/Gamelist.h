@@ -12,6 +12,8 @@ class FileData;
 
 // Loads gamelist.xml data into a SystemData.
 void parseGamelist(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap);
+// Same for the files of fileMap only, no entry is created ( files found after the system was loaded )
+void loadGamelistMetadata(SystemData* system, std::unordered_map<std::string, FileData*>& fileMap);
 
 // Writes currently loaded metadata for a SystemData to gamelist.xml.
 void updateGamelist(SystemData* system);
@@ -25,6 +27,6 @@ bool saveToXml(FileData* file, const std::string& fileName, bool fullPaths = fal
 
 bool hasDirtyFile(SystemData* system);
 
-std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, size_t checkSize = SIZE_MAX, bool fromFile = true);
+std::vector<FileData*> loadGamelistFile(const std::string xmlpath, SystemData* system, std::unordered_map<std::string, FileData*>& fileMap, size_t checkSize = SIZE_MAX, bool fromFile = true, bool createFiles = true);
 
 #endif // ES_APP_GAME_LIST_H
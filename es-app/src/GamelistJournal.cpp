@@ -0,0 +1,270 @@
+#include "GamelistJournal.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "utils/BinaryStream.h"
+#include "utils/MemoryMappedFile.h"
+#include "MetaData.h"
+#include "Log.h"
+
+#include <chrono>
+#include <cstdio>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#define JOURNAL_MAGIC			0x4A475345 // "ESGJ"
+#define JOURNAL_VERSION			1
+
+// Group commit : pending records are written at most every JOURNAL_COMMIT_DELAY ms, or as soon as there are JOURNAL_COMMIT_RECORDS of them
+#define JOURNAL_COMMIT_DELAY	1000
+#define JOURNAL_COMMIT_RECORDS	256
+
+GamelistJournal* GamelistJournal::getInstance()
+{
+	static GamelistJournal instance;
+	return &instance;
+}
+
+GamelistJournal::GamelistJournal() : mPendingCount(0), mThread(nullptr), mExit(false)
+{
+
+}
+
+GamelistJournal::~GamelistJournal()
+{
+	if (mThread != nullptr)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mLock);
+			mExit = true;
+			mEvent.notify_one();
+		}
+
+		mThread->join();
+		delete mThread;
+		mThread = nullptr;
+	}
+
+	flush();
+}
+
+void GamelistJournal::writeRecord(std::string& buffer, const Record& record)
+{
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(0);
+	writer.write<uint8_t>(record.type);
+	writer.write<uint8_t>(record.fileType);
+	writer.write<uint64_t>(record.gamelistSize);
+	writer.writeString(record.path);
+	writer.writeString(record.metadata);
+	writer.writeAt<uint32_t>(0, (uint32_t)(writer.size() - sizeof(uint32_t)));
+
+	buffer += writer.data();
+}
+
+void GamelistJournal::append(const std::string& journalPath, const Record& record)
+{
+	std::unique_lock<std::mutex> lock(mLock);
+
+	writeRecord(mPending[journalPath], record);
+	mPendingCount++;
+
+	if (mThread == nullptr)
+		mThread = new std::thread(&GamelistJournal::run, this);
+	else if (mPendingCount >= JOURNAL_COMMIT_RECORDS)
+		mEvent.notify_one();
+}
+
+void GamelistJournal::run()
+{
+	std::unique_lock<std::mutex> lock(mLock);
+
+	while (!mExit)
+	{
+		mEvent.wait_for(lock, std::chrono::milliseconds(JOURNAL_COMMIT_DELAY), [this] { return mExit || mPendingCount >= JOURNAL_COMMIT_RECORDS; });
+
+		if (mPendingCount == 0)
+			continue;
+
+		lock.unlock();
+		flush();
+		lock.lock();
+	}
+}
+
+void GamelistJournal::flush(const std::string& journalPath)
+{
+	std::unique_lock<std::mutex> writeLock(mWriteLock);
+
+	std::map<std::string, std::string> pending;
+
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+
+		if (journalPath.empty())
+		{
+			pending.swap(mPending);
+			mPendingCount = 0;
+		}
+		else
+		{
+			auto it = mPending.find(journalPath);
+			if (it == mPending.cend())
+				return;
+
+			pending[journalPath].swap(it->second);
+			mPending.erase(it);
+
+			// Only used to trigger commits, reset by the next full flush
+			if (mPending.size() == 0)
+				mPendingCount = 0;
+		}
+	}
+
+	for (auto& item : pending)
+		if (!writeFile(item.first, item.second, false))
+			LOG(LogError) << "GamelistJournal : unable to write " << item.first;
+}
+
+void GamelistJournal::discard(const std::string& journalPath)
+{
+	std::unique_lock<std::mutex> writeLock(mWriteLock);
+	std::unique_lock<std::mutex> lock(mLock);
+
+	mPending.erase(journalPath);
+	if (mPending.size() == 0)
+		mPendingCount = 0;
+}
+
+bool GamelistJournal::writeFile(const std::string& journalPath, const std::string& data, bool truncate)
+{
+	std::string parent = Utils::FileSystem::getParent(journalPath);
+	if (!Utils::FileSystem::exists(parent))
+		Utils::FileSystem::createDirectory(parent);
+
+	bool writeHeader = truncate || Utils::FileSystem::getFileSize(journalPath) == 0;
+
+#if defined(_WIN32)
+	FILE* file = _wfopen(Utils::String::convertToWideString(journalPath).c_str(), truncate ? L"wb" : L"ab");
+#else
+	FILE* file = fopen(journalPath.c_str(), truncate ? "wb" : "ab");
+#endif
+	if (file == nullptr)
+		return false;
+
+	bool ret = true;
+
+	if (writeHeader)
+	{
+		Utils::BinaryWriter header;
+		header.write<uint32_t>(JOURNAL_MAGIC);
+		header.write<uint32_t>(JOURNAL_VERSION);
+		header.write<uint32_t>((uint32_t)MetaDataList::getMDD().size());
+		ret = fwrite(header.data().data(), 1, header.size(), file) == header.size();
+	}
+
+	if (ret && !data.empty())
+		ret = fwrite(data.data(), 1, data.size(), file) == data.size();
+
+	// One sync per commit, whatever the number of records
+	fflush(file);
+#if defined(_WIN32)
+	_commit(_fileno(file));
+#else
+	fsync(fileno(file));
+#endif
+
+	fclose(file);
+	return ret;
+}
+
+std::vector<GamelistJournal::Record> GamelistJournal::read(const std::string& journalPath, bool* damaged)
+{
+	std::vector<Record> ret;
+
+	if (damaged != nullptr)
+		*damaged = false;
+
+	flush(journalPath);
+
+	std::unique_lock<std::mutex> writeLock(mWriteLock);
+
+	Utils::MemoryMappedFile file;
+	if (!file.open(journalPath))
+		return ret;
+
+	Utils::BinaryReader reader(file.data(), file.size());
+
+	uint32_t magic, version, mddCount;
+	if (!reader.read(magic) || magic != JOURNAL_MAGIC || !reader.read(version) || version != JOURNAL_VERSION || !reader.read(mddCount) || mddCount != (uint32_t)MetaDataList::getMDD().size())
+	{
+		LOG(LogWarning) << "GamelistJournal : ignoring incompatible journal " << journalPath;
+
+		if (damaged != nullptr)
+			*damaged = true;
+
+		return ret;
+	}
+
+	// End of the last complete record
+	size_t validLength = reader.position();
+
+	while (!reader.eof())
+	{
+		uint32_t size;
+		if (!reader.read(size))
+			break;
+
+		// A record cut by a crash ends the journal
+		Utils::BinaryReader entry = reader.subReader(size);
+		if (!entry.isValid())
+			break;
+
+		Record record;
+		uint8_t type;
+
+		if (!entry.read(type) || !entry.read(record.fileType) || !entry.read(record.gamelistSize) || !entry.readString(record.path) || !entry.readString(record.metadata))
+			break;
+
+		record.type = (RecordType)type;
+		ret.push_back(record);
+
+		validLength = reader.position();
+	}
+
+	// Records appended after a torn one would never be read : the caller has to rewrite the journal
+	if (validLength < file.size())
+	{
+		LOG(LogWarning) << "GamelistJournal : " << (file.size() - validLength) << " bytes of damaged records at the end of " << journalPath;
+
+		if (damaged != nullptr)
+			*damaged = true;
+	}
+
+	return ret;
+}
+
+bool GamelistJournal::rewrite(const std::string& journalPath, const std::vector<Record>& records)
+{
+	std::string data;
+	for (auto& record : records)
+		writeRecord(data, record);
+
+	std::unique_lock<std::mutex> writeLock(mWriteLock);
+
+	if (records.size() == 0)
+		return Utils::FileSystem::removeFile(journalPath);
+
+	std::string tmpPath = journalPath + ".tmp";
+	if (!writeFile(tmpPath, data, true))
+	{
+		Utils::FileSystem::removeFile(tmpPath);
+		return false;
+	}
+
+	return Utils::FileSystem::renameFile(tmpPath, journalPath);
+}
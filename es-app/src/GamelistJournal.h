@@ -0,0 +1,68 @@
+#pragma once
+#ifndef ES_APP_GAMELIST_JOURNAL_H
+#define ES_APP_GAMELIST_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstdint>
+
+//
+// Append-only journal of the metadata changes not yet saved to gamelist.xml, one file per system in the recovery folder.
+// Records are queued in memory & committed by a background thread : one write & one sync for all the records of the last second ( group commit ).
+// The journal is replayed & compacted by parseGamelist, and deleted once the gamelist is saved.
+//
+class GamelistJournal
+{
+public:
+	enum RecordType : uint8_t
+	{
+		SAVE = 1,
+		REMOVE = 2
+	};
+
+	struct Record
+	{
+		RecordType	type;
+		uint8_t		fileType;
+		uint64_t	gamelistSize;	// gamelist.xml size when the record was written
+		std::string path;
+		std::string metadata;	// MetaDataList snapshot
+	};
+
+	static GamelistJournal* getInstance();
+
+	void append(const std::string& journalPath, const Record& record);
+
+	// Writes the pending records now. Empty path for all journals
+	void flush(const std::string& journalPath = "");
+	// Forgets the pending records, the journal file is about to be deleted
+	void discard(const std::string& journalPath);
+
+	// damaged is set when the file has unreadable data ( torn record, other version ) : it must be rewritten before new records are appended
+	std::vector<Record> read(const std::string& journalPath, bool* damaged = nullptr);
+	bool rewrite(const std::string& journalPath, const std::vector<Record>& records);
+
+private:
+	GamelistJournal();
+	~GamelistJournal();
+
+	void run();
+
+	static void writeRecord(std::string& buffer, const Record& record);
+	static bool writeFile(const std::string& journalPath, const std::string& data, bool truncate);
+
+	std::mutex								mLock;			// mPending
+	std::mutex								mWriteLock;		// Journal files, keeps the commits in order
+	std::condition_variable					mEvent;
+	std::map<std::string, std::string>		mPending;
+	size_t									mPendingCount;
+
+	std::thread*							mThread;
+	bool									mExit;
+};
+
+#endif // ES_APP_GAMELIST_JOURNAL_H
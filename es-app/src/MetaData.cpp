@@ -10,6 +10,10 @@
 #include "FileData.h"
 #include "ImageIO.h"
 #include "EmulationStation.h"
+#include "utils/BinaryStream.h"
+#include <bitset>
+#include <shared_mutex>
+#include <unordered_set>
 #define N_(String) (String)
 
 std::vector<MetaDataDecl> MetaDataList::mMetaDataDecls = {
@@ -199,26 +203,299 @@ MetaDataId MetaDataList::getId(const std::string& key) const
 	return mGameIdMap[key];
 }
 
+std::atomic<unsigned int> MetaDataList::mChangeCount(0);
+
 MetaDataList::MetaDataList(MetaDataListType type) : mType(type), mWasChanged(false), mRelativeTo(nullptr)
 {
+	for (int i = 0; i < PRESENT_WORDS; i++)
+		mPresent[i] = 0;
 
+	// A new list may reuse the address of a deleted file
+	mVersion = ++mChangeCount;
 }
 
-void MetaDataList::loadFromXML(MetaDataListType type, pugi::xml_node& node, SystemData* system)
+// Shared storage for low-cardinality values. Strings are never released, pointers stay valid for the process lifetime.
+class MetaDataStringPool
+{
+public:
+	static const std::string* intern(const std::string& value)
+	{
+		{
+			std::shared_lock<std::shared_mutex> lock(mLock);
+			auto it = mStrings.find(value);
+			if (it != mStrings.cend())
+				return &(*it);
+		}
+
+		std::unique_lock<std::shared_mutex> lock(mLock);
+		return &(*mStrings.insert(value).first);
+	}
+
+private:
+	static std::shared_mutex mLock;
+	static std::unordered_set<std::string> mStrings;
+};
+
+std::shared_mutex MetaDataStringPool::mLock;
+std::unordered_set<std::string> MetaDataStringPool::mStrings;
+
+static bool isInternedMetaData(MetaDataId id)
+{
+	switch (id)
+	{
+	case MetaDataId::Genre:
+	case MetaDataId::GenreIds:
+	case MetaDataId::Family:
+	case MetaDataId::Developer:
+	case MetaDataId::Publisher:
+	case MetaDataId::Region:
+	case MetaDataId::Language:
+	case MetaDataId::Emulator:
+	case MetaDataId::Core:
+	case MetaDataId::Players:
+	case MetaDataId::ArcadeSystemName:
+	case MetaDataId::StoreProvider:
+		return true;
+
+	default:
+		break;
+	}
+
+	return false;
+}
+
+// Iso dates are stored as their digits when written as yyyymmddThhmmss
+static bool parseDateKey(const std::string& value, int64_t& key)
+{
+	if (value.size() != 15 || value[8] != 'T')
+		return false;
+
+	key = 0;
+
+	for (int i = 0; i < 15; i++)
+	{
+		if (i == 8)
+			continue;
+
+		char c = value[i];
+		if (c < '0' || c > '9')
+			return false;
+
+		key = key * 10 + (c - '0');
+	}
+
+	return true;
+}
+
+static std::string formatDateKey(int64_t key)
+{
+	char buffer[16];
+	snprintf(buffer, sizeof(buffer), "%08dT%06d", (int)(key / 1000000), (int)(key % 1000000));
+	return buffer;
+}
+
+int MetaDataList::getSlotPosition(MetaDataId id) const
+{
+	int word = id >> 6;
+	int bit = id & 63;
+
+	int position = 0;
+	for (int i = 0; i < word; i++)
+		position += (int)std::bitset<64>(mPresent[i]).count();
+
+	if (bit > 0)
+		position += (int)std::bitset<64>(mPresent[word] & ((1ULL << bit) - 1)).count();
+
+	return position;
+}
+
+int MetaDataList::findSlot(MetaDataId id) const
+{
+	if (id < 0 || id >= MAX_METADATA_TYPES)
+		return -1;
+
+	if ((mPresent[id >> 6] & (1ULL << (id & 63))) == 0)
+		return -1;
+
+	return getSlotPosition(id);
+}
+
+void MetaDataList::encodeValue(MetaDataId id, const std::string& value, MetaDataValue& slot)
+{
+	slot.kind = MetaDataValue::TEXT;
+	slot.integer = 0;
+	slot.text.clear();
+
+	if (!value.empty())
+	{
+		switch (mGameTypeMap[id])
+		{
+		case MD_INT:
+			{
+				char* end = nullptr;
+				long long number = strtoll(value.c_str(), &end, 10);
+				if (end != nullptr && *end == 0 && std::to_string(number) == value)
+				{
+					slot.kind = MetaDataValue::INTEGER;
+					slot.integer = number;
+					return;
+				}
+			}
+			break;
+
+		case MD_FLOAT:
+		case MD_RATING:
+			{
+				char* end = nullptr;
+				float number = strtof(value.c_str(), &end);
+				if (end != nullptr && *end == 0 && std::to_string(number) == value)
+				{
+					slot.kind = MetaDataValue::REAL;
+					slot.real = number;
+					return;
+				}
+			}
+			break;
+
+		case MD_DATE:
+		case MD_TIME:
+			{
+				int64_t key;
+				if (parseDateKey(value, key))
+				{
+					slot.kind = MetaDataValue::DATE;
+					slot.integer = key;
+					return;
+				}
+			}
+			break;
+
+		case MD_BOOL:
+			slot.kind = MetaDataValue::INTERNED;
+			slot.interned = MetaDataStringPool::intern(value);
+			return;
+
+		default:
+			break;
+		}
+
+		if (isInternedMetaData(id))
+		{
+			slot.kind = MetaDataValue::INTERNED;
+			slot.interned = MetaDataStringPool::intern(value);
+			return;
+		}
+	}
+
+	slot.text = value;
+}
+
+std::string MetaDataList::valueToString(const MetaDataValue& slot) const
+{
+	switch (slot.kind)
+	{
+	case MetaDataValue::INTERNED:
+		return *slot.interned;
+	case MetaDataValue::INTEGER:
+		return std::to_string(slot.integer);
+	case MetaDataValue::REAL:
+		return std::to_string(slot.real);
+	case MetaDataValue::DATE:
+		return formatDateKey(slot.integer);
+
+	default:
+		break;
+	}
+
+	return slot.text;
+}
+
+bool MetaDataList::valueEquals(const MetaDataValue& slot, const std::string& value) const
+{
+	if (slot.kind == MetaDataValue::TEXT)
+		return slot.text == value;
+
+	if (slot.kind == MetaDataValue::INTERNED)
+		return *slot.interned == value;
+
+	return valueToString(slot) == value;
+}
+
+void MetaDataList::beginLoad(MetaDataListType type, SystemData* system)
 {
 	mType = type;
-	mRelativeTo = system;	
+	mRelativeTo = system;
 
 	mUnKnownElements.clear();
 	mScrapeDates.clear();
+}
 
-	std::string value;
-	std::string relativeTo = mRelativeTo->getStartPath();
+void MetaDataList::loadScrapeDate(const std::string& scraper, const std::string& date)
+{
+	auto scraperId = KnowScrapersIds.find(scraper);
+	if (scraperId == KnowScrapersIds.cend())
+		return;
+
+	Utils::Time::DateTime dateTime(date);
+	if (!dateTime.isValid())
+		return;
+
+	mScrapeDates[scraperId->second] = dateTime;
+}
+
+void MetaDataList::loadUnknownElement(const std::string& name, const std::string& value, bool isElement)
+{
+	LOG(LogDebug) << "loadFromXML (" << (isElement ? "Child" : "Attr") << "): Processing Key=[" << name << "], Value=[" << value.substr(0, 50) << (value.length() > 50 ? "..." : "") << "]"; // Logga chiave e valore letto
+	if (!value.empty())
+		mUnKnownElements.push_back(std::tuple<std::string, std::string, bool>(name, value, isElement));
+}
 
+void MetaDataList::loadElement(const MetaDataDecl& mdd, std::string value, bool isAttribute, bool preloadMedias)
+{
+	if (mdd.isAttribute != isAttribute)
+		return;
+
+	if (mdd.id == MetaDataId::Name)
+	{
+		mName = value;
+		return;
+	}
+
+	if (mdd.id == MetaDataId::GenreIds)
+		return;
+
+	if (value == mdd.defaultValue)
+		return;
+
+	if (mdd.type == MD_BOOL)
+		value = Utils::String::toLower(value);
+
+	if (preloadMedias && mdd.type == MD_PATH && (mdd.id == MetaDataId::Image || mdd.id == MetaDataId::Thumbnail || mdd.id == MetaDataId::Marquee || mdd.id == MetaDataId::Video) &&
+		!Utils::FileSystem::exists(Utils::FileSystem::resolveRelativePath(value, mRelativeTo->getStartPath(), true)))
+		return;
+
+	// Players -> remove "1-"
+	// if (type == GAME_METADATA && mdd.id == MetaDataId::Players && Utils::String::startsWith(value, "1-"))
+	// 	value = Utils::String::replace(value, "1-", "");
+
+	set(mdd.id, value);
+}
+
+static bool shouldPreloadMedias()
+{
 	bool preloadMedias = Settings::PreloadMedias();
 	if (preloadMedias && Settings::ParseGamelistOnly())
 		preloadMedias = false;
 
+	return preloadMedias;
+}
+
+void MetaDataList::loadFromXML(MetaDataListType type, pugi::xml_node& node, SystemData* system)
+{
+	beginLoad(type, system);
+
+	bool preloadMedias = shouldPreloadMedias();
+
 	for (pugi::xml_node xelement : node.children())
 	{
 		std::string name = xelement.name();
@@ -226,18 +503,8 @@ void MetaDataList::loadFromXML(MetaDataListType type, pugi::xml_node& node, Syst
 		if (name == "scrap")
 		{
 			if (xelement.attribute("name") && xelement.attribute("date"))
-			{
-				auto scraperId = KnowScrapersIds.find(xelement.attribute("name").value());
-				if (scraperId == KnowScrapersIds.cend())
-					continue;
-				
-				Utils::Time::DateTime dateTime(xelement.attribute("date").value());
-				if (!dateTime.isValid())
-					continue;
-								
-				mScrapeDates[scraperId->second] = dateTime;
-			}		
-								
+				loadScrapeDate(xelement.attribute("name").value(), xelement.attribute("date").value());
+
 			continue;
 		}
 
@@ -247,81 +514,161 @@ void MetaDataList::loadFromXML(MetaDataListType type, pugi::xml_node& node, Syst
 			if (name == "hash" || name == "path")
 				continue;
 
-			value = xelement.text().get();
-			LOG(LogDebug) << "loadFromXML (Child): Processing Key=[" << name << "], Value=[" << value.substr(0, 50) << (value.length() > 50 ? "..." : "") << "]"; // Logga chiave e valore letto
-			if (!value.empty())
-				mUnKnownElements.push_back(std::tuple<std::string, std::string, bool>(name, value, true));
-
+			loadUnknownElement(name, xelement.text().get(), true);
 			continue;
 		}
 
-		MetaDataDecl& mdd = mMetaDataDecls[mMetaDataIndexes[it->second]];
-		if (mdd.isAttribute)
-			continue;
+		loadElement(mMetaDataDecls[mMetaDataIndexes[it->second]], xelement.text().get(), false, preloadMedias);
+	}
 
-		value = xelement.text().get();
+	for (pugi::xml_attribute xattr : node.attributes())
+	{
+		std::string name = xattr.name();
 
-		if (mdd.id == MetaDataId::Name)
+		auto it = mGameIdMap.find(name);
+		if (it == mGameIdMap.cend())
 		{
-			mName = value;
+			loadUnknownElement(name, xattr.value(), false);
 			continue;
 		}
 
-		if (mdd.id == MetaDataId::GenreIds)
-			continue;
+		loadElement(mMetaDataDecls[mMetaDataIndexes[it->second]], xattr.value(), true, preloadMedias);
+	}
+}
+
+// Snapshot element ids. Positive values are MetaDataIds, keys are resolved once when the snapshot is written
+enum SnapshotElementId : int16_t
+{
+	SNAPSHOT_UNKNOWN = -1,
+	SNAPSHOT_SCRAPEDATE = -2
+};
+
+void MetaDataList::writeSnapshot(pugi::xml_node& node, Utils::BinaryWriter& writer)
+{
+	size_t countOffset = writer.size();
+	writer.write<uint16_t>(0);
 
-		if (value == mdd.defaultValue)
+	uint16_t count = 0;
+
+	for (pugi::xml_node xelement : node.children())
+	{
+		std::string name = xelement.name();
+		if (name == "path")
 			continue;
 
-		if (mdd.type == MD_BOOL)
-			value = Utils::String::toLower(value);
-		
-		if (preloadMedias && mdd.type == MD_PATH && (mdd.id == MetaDataId::Image || mdd.id == MetaDataId::Thumbnail || mdd.id == MetaDataId::Marquee || mdd.id == MetaDataId::Video) &&
-			!Utils::FileSystem::exists(Utils::FileSystem::resolveRelativePath(value, relativeTo, true)))
+		if (name == "scrap")
+		{
+			if (!xelement.attribute("name") || !xelement.attribute("date"))
+				continue;
+
+			writer.write<int16_t>(SNAPSHOT_SCRAPEDATE);
+			writer.write<uint8_t>(1);
+			writer.writeString(xelement.attribute("name").value());
+			writer.writeString(xelement.attribute("date").value());
+			count++;
 			continue;
-		
-		// Players -> remove "1-"
-		// if (type == GAME_METADATA && mdd.id == MetaDataId::Players && Utils::String::startsWith(value, "1-"))
-		// 	value = Utils::String::replace(value, "1-", "");
+		}
+
+		auto it = mGameIdMap.find(name);
+		if (it == mGameIdMap.cend())
+		{
+			writer.write<int16_t>(SNAPSHOT_UNKNOWN);
+			writer.write<uint8_t>(1);
+			writer.writeString(name);
+		}
+		else
+		{
+			writer.write<int16_t>((int16_t)it->second);
+			writer.write<uint8_t>(1);
+		}
 
-		set(mdd.id, value);
+		writer.writeString(xelement.text().get());
+		count++;
 	}
 
 	for (pugi::xml_attribute xattr : node.attributes())
 	{
 		std::string name = xattr.name();
+
 		auto it = mGameIdMap.find(name);
 		if (it == mGameIdMap.cend())
 		{
-			value = xattr.value();
-			LOG(LogDebug) << "loadFromXML (Attr): Processing Key=[" << name << "], Value=[" << value.substr(0, 50) << (value.length() > 50 ? "..." : "") << "]"; // Logga chiave e valore letto
-			if (!value.empty())
-				mUnKnownElements.push_back(std::tuple<std::string, std::string, bool>(name, value, false));
+			writer.write<int16_t>(SNAPSHOT_UNKNOWN);
+			writer.write<uint8_t>(0);
+			writer.writeString(name);
+		}
+		else
+		{
+			writer.write<int16_t>((int16_t)it->second);
+			writer.write<uint8_t>(0);
+		}
+
+		writer.writeString(xattr.value());
+		count++;
+	}
+
+	writer.writeAt<uint16_t>(countOffset, count);
+}
+
+bool MetaDataList::loadFromSnapshot(MetaDataListType type, Utils::BinaryReader& reader, SystemData* system)
+{
+	beginLoad(type, system);
+
+	bool preloadMedias = shouldPreloadMedias();
 
+	uint16_t count;
+	if (!reader.read(count))
+		return false;
+
+	std::string name;
+	std::string value;
+	std::string hash;
+
+	for (int i = 0; i < count; i++)
+	{
+		int16_t id;
+		uint8_t isElement;
+
+		if (!reader.read(id) || !reader.read(isElement))
+			return false;
+
+		if (id == SNAPSHOT_SCRAPEDATE)
+		{
+			if (!reader.readString(name) || !reader.readString(value))
+				return false;
+
+			loadScrapeDate(name, value);
 			continue;
 		}
 
-		MetaDataDecl& mdd = mMetaDataDecls[mMetaDataIndexes[it->second]];
-		if (!mdd.isAttribute)
-			continue;
+		if (id == SNAPSHOT_UNKNOWN)
+		{
+			if (!reader.readString(name) || !reader.readString(value))
+				return false;
 
-		value = xattr.value();
+			if (isElement && name == "hash")
+				hash = value;
+			else
+				loadUnknownElement(name, value, isElement != 0);
 
-		if (value == mdd.defaultValue)
 			continue;
+		}
 
-		if (mdd.type == MD_BOOL)
-			value = Utils::String::toLower(value);
+		if (!reader.readString(value))
+			return false;
 
-		// Players -> remove "1-"
-		// if (type == GAME_METADATA && mdd.id == MetaDataId::Players && Utils::String::startsWith(value, "1-"))
-		// 	value = Utils::String::replace(value, "1-", "");
+		auto idx = mMetaDataIndexes.find((MetaDataId)id);
+		if (idx == mMetaDataIndexes.cend())
+			continue;
 
-		if (mdd.id == MetaDataId::Name)
-			mName = value;
-		else
-			set(mdd.id, value);
+		loadElement(mMetaDataDecls[idx->second], value, isElement == 0, preloadMedias);
 	}
+
+	// Same as migrate() for xml nodes
+	if (!hash.empty() && get(MetaDataId::Crc32).empty())
+		set(MetaDataId::Crc32, hash);
+
+	return true;
 }
 
 // Add migration for alternative formats & old tags
@@ -351,16 +698,16 @@ void MetaDataList::appendToXML(pugi::xml_node& parent, bool ignoreDefaults, cons
 		if (mddIter->id == MetaDataId::GenreIds)
 			continue;
 
-		auto mapIter = mMap.find(mddIter->id);
-		if(mapIter != mMap.cend())
+		int slot = findSlot(mddIter->id);
+		if (slot >= 0)
 		{
 			// we have this value!
 			// if it's just the default (and we ignore defaults), don't write it
-			if (ignoreDefaults && mapIter->second == mddIter->defaultValue)
+			std::string value = valueToString(mValues[slot]);
+			if (ignoreDefaults && value == mddIter->defaultValue)
 				continue;
 
 			// try and make paths relative if we can
-			std::string value = mapIter->second;
 			if (mddIter->type == MD_PATH)
 			{
 				if (fullPaths && mRelativeTo != nullptr)
@@ -412,66 +759,152 @@ void MetaDataList::appendToXML(pugi::xml_node& parent, bool ignoreDefaults, cons
 
 void MetaDataList::set(MetaDataId id, const std::string& value)
 {
-    if (id == MetaDataId::Name)
-    {
-        if (mName == value)
-            return;
+	if (id == MetaDataId::Name)
+	{
+		if (mName == value)
+			return;
 
-        mName = value;
-        mWasChanged = true;
-        return;
-    }
+		mName = value;
+		mWasChanged = true;
+		mVersion = ++mChangeCount;
+		return;
+	}
 
-    auto prev = mMap.find(id);
-    if (prev != mMap.cend() && prev->second == value)
-        return;
+	if (id < 0 || id >= MAX_METADATA_TYPES)
+		return;
 
-    if (mGameTypeMap[id] == MD_PATH && mRelativeTo != nullptr)
-    {
-        // Se il valore è un URL (inizia con http), salvalo così com'è. NON TOCCARLO.
-        if (Utils::String::startsWith(value, "http"))
-        {
-            mMap[id] = value;
-        }
-        // ALTRIMENTI, è un file locale e possiamo creare il percorso relativo.
-        else
-        {
-            mMap[id] = Utils::FileSystem::createRelativePath(value, mRelativeTo->getStartPath(), true);
-        }
-    }
-    else
-    {
-        mMap[id] = Utils::String::trim(value);
-    }
+	int slot = findSlot(id);
+	if (slot >= 0 && valueEquals(mValues[slot], value))
+		return;
+
+	std::string storedValue;
 
-    mWasChanged = true;
+	if (mGameTypeMap[id] == MD_PATH && mRelativeTo != nullptr)
+	{
+		// Se il valore è un URL (inizia con http), salvalo così com'è. NON TOCCARLO.
+		if (Utils::String::startsWith(value, "http"))
+			storedValue = value;
+		// ALTRIMENTI, è un file locale e possiamo creare il percorso relativo.
+		else
+			storedValue = Utils::FileSystem::createRelativePath(value, mRelativeTo->getStartPath(), true);
+	}
+	else
+		storedValue = Utils::String::trim(value);
+
+	if (slot < 0)
+	{
+		slot = getSlotPosition(id);
+		mValues.insert(mValues.begin() + slot, MetaDataValue());
+		mPresent[id >> 6] |= (1ULL << (id & 63));
+	}
+
+	encodeValue(id, storedValue, mValues[slot]);
+	mWasChanged = true;
+	mVersion = ++mChangeCount;
 }
 
 const std::string MetaDataList::get(MetaDataId id, bool resolveRelativePaths) const
 {
-    if (id == MetaDataId::Name)
-        return mName;
+	if (id == MetaDataId::Name)
+		return mName;
 
-    auto it = mMap.find(id);
-    if (it != mMap.end())
-    {
-        const std::string& path = it->second;
+	int slot = findSlot(id);
+	if (slot < 0)
+		return mDefaultGameMap[id];
 
-        // PRIMO CONTROLLO: Se è un URL, non toccarlo e restituiscilo subito.
-        if (Utils::String::startsWith(path, "http"))
-            return path; // Se è un URL, restituiscilo subito, pulito.
+	// Typed & pooled values are never paths
+	const MetaDataValue& value = mValues[slot];
+	if (value.kind != MetaDataValue::TEXT)
+		return valueToString(value);
 
-        // Se non è un URL, allora è un file locale e possiamo procedere
-        // con la vecchia logica per risolvere i percorsi relativi.
-        if (resolveRelativePaths && mGameTypeMap[id] == MD_PATH && mRelativeTo != nullptr)
-            return Utils::FileSystem::resolveRelativePath(path, mRelativeTo->getStartPath(), true);
+	const std::string& path = value.text;
 
-        // Se nessuna delle condizioni sopra è vera, restituisci il percorso così com'è.
-        return path;
-    }
+	// PRIMO CONTROLLO: Se è un URL, non toccarlo e restituiscilo subito.
+	if (Utils::String::startsWith(path, "http"))
+		return path;
+
+	// Se non è un URL, allora è un file locale e possiamo procedere
+	// con la vecchia logica per risolvere i percorsi relativi.
+	if (resolveRelativePaths && mGameTypeMap[id] == MD_PATH && mRelativeTo != nullptr)
+		return Utils::FileSystem::resolveRelativePath(path, mRelativeTo->getStartPath(), true);
+
+	return path;
+}
+
+std::string_view MetaDataList::getView(MetaDataId id, std::string& buffer) const
+{
+	if (id == MetaDataId::Name)
+		return mName;
+
+	int slot = findSlot(id);
+	if (slot < 0)
+		return mDefaultGameMap[id];
+
+	const MetaDataValue& value = mValues[slot];
+	if (value.kind == MetaDataValue::TEXT)
+		return value.text;
+
+	if (value.kind == MetaDataValue::INTERNED)
+		return *value.interned;
+
+	// Typed values have no text form in memory : format them in the caller buffer rather than growing the pool
+	buffer = valueToString(value);
+	return buffer;
+}
+
+bool MetaDataList::slotEquals(const MetaDataValue& a, const MetaDataValue& b) const
+{
+	if (a.kind != b.kind)
+		return valueToString(a) == valueToString(b);
+
+	switch (a.kind)
+	{
+	case MetaDataValue::INTERNED:
+		return a.interned == b.interned;
+	case MetaDataValue::INTEGER:
+	case MetaDataValue::DATE:
+		return a.integer == b.integer;
+	case MetaDataValue::REAL:
+		return a.real == b.real;
+
+	default:
+		break;
+	}
 
-    // Se non trova nulla, restituisce il valore di default.
-    return mDefaultGameMap[id];
+	return a.text == b.text;
+}
+
+bool MetaDataList::hasSameValues(const MetaDataList& other) const
+{
+	if (mName != other.mName)
+		return false;
+
+	for (auto& mdd : mMetaDataDecls)
+	{
+		if (mdd.id == MetaDataId::Name)
+			continue;
+
+		int slot = findSlot(mdd.id);
+		int otherSlot = other.findSlot(mdd.id);
+
+		if (slot < 0 && otherSlot < 0)
+			continue;
+
+		if (slot >= 0 && otherSlot >= 0)
+		{
+			if (!slotEquals(mValues[slot], other.mValues[otherSlot]))
+				return false;
+		}
+		else if (slot >= 0)
+		{
+			if (!valueEquals(mValues[slot], mDefaultGameMap[mdd.id]))
+				return false;
+		}
+		else if (!other.valueEquals(other.mValues[otherSlot], mDefaultGameMap[mdd.id]))
+			return false;
+	}
+
+	return true;
 }
 
 void MetaDataList::set(const std::string& key, const std::string& value)
@@ -497,14 +930,47 @@ const std::string MetaDataList::get(const std::string& key, bool resolveRelative
 
 int MetaDataList::getInt(MetaDataId id) const
 {
+	int slot = findSlot(id);
+	if (slot >= 0 && mValues[slot].kind == MetaDataValue::INTEGER)
+		return (int)mValues[slot].integer;
+
 	return atoi(get(id).c_str());
 }
 
 float MetaDataList::getFloat(MetaDataId id) const
 {
+	int slot = findSlot(id);
+	if (slot >= 0)
+	{
+		if (mValues[slot].kind == MetaDataValue::REAL)
+			return mValues[slot].real;
+
+		if (mValues[slot].kind == MetaDataValue::INTEGER)
+			return (float)mValues[slot].integer;
+	}
+
 	return Utils::String::toFloat(get(id));
 }
 
+bool MetaDataList::getBool(MetaDataId id) const
+{
+	std::string buffer;
+	return getView(id, buffer) == "true";
+}
+
+int64_t MetaDataList::getDateKey(MetaDataId id) const
+{
+	int slot = findSlot(id);
+	if (slot >= 0 && mValues[slot].kind == MetaDataValue::DATE)
+		return mValues[slot].integer;
+
+	int64_t key;
+	if (parseDateKey(get(id), key))
+		return key;
+
+	return 0;
+}
+
 bool MetaDataList::wasChanged() const
 {
 	return mWasChanged;
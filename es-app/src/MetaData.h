@@ -2,10 +2,13 @@
 #ifndef ES_APP_META_DATA_H
 #define ES_APP_META_DATA_H
 
+#include <atomic>
 #include <map>
 #include <vector>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <cstdint>
 
 #include "utils/TimeUtil.h"
 
@@ -14,6 +17,7 @@ class FileData;
 class Scraper;
 
 namespace pugi { class xml_node; }
+namespace Utils { class BinaryWriter; class BinaryReader; }
 
 enum MetaDataType
 {
@@ -172,17 +176,32 @@ public:
 
 	void migrate(FileData* file, pugi::xml_node& node);
 
+	// Binary form of a gamelist node, with keys already resolved to MetaDataIds. Read back with loadFromSnapshot
+	static void writeSnapshot(pugi::xml_node& node, Utils::BinaryWriter& writer);
+	bool loadFromSnapshot(MetaDataListType type, Utils::BinaryReader& reader, SystemData* system);
+
 	MetaDataList(MetaDataListType type);
 	
 	void set(MetaDataId id, const std::string& value);
 
 	const std::string get(MetaDataId id, bool resolveRelativePaths = true) const;
+
+	// Stored value without copy, for hot readers. MD_PATH values are returned unresolved, use get() for full paths.
+	// Numbers & dates are formatted in buffer : their view is only valid as long as buffer is.
+	std::string_view getView(MetaDataId id, std::string& buffer) const;
+
+	// Same values as other, compared on the stored slots
+	bool hasSameValues(const MetaDataList& other) const;
 	
 	void set(const std::string& key, const std::string& value);
 	const std::string get(const std::string& key, bool resolveRelativePaths = true) const;
 
 	int getInt(MetaDataId id) const;
 	float getFloat(MetaDataId id) const;
+	bool getBool(MetaDataId id) const;
+
+	// MD_DATE / MD_TIME value as yyyymmddhhmmss digits ( 0 if not set ) : ordering matches chronological order
+	int64_t getDateKey(MetaDataId id) const;
 
 	MetaDataType getType(MetaDataId id) const;
 	MetaDataType getType(const std::string name) const;
@@ -191,6 +210,11 @@ public:
 
 	bool wasChanged() const;
 	void resetChangedFlag();
+
+	// Incremented by every value change of any list : sorted lists cached by FolderData are checked against it
+	static inline unsigned int getChangeCount() { return mChangeCount; }
+	// Change count of the last value change of this list
+	inline unsigned int getVersion() const { return mVersion; }
 	const void setDirty() 
 	{ 
 		mWasChanged = true; 
@@ -210,12 +234,50 @@ public:
 	Utils::Time::DateTime* getScrapeDate(const std::string& scraper);
 
 private:
+	void beginLoad(MetaDataListType type, SystemData* system);
+	void loadElement(const MetaDataDecl& mdd, std::string value, bool isAttribute, bool preloadMedias);
+	void loadUnknownElement(const std::string& name, const std::string& value, bool isElement);
+	void loadScrapeDate(const std::string& scraper, const std::string& date);
+
 	std::map<int, Utils::Time::DateTime> mScrapeDates;
 
 	std::string		mName;
 	MetaDataListType mType;
-	std::map<MetaDataId, std::string> mMap;
+
+	// Numbers & dates are stored typed when their text can be rebuilt exactly from the value,
+	// low-cardinality fields ( genre, developer, region... ) point to a shared string pool.
+	struct MetaDataValue
+	{
+		enum Kind : unsigned char { TEXT, INTERNED, INTEGER, REAL, DATE };
+
+		MetaDataValue() : kind(TEXT), integer(0) { }
+
+		Kind kind;
+		union
+		{
+			int64_t				integer;  // INTEGER, DATE ( yyyymmddhhmmss digits )
+			float				real;
+			const std::string*	interned;
+		};
+		std::string text;
+	};
+
+	// Sparse slot array : bit N of mPresent is set when MetaDataId N has a value. mValues is ordered by MetaDataId.
+	static const int PRESENT_WORDS = (MAX_METADATA_TYPES + 63) / 64;
+
+	uint64_t mPresent[PRESENT_WORDS];
+	std::vector<MetaDataValue> mValues;
+
+	int findSlot(MetaDataId id) const;
+	int getSlotPosition(MetaDataId id) const;
+	void encodeValue(MetaDataId id, const std::string& value, MetaDataValue& slot);
+	std::string valueToString(const MetaDataValue& slot) const;
+	bool valueEquals(const MetaDataValue& slot, const std::string& value) const;
+	bool slotEquals(const MetaDataValue& a, const MetaDataValue& b) const;
 	bool mWasChanged;
+
+	static std::atomic<unsigned int> mChangeCount;
+	unsigned int	mVersion;
 	SystemData*		mRelativeTo;
 
 	static std::vector<MetaDataDecl> mMetaDataDecls;
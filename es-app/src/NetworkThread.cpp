@@ -10,6 +10,7 @@
 #include "watchers/BatteryLevelWatcher.h"
 #include "watchers/NetworkStateWatcher.h"
 #include "RetroAchievements.h"
+#include "RomFolderWatcher.h"
 
 NetworkThread::NetworkThread(Window* window) : mWindow(window)
 {
@@ -18,6 +19,7 @@ NetworkThread::NetworkThread(Window* window) : mWindow(window)
 	mgr->RegisterComponent(&mCheckCheevosTokenComponent);
 	mgr->RegisterComponent(new BatteryLevelWatcher());
 	mgr->RegisterComponent(new NetworkStateWatcher());
+	mgr->RegisterComponent(new RomFolderWatcher(window));
 
 	if (ApiSystem::getInstance()->isScriptingSupported(ApiSystem::UPGRADE))
 		mgr->RegisterComponent(&mCheckUpdatesComponent);
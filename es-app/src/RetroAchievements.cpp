@@ -8,6 +8,7 @@
 #include "utils/ZipFile.h"
 #include "ApiSystem.h"
 #include "Log.h"
+#include "FileHashCache.h"
 #include <algorithm>
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/pointer.h>
@@ -605,12 +606,28 @@ std::string RetroAchievements::getCheevosHash( SystemData* system, const std::st
 		}
 	}
 
+	if (consoleId != RC_CONSOLE_ARCADE && (consoleId == 0 || consolesWithmd5hashes.find(consoleId) != consolesWithmd5hashes.cend()))
+		return ApiSystem::getInstance()->getMD5(fileName, fromZipContents);
+
+	// MD5 are cached by ApiSystem, rcheevos hashes are cached here
+	std::string kind = "cheevos" + std::to_string(consoleId) + (fromZipContents ? "z" : "");
+
+	std::string hash;
+	if (FileHashCache::getInstance()->find(kind, fileName, hash))
+		return hash;
+
+	hash = computeCheevosHash(consoleId, fileName, fromZipContents);
+	if (hash != "00000000000000000000000000000000")
+		FileHashCache::getInstance()->update(kind, fileName, hash);
+
+	return hash;
+}
+
+std::string RetroAchievements::computeCheevosHash(int consoleId, const std::string& fileName, bool fromZipContents)
+{
 	if (consoleId == RC_CONSOLE_ARCADE)
 		return getCheevosHashFromFile(consoleId, fileName);
 
-	if (consoleId == 0 || consolesWithmd5hashes.find(consoleId) != consolesWithmd5hashes.cend())
-		return ApiSystem::getInstance()->getMD5(fileName, fromZipContents);
-
 	std::string ext = Utils::String::toLower(Utils::FileSystem::getExtension(fileName));
 	if (ext != ".zip" && ext != ".7z")
 		return getCheevosHashFromFile(consoleId, fileName);
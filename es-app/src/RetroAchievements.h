@@ -224,4 +224,5 @@ public:
 
 private:
 	static std::string				getCheevosHashFromFile(int consoleId, const std::string& fileName);
+	static std::string				computeCheevosHash(int consoleId, const std::string& fileName, bool fromZipContents);
 };
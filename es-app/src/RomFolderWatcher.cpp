@@ -0,0 +1,389 @@
+#include "RomFolderWatcher.h"
+
+#include "views/ViewController.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "FileData.h"
+#include "ThreadedHasher.h"
+#include "scrapers/ThreadedScraper.h"
+#include "Settings.h"
+#include "Window.h"
+#include "Log.h"
+#include <SDL_timer.h>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#define ROMFOLDER_EVENTS		(IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_ONLYDIR)
+#endif
+
+// A system is updated once no event was received for ROMFOLDER_QUIET_DELAY ms
+#define ROMFOLDER_QUIET_DELAY	2000
+// Fingerprint check interval of the systems that can't be watched
+#define ROMFOLDER_POLL_DELAY	15000
+
+RomFolderWatcher::RomFolderWatcher(Window* window) : mWindow(window), mSystemsChanged(false), mInotify(-1)
+{
+
+}
+
+RomFolderWatcher::~RomFolderWatcher()
+{
+	for (auto system : mSystems)
+		delete system;
+
+#if defined(__linux__)
+	if (mInotify >= 0)
+		close(mInotify);
+#endif
+}
+
+bool RomFolderWatcher::enabled()
+{
+	return Settings::getInstance()->getBool("WatchRomFolders") && !Settings::ParseGamelistOnly();
+}
+
+void RomFolderWatcher::updateSystems()
+{
+	std::vector<WatchedSystem> systems;
+
+	for (auto system : SystemData::sSystemVector)
+	{
+		// Group views hold copies of the child root folders, store systems have no rom folder
+		if (system->isCollection() || system->isGroupSystem() || system->isGroupChildSystem() || !system->isGameSystem() || system->isStoreSystem() || system->getSystemEnvData() == nullptr)
+			continue;
+
+		WatchedSystem watched;
+		watched.name = system->getName();
+		watched.envData = *system->getSystemEnvData();
+		watched.showHidden = system->getShowHiddenFiles();
+		watched.polled = false;
+		watched.fingerprint = 0;
+		watched.nextPollTime = 0;
+		watched.rescan = false;
+		watched.lastEventTime = 0;
+		systems.push_back(watched);
+	}
+
+	std::unique_lock<std::mutex> lock(mLock);
+	mPendingSystems = systems;
+	mSystemsChanged = true;
+}
+
+bool RomFolderWatcher::check()
+{
+	int ticks = SDL_GetTicks();
+
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+		if (mSystemsChanged)
+		{
+			mSystemsChanged = false;
+			resetWatches();
+		}
+	}
+
+	readEvents(ticks);
+	pollSystems(ticks);
+	postChanges(ticks);
+
+	return false;
+}
+
+// mLock is held
+void RomFolderWatcher::resetWatches()
+{
+	mWatches.clear();
+
+	for (auto system : mSystems)
+		delete system;
+
+	mSystems.clear();
+
+#if defined(__linux__)
+	// Closing the descriptor drops all its watches
+	if (mInotify >= 0)
+		close(mInotify);
+
+	mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (mInotify < 0)
+		LOG(LogWarning) << "RomFolderWatcher : inotify is not available, rom folders are polled";
+#endif
+
+	int ticks = SDL_GetTicks();
+
+	for (auto& item : mPendingSystems)
+	{
+		WatchedSystem* system = new WatchedSystem(item);
+		system->polled = mInotify < 0;
+		mSystems.push_back(system);
+
+		if (!system->polled)
+			addWatches(system, system->envData.mStartPath);
+
+		if (system->polled)
+		{
+			system->fingerprint = SystemData::getFolderContentFingerprint(system->envData.mStartPath, system->name, system->showHidden, &system->envData);
+			system->nextPollTime = ticks + ROMFOLDER_POLL_DELAY;
+		}
+	}
+
+	mPendingSystems.clear();
+
+	LOG(LogDebug) << "RomFolderWatcher : " << mSystems.size() << " systems, " << mWatches.size() << " folders watched";
+}
+
+void RomFolderWatcher::addWatches(WatchedSystem* system, const std::string& path)
+{
+#if defined(__linux__)
+	std::vector<std::string> folders;
+	SystemData::getScannedFolders(path, system->name, system->showHidden, &system->envData, folders);
+
+	for (auto folder : folders)
+	{
+		int wd = inotify_add_watch(mInotify, folder.c_str(), ROMFOLDER_EVENTS);
+		if (wd >= 0)
+		{
+			mWatches[wd] = { system, folder };
+			continue;
+		}
+
+		// Usually fs.inotify.max_user_watches reached : fall back to polling for the whole system
+		LOG(LogWarning) << "RomFolderWatcher : unable to watch " << folder << " (" << strerror(errno) << "), polling " << system->name;
+
+		removeWatches(system, "");
+
+		system->polled = true;
+		system->fingerprint = SystemData::getFolderContentFingerprint(system->envData.mStartPath, system->name, system->showHidden, &system->envData);
+		system->nextPollTime = SDL_GetTicks() + ROMFOLDER_POLL_DELAY;
+
+		// Changes made while the folders were being watched would be lost
+		system->rescan = true;
+		system->lastEventTime = SDL_GetTicks();
+		return;
+	}
+#endif
+}
+
+// Empty path for all the folders of the system
+void RomFolderWatcher::removeWatches(WatchedSystem* system, const std::string& path)
+{
+#if defined(__linux__)
+	for (auto it = mWatches.begin(); it != mWatches.end(); )
+	{
+		const std::string& folder = it->second.path;
+
+		if (it->second.system == system && (path.empty() || folder == path || Utils::String::startsWith(folder, path + "/")))
+		{
+			inotify_rm_watch(mInotify, it->first);
+			it = mWatches.erase(it);
+		}
+		else
+			it++;
+	}
+#endif
+}
+
+void RomFolderWatcher::readEvents(int ticks)
+{
+#if defined(__linux__)
+	if (mInotify < 0)
+		return;
+
+	alignas(struct inotify_event) char buffer[16384];
+
+	while (true)
+	{
+		ssize_t length = read(mInotify, buffer, sizeof(buffer));
+		if (length <= 0) // EAGAIN : no more events
+			break;
+
+		const struct inotify_event* event;
+		for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(struct inotify_event) + event->len)
+		{
+			event = (const struct inotify_event*)ptr;
+
+			// The kernel queue was full & events were lost
+			if (event->mask & IN_Q_OVERFLOW)
+			{
+				LOG(LogWarning) << "RomFolderWatcher : event queue overflow, rescanning watched systems";
+
+				for (auto system : mSystems)
+				{
+					system->rescan = true;
+					system->lastEventTime = ticks;
+				}
+
+				continue;
+			}
+
+			auto it = mWatches.find(event->wd);
+			if (it == mWatches.cend())
+				continue;
+
+			if (event->mask & IN_IGNORED)
+			{
+				mWatches.erase(it);
+				continue;
+			}
+
+			WatchedSystem* system = it->second.system;
+			if (system->polled)
+				continue;
+
+			std::string path = event->len > 0 ? it->second.path + "/" + event->name : it->second.path;
+
+			if (event->mask & IN_ISDIR)
+			{
+				if (event->mask & (IN_CREATE | IN_MOVED_TO))
+				{
+					Utils::FileSystem::FileInfo fileInfo;
+					fileInfo.path = path;
+					fileInfo.hidden = Utils::FileSystem::isHidden(path);
+					fileInfo.directory = true;
+
+					// Files copied before the watch exists are found by the scan of the new folder
+					if (SystemData::isScannedFolder(fileInfo, system->name, system->showHidden, &system->envData))
+						addWatches(system, path);
+				}
+				else if (event->mask & IN_MOVED_FROM)
+					removeWatches(system, path);
+			}
+
+			// Both halves of a rename inside the system share a cookie
+			if (event->mask & IN_MOVED_FROM)
+				system->movedFrom[event->cookie] = path;
+			else if (event->mask & IN_MOVED_TO)
+			{
+				auto from = system->movedFrom.find(event->cookie);
+				if (from != system->movedFrom.cend())
+				{
+					std::string oldPath = from->second;
+					system->movedFrom.erase(from);
+
+					// Renamed again before being applied : keep the first path
+					auto previous = system->renamedPaths.find(oldPath);
+					if (previous != system->renamedPaths.cend())
+					{
+						oldPath = previous->second;
+						system->renamedPaths.erase(previous);
+					}
+
+					system->renamedPaths[path] = oldPath;
+				}
+			}
+
+			system->changedPaths.insert(path);
+			system->lastEventTime = ticks;
+		}
+	}
+#endif
+}
+
+void RomFolderWatcher::pollSystems(int ticks)
+{
+	for (auto system : mSystems)
+	{
+		if (!system->polled || ticks < system->nextPollTime)
+			continue;
+
+		size_t fingerprint = SystemData::getFolderContentFingerprint(system->envData.mStartPath, system->name, system->showHidden, &system->envData);
+		system->nextPollTime = SDL_GetTicks() + ROMFOLDER_POLL_DELAY;
+
+		if (fingerprint == system->fingerprint)
+			continue;
+
+		system->fingerprint = fingerprint;
+		system->rescan = true;
+		system->lastEventTime = ticks;
+	}
+}
+
+void RomFolderWatcher::postChanges(int ticks)
+{
+	// Scraper & hasher threads hold games that the changes could delete : keep the changes until they end
+	if (ThreadedScraper::isRunning() || ThreadedHasher::isRunning())
+		return;
+
+	for (auto system : mSystems)
+	{
+		if (!system->rescan && system->changedPaths.size() == 0)
+			continue;
+
+		if (ticks - system->lastEventTime < ROMFOLDER_QUIET_DELAY)
+			continue;
+
+		std::string name = system->name;
+		std::vector<std::string> paths(system->changedPaths.cbegin(), system->changedPaths.cend()); // Sorted : folders come before their content
+		std::map<std::string, std::string> renamedPaths = system->renamedPaths;
+		bool rescan = system->rescan;
+
+		system->changedPaths.clear();
+		system->renamedPaths.clear();
+		system->movedFrom.clear();
+		system->rescan = false;
+
+		LOG(LogDebug) << "RomFolderWatcher : " << name << (rescan ? " changed" : " " + std::to_string(paths.size()) + " paths changed");
+
+		// The folder scan & gamelist parsing of large systems would freeze the UI : only the merge is left to the UI thread
+		SystemData* source = nullptr;
+		if (rescan)
+		{
+			source = SystemData::loadSystem(name, false);
+			if (source == nullptr)
+				continue;
+		}
+
+		Window* window = mWindow;
+		mWindow->postToUiThread([window, name, paths, renamedPaths, source]() { applyChanges(window, name, paths, renamedPaths, source); });
+	}
+}
+
+void RomFolderWatcher::applyChanges(Window* window, const std::string& systemName, const std::vector<std::string>& paths, const std::map<std::string, std::string>& renamedPaths, SystemData* source)
+{
+	if (!ViewController::hasInstance())
+	{
+		delete source;
+		return;
+	}
+
+	// Started after the changes were posted : try again next frame
+	if (ThreadedScraper::isRunning() || ThreadedHasher::isRunning())
+	{
+		window->postToUiThread([window, systemName, paths, renamedPaths, source]() { applyChanges(window, systemName, paths, renamedPaths, source); });
+		return;
+	}
+
+	// The system may have been deleted by a full reload
+	SystemData* system = SystemData::getSystem(systemName);
+	if (system == nullptr || system->isCollection())
+	{
+		delete source;
+		return;
+	}
+
+	std::vector<FileData*> addedGames;
+	std::vector<FileData*> changedGames;
+	std::vector<FileData*> removedFiles;
+
+	if (source != nullptr)
+	{
+		system->mergeContent(source, addedGames, changedGames, removedFiles);
+		delete source;
+
+		system->updateContentFingerprint();
+	}
+	else
+	{
+		system->applyFolderChanges(paths, renamedPaths, addedGames, changedGames, removedFiles);
+
+		// Also when nothing was added : files that aren't roms change the folder fingerprint too
+		system->updateContentFingerprint();
+	}
+
+	if (addedGames.size() > 0 || changedGames.size() > 0 || removedFiles.size() > 0)
+		ViewController::applyGameChanges(system, addedGames, changedGames, removedFiles);
+}
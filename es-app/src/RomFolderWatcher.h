@@ -0,0 +1,81 @@
+#pragma once
+#ifndef ES_APP_ROM_FOLDER_WATCHER_H
+#define ES_APP_ROM_FOLDER_WATCHER_H
+
+#include "watchers/WatchersManager.h"
+#include "SystemData.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+
+class Window;
+
+//
+// Follows the rom folders of the loaded systems & applies added, removed or renamed roms to the live game lists.
+// inotify is used when available. Systems that can't be watched ( other platforms, watch limit reached ) are polled with their folder fingerprint.
+// Bursts of events are coalesced : a system is updated once its folders stay quiet for a moment.
+//
+class RomFolderWatcher : public IWatcher
+{
+public:
+	RomFolderWatcher(Window* window);
+	~RomFolderWatcher();
+
+	// To call on the UI thread each time the systems are loaded
+	void updateSystems();
+
+protected:
+	bool enabled() override;
+	int  updateTime() override { return 500; }
+	int  initialUpdateTime() override { return 0; }
+	bool check() override;
+
+private:
+	struct WatchedSystem
+	{
+		std::string name;
+		SystemEnvironmentData envData; // Copy : full reloads delete the systems
+		bool showHidden;
+
+		bool polled;
+		size_t fingerprint;
+		int nextPollTime;
+
+		std::set<std::string> changedPaths;
+		std::map<std::string, std::string> renamedPaths; // New path -> old path
+		std::map<uint32_t, std::string> movedFrom; // inotify cookie -> path waiting for its IN_MOVED_TO
+		bool rescan;
+		int lastEventTime;
+	};
+
+	struct Watch
+	{
+		WatchedSystem* system;
+		std::string path;
+	};
+
+	void resetWatches();
+	void addWatches(WatchedSystem* system, const std::string& path);
+	void removeWatches(WatchedSystem* system, const std::string& path);
+	void readEvents(int ticks);
+	void pollSystems(int ticks);
+	void postChanges(int ticks);
+
+	// source : system loaded on the watcher thread when the whole system is rescanned, deleted once merged
+	static void applyChanges(Window* window, const std::string& systemName, const std::vector<std::string>& paths, const std::map<std::string, std::string>& renamedPaths, SystemData* source);
+
+	Window* mWindow;
+
+	std::mutex mLock; // mPendingSystems
+	std::vector<WatchedSystem> mPendingSystems;
+	bool mSystemsChanged;
+
+	std::vector<WatchedSystem*> mSystems;
+	std::map<int, Watch> mWatches;
+	int mInotify;
+};
+
+#endif // ES_APP_ROM_FOLDER_WATCHER_H
@@ -3,6 +3,7 @@
 #include "SystemConf.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/ThreadPool.h"
+#include "utils/WorkStealingPool.h"
 #include "CollectionSystemManager.h"
 #include "FileFilterIndex.h"
 #include "FileSorts.h"
@@ -26,6 +27,7 @@
 #include "Paths.h"
 #include "SystemRandomPlaylist.h"
 #include "PlatformId.h"
+#include "MameNames.h"
 #include <map>
 #include <set>
 #include <vector>
@@ -90,6 +92,10 @@ static std::map<std::string, std::function<BindableProperty(SystemData*)>> prope
 };
 
 VectorEx<SystemData*> SystemData::sSystemVector;
+
+std::map<std::string, SystemData::EmptySystem> SystemData::sEmptySystems;
+std::mutex SystemData::sEmptySystemsLock;
+bool SystemData::sHasDetachedFiles = false;
 bool SystemData::IsManufacturerSupported = false;
 
 std::string normalizeGameNameForEA(const std::string& name) {
@@ -115,6 +121,8 @@ SystemData::SystemData(const SystemMetadata& meta, SystemEnvironmentData* envDat
 	mIsCheevosSupported = -1;
 	mIsGroupSystem = groupedSystem;
 	mGameListHash = 0;
+	mFolderFingerprint = 0;
+	mGamelistFingerprint = 0;
 	mGameCountInfo = nullptr;
 	mSortId = Settings::getInstance()->getInt(getName() + ".sort");
 	mGridSizeOverride = Vector2f(0, 0);
@@ -140,7 +148,15 @@ SystemData::SystemData(const SystemMetadata& meta, SystemEnvironmentData* envDat
 
 		if (!Settings::ParseGamelistOnly())
 		{
-			populateFolder(mRootFolder, fileMap);
+			{
+				StopWatch stopWatch("populateFolder - " + getName() + " :", LogDebug);
+
+				// Subfolders are scanned in parallel : a single huge system no longer bounds the startup time
+				if (std::thread::hardware_concurrency() > 1 && Settings::ThreadedFolderScan())
+					populateFolderThreaded(mRootFolder, fileMap);
+				else
+					populateFolder(mRootFolder, fileMap);
+			}
 
 			if (!UIModeController::LoadEmptySystems())
 			{
@@ -153,7 +169,10 @@ SystemData::SystemData(const SystemMetadata& meta, SystemEnvironmentData* envDat
 		}
 
 		if (!Settings::IgnoreGamelist())
+		{
+			mGamelistFingerprint = getGamelistFingerprint();
 			parseGamelist(this, fileMap);
+		}
 
 		if (Settings::RemoveMultiDiskContent())
 			removeMultiDiskContent(fileMap);
@@ -187,6 +206,9 @@ SystemData::~SystemData()
 	if (mBindableRandom)
 		delete mBindableRandom;
 
+	for (auto file : mDetachedFiles)
+		delete file;
+
 	if (mRootFolder)
 		delete mRootFolder;
 
@@ -472,7 +494,90 @@ void SystemData::setIsGameSystemStatus()
 	mIsGameSystem = (mMetadata.name != "retropie" && mMetadata.name != "lumaca");
 }
 
-void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap)
+SystemData::FolderScanOptions SystemData::getFolderScanOptions()
+{
+	FolderScanOptions options;
+	options.showHidden = Settings::ShowHiddenFiles();
+	options.preloadMedias = Settings::PreloadMedias() && (!mHidden || Settings::HiddenSystemsShowGames());
+
+	auto shv = Settings::getInstance()->getString(getName() + ".ShowHiddenFiles");
+	if (shv == "1") options.showHidden = true;
+	else if (shv == "0") options.showHidden = false;
+
+	return options;
+}
+
+FileData* SystemData::createFolderEntry(const Utils::FileSystem::FileInfo& fileInfo, const FolderScanOptions& options)
+{
+	const std::string& filePath = fileInfo.path;
+
+	// skip hidden files and folders
+	if (!options.showHidden && fileInfo.hidden)
+		return nullptr;
+
+	//this is a little complicated because we allow a list of extensions to be defined (delimited with a space)
+	//we first get the extension of the file itself:
+	std::string extension = Utils::String::toLower(Utils::FileSystem::getExtension(filePath));
+
+	//fyi, folders *can* also match the extension and be added as games - this is mostly just to support higan
+	//see issue #75: https://github.com/Aloshi/EmulationStation/issues/75
+
+	// preventing new arcade assets to be added
+	if (mEnvData->isValidExtension(extension) && !isArcadeAsset(filePath, mEnvData))
+		return new FileData(GAME, filePath, this);
+
+	//add directories that also do not match an extension as folders
+	if (!fileInfo.directory)
+		return nullptr;
+
+	std::string fn = Utils::String::toLower(Utils::FileSystem::getFileName(filePath));
+
+	if (options.preloadMedias)
+	{
+		// Recurse list files in medias folder, just to let OS build filesystem cache 
+		if (fn == "media" || fn == "medias")
+		{
+			Utils::FileSystem::getDirContent(filePath, true);
+			return nullptr;
+		}
+
+		// List files in folder, just to get OS build filesystem cache 
+		if (fn == "manuals" || fn == "images" || fn == "videos" || Utils::String::startsWith(fn, "downloaded_"))
+		{
+			Utils::FileSystem::getDirectoryFiles(filePath);
+			return nullptr;
+		}
+	}
+
+	if (isExcludedFolder(mMetadata.name, fn))
+		return nullptr;
+
+	return new FolderData(filePath, this);
+}
+
+// fileName is expected lower case
+bool SystemData::isExcludedFolder(const std::string& systemName, const std::string& fileName)
+{
+	// Never look in "artwork", reserved for mame roms artwork
+	if (fileName == "artwork")
+		return true;
+
+	// Don't loose time looking in downloaded_images, downloaded_videos & media folders
+	if (fileName == "media" || fileName == "medias" || fileName == "images" || fileName == "manuals" || fileName == "videos" || fileName == "assets" || Utils::String::startsWith(fileName, "downloaded_") || Utils::String::startsWith(fileName, "."))
+		return true;
+
+	// Hardcoded optimisation : WiiU has so many files in content & meta directories
+	if (systemName == "wiiu" && (fileName == "content" || fileName == "meta"))
+		return true;
+
+	// Hardcoded optimisation : vpinball 'roms' subfolder must be excluded
+	if (systemName == "vpinball" && fileName == "roms")
+		return true;
+
+	return false;
+}
+
+void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap, bool updateFingerprint)
 {
 	const std::string& folderPath = folder->getPath();
 
@@ -491,101 +596,631 @@ void SystemData::populateFolder(FolderData* folder, std::unordered_map<std::stri
 		}
 	}
 	*/
-	std::string filePath;
-	std::string extension;
-	bool isGame;
-	bool showHidden = Settings::ShowHiddenFiles();
-	bool preloadMedias = Settings::PreloadMedias();
-
-	auto shv = Settings::getInstance()->getString(getName() + ".ShowHiddenFiles");
-	if (shv == "1") showHidden = true;
-	else if (shv == "0") showHidden = false;
+	FolderScanOptions options = getFolderScanOptions();
 
 	Utils::FileSystem::fileList dirContent = Utils::FileSystem::getDirectoryFiles(folderPath);
+	if (updateFingerprint)
+		mFolderFingerprint += getFolderFingerprint(folderPath, dirContent.size());
+
 	for (auto fileInfo : dirContent)
 	{
-		filePath = fileInfo.path;
+		FileData* entry = createFolderEntry(fileInfo, options);
+		if (entry == nullptr)
+			continue;
 
-		// skip hidden files and folders
-		if(!showHidden && fileInfo.hidden)
+		if (entry->getType() == GAME)
+		{
+			folder->addChild(entry);
+			fileMap[entry->getPath()] = entry;
 			continue;
+		}
+
+		FolderData* newFolder = (FolderData*)entry;
+		populateFolder(newFolder, fileMap, updateFingerprint);
+
+		//ignore folders that do not contain games
+		if(newFolder->getChildren().size() == 0)
+			delete newFolder;
+		else 
+		{
+			const std::string& key = newFolder->getPath();
+			if (fileMap.find(key) == fileMap.end())
+			{
+				folder->addChild(newFolder);
+				fileMap[key] = newFolder;
+			}
+		}
+	}
+}
 
-		//this is a little complicated because we allow a list of extensions to be defined (delimited with a space)
-		//we first get the extension of the file itself:
-		extension = Utils::String::toLower(Utils::FileSystem::getExtension(filePath));
+// Result of the scan of one directory : entries are kept in directory order, subfolders keep their own scan result
+struct SystemData::FolderScanTask
+{
+	FolderScanTask(FolderData* data) : folder(data), fingerprint(0) { }
+
+	~FolderScanTask()
+	{
+		for (auto subFolder : subFolders)
+			delete subFolder;
+	}
+
+	FolderData* folder;
+	size_t fingerprint;
+
+	std::vector<FileData*> entries;
+	std::vector<FolderScanTask*> subFolders;
+};
+
+void SystemData::scanFolderTask(FolderScanTask* task, const FolderScanOptions& options, Utils::WorkStealingPool* pool, Utils::WorkStealingPool::TaskGroup* group)
+{
+	Utils::FileSystem::fileList dirContent = Utils::FileSystem::getDirectoryFiles(task->folder->getPath());
+	task->fingerprint = getFolderFingerprint(task->folder->getPath(), dirContent.size());
+	for (auto fileInfo : dirContent)
+	{
+		FileData* entry = createFolderEntry(fileInfo, options);
+		if (entry == nullptr)
+			continue;
+
+		task->entries.push_back(entry);
+
+		if (entry->getType() == GAME)
+			continue;
+
+		FolderScanTask* subTask = new FolderScanTask((FolderData*)entry);
+		task->subFolders.push_back(subTask);
+
+		pool->queueWorkItem(*group, [this, subTask, &options, pool, group] { scanFolderTask(subTask, options, pool, group); });
+	}
+}
+
+// Rebuilds the tree in the same order as the serial scan would, so results don't depend on thread scheduling
+void SystemData::mergeFolderTask(FolderScanTask* task, std::unordered_map<std::string, FileData*>& fileMap)
+{
+	mFolderFingerprint += task->fingerprint;
 
-		//fyi, folders *can* also match the extension and be added as games - this is mostly just to support higan
-		//see issue #75: https://github.com/Aloshi/EmulationStation/issues/75
+	auto subFolder = task->subFolders.cbegin();
 
-		isGame = false;
-		if(mEnvData->isValidExtension(extension))
+	for (auto entry : task->entries)
+	{
+		if (entry->getType() == GAME)
 		{
-			FileData* newGame = new FileData(GAME, filePath, this);
+			task->folder->addChild(entry);
+			fileMap[entry->getPath()] = entry;
+			continue;
+		}
 
-			// preventing new arcade assets to be added
-			if(!newGame->isArcadeAsset())
+		FolderData* newFolder = (*subFolder)->folder;
+		mergeFolderTask(*subFolder, fileMap);
+		subFolder++;
+
+		//ignore folders that do not contain games
+		if (newFolder->getChildren().size() == 0)
+			delete newFolder;
+		else
+		{
+			const std::string& key = newFolder->getPath();
+			if (fileMap.find(key) == fileMap.end())
 			{
-				folder->addChild(newGame);
-				fileMap[filePath] = newGame;
-				isGame = true;
+				task->folder->addChild(newFolder);
+				fileMap[key] = newFolder;
 			}
 		}
+	}
+}
 
-		//add directories that also do not match an extension as folders
-		if(!isGame && fileInfo.directory)
-		{
-			std::string fn = Utils::String::toLower(Utils::FileSystem::getFileName(filePath));
+void SystemData::populateFolderThreaded(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap)
+{
+	if (!Utils::FileSystem::isDirectory(folder->getPath()))
+		return;
+
+	FolderScanOptions options = getFolderScanOptions();
+
+	Utils::WorkStealingPool* pool = Utils::WorkStealingPool::getInstance();
+	Utils::WorkStealingPool::TaskGroup group;
+
+	FolderScanTask root(folder);
+	scanFolderTask(&root, options, pool, &group);
+	pool->wait(group);
+
+	mergeFolderTask(&root, fileMap);
+}
+
+// Folder modification times change when entries are added, removed or renamed : one stat per scanned folder is enough to detect new or deleted roms
+// Times only have a one second resolution, the entry count catches roms copied during the second of the scan
+size_t SystemData::getFolderFingerprint(const std::string& path, size_t entryCount)
+{
+	size_t hash = std::hash<std::string>()(path);
+	size_t time = (size_t)Utils::FileSystem::getFileModificationDate(path).getTime();
+
+	// Summed by the scans : must not depend on folder order
+	return hash ^ (time * 0x9E3779B1 + entryCount * 0x85EBCA6B + (hash << 6) + (hash >> 2));
+}
+
+// Bios & device files of arcade systems are never games, folders named after them are looked into
+bool SystemData::isArcadeAsset(const std::string& path, SystemEnvironmentData* envData)
+{
+	if (envData->mPlatformIds.find(PlatformIds::ARCADE) == envData->mPlatformIds.cend() && envData->mPlatformIds.find(PlatformIds::NEOGEO) == envData->mPlatformIds.cend())
+		return false;
+
+	return MameNames::getInstance()->isBiosOrDevice(Utils::FileSystem::getStem(path));
+}
+
+// Same folders as createFolderEntry, without creating any FileData
+bool SystemData::isScannedFolder(const Utils::FileSystem::FileInfo& fileInfo, const std::string& systemName, bool showHidden, SystemEnvironmentData* envData)
+{
+	if (!fileInfo.directory || (!showHidden && fileInfo.hidden))
+		return false;
+
+	if (envData != nullptr && envData->isValidExtension(Utils::String::toLower(Utils::FileSystem::getExtension(fileInfo.path))) && !isArcadeAsset(fileInfo.path, envData))
+		return false;
+
+	return !isExcludedFolder(systemName, Utils::String::toLower(Utils::FileSystem::getFileName(fileInfo.path)));
+}
+
+void SystemData::getScannedFolders(const std::string& path, const std::string& systemName, bool showHidden, SystemEnvironmentData* envData, std::vector<std::string>& folders)
+{
+	if (!Utils::FileSystem::isDirectory(path))
+		return;
+
+	folders.push_back(path);
+
+	for (auto fileInfo : Utils::FileSystem::getDirectoryFiles(path))
+		if (isScannedFolder(fileInfo, systemName, showHidden, envData))
+			getScannedFolders(fileInfo.path, systemName, showHidden, envData, folders);
+}
+
+size_t SystemData::getFolderContentFingerprint(const std::string& path, const std::string& systemName, bool showHidden, SystemEnvironmentData* envData)
+{
+	if (!Utils::FileSystem::isDirectory(path))
+		return 0;
+
+	Utils::FileSystem::fileList dirContent = Utils::FileSystem::getDirectoryFiles(path);
+
+	size_t ret = getFolderFingerprint(path, dirContent.size());
+
+	for (auto fileInfo : dirContent)
+		if (isScannedFolder(fileInfo, systemName, showHidden, envData))
+			ret += getFolderContentFingerprint(fileInfo.path, systemName, showHidden, envData);
+
+	return ret;
+}
+
+size_t SystemData::getGamelistFingerprint()
+{
+	std::string path = getGamelistPath(false);
+	if (!Utils::FileSystem::exists(path))
+		return 0;
+
+	size_t size = (size_t)Utils::FileSystem::getFileSize(path);
+	size_t time = (size_t)Utils::FileSystem::getFileModificationDate(path).getTime();
+
+	return (size * 0x9E3779B1) ^ time;
+}
+
+bool SystemData::hasFolderContentChanged()
+{
+	if (mIsCollectionSystem || !mIsGameSystem || mEnvData == nullptr || Settings::ParseGamelistOnly())
+		return false;
+
+	return getFolderContentFingerprint(mEnvData->mStartPath, getName(), getFolderScanOptions().showHidden, mEnvData) != mFolderFingerprint;
+}
+
+bool SystemData::hasGamelistChanged()
+{
+	if (mIsCollectionSystem || !mIsGameSystem || Settings::IgnoreGamelist())
+		return false;
+
+	return getGamelistFingerprint() != mGamelistFingerprint;
+}
+
+void SystemData::updateContentFingerprint()
+{
+	if (mIsCollectionSystem || !mIsGameSystem || mEnvData == nullptr)
+		return;
+
+	if (!Settings::ParseGamelistOnly())
+		mFolderFingerprint = getFolderContentFingerprint(mEnvData->mStartPath, getName(), getFolderScanOptions().showHidden, mEnvData);
+
+	if (!Settings::IgnoreGamelist())
+		mGamelistFingerprint = getGamelistFingerprint();
+}
+
+// Games added to a system that had none make it appear : only a full reload can do that
+bool SystemData::hasEmptySystemChanged()
+{
+	std::unique_lock<std::mutex> lock(sEmptySystemsLock);
+
+	for (auto& item : sEmptySystems)
+		if (getFolderContentFingerprint(item.second.path, item.first, item.second.showHidden, nullptr) != item.second.fingerprint)
+			return true;
+
+	return false;
+}
+
+FolderData* SystemData::getOrCreateFolder(const std::string& path, SystemData* source, std::unordered_map<std::string, FileData*>& fileMap)
+{
+	auto it = fileMap.find(path);
+	if (it != fileMap.cend())
+		return it->second->getType() == FOLDER ? (FolderData*)it->second : nullptr;
+
+	// Games outside of the rom folder are children of the root, as findOrCreateFile does
+	const std::string& rootPath = mRootFolder->getPath();
+	if (!Utils::String::startsWith(path, rootPath + "/"))
+		return mRootFolder;
+
+	FolderData* parent = getOrCreateFolder(Utils::FileSystem::getParent(path), source, fileMap);
+	if (parent == nullptr)
+		return nullptr;
+
+	FolderData* folder = new FolderData(path, this);
 
-			// Never look in "artwork", reserved for mame roms artwork
-			if (fn == "artwork")
+	FileData* sourceFolder = source == nullptr ? nullptr : source->getRootFolder()->FindByPath(path);
+	if (sourceFolder != nullptr)
+		folder->setMetadata(sourceFolder->getMetadata());
+
+	folder->getMetadata().resetChangedFlag();
+
+	parent->addChild(folder);
+	fileMap[path] = folder;
+	return folder;
+}
+
+bool SystemData::mergeContent(SystemData* source, std::vector<FileData*>& addedGames, std::vector<FileData*>& changedGames, std::vector<FileData*>& removedFiles)
+{
+	std::unordered_map<std::string, FileData*> fileMap;
+	fileMap[mRootFolder->getPath()] = mRootFolder;
+
+	for (auto file : mRootFolder->getFilesRecursive(GAME | FOLDER))
+		fileMap[file->getPath()] = file;
+
+	std::unordered_set<std::string> sourcePaths;
+
+	for (auto sourceGame : source->getRootFolder()->getFilesRecursive(GAME))
+	{
+		const std::string& path = sourceGame->getPath();
+		sourcePaths.insert(path);
+
+		auto it = fileMap.find(path);
+		if (it == fileMap.cend())
+		{
+			FolderData* parent = getOrCreateFolder(Utils::FileSystem::getParent(path), source, fileMap);
+			if (parent == nullptr)
 				continue;
 
-			if (preloadMedias && (!mHidden || Settings::HiddenSystemsShowGames()))
+			FileData* game = new FileData(GAME, path, this);
+			game->setMetadata(sourceGame->getMetadata());
+			game->getMetadata().resetChangedFlag();
+
+			parent->addChild(game);
+			fileMap[path] = game;
+
+			addToIndex(game);
+			addedGames.push_back(game);
+			continue;
+		}
+
+		FileData* game = it->second;
+
+		// Unsaved changes made in ES win over the gamelist
+		if (game->getType() != GAME || game->getMetadata().wasChanged() || game->getMetadata().hasSameValues(sourceGame->getMetadata()))
+			continue;
+
+		removeFromIndex(game);
+		game->setMetadata(sourceGame->getMetadata());
+		game->getMetadata().resetChangedFlag();
+		addToIndex(game);
+
+		changedGames.push_back(game);
+	}
+
+	for (auto game : mRootFolder->getFilesRecursive(GAME))
+	{
+		if (sourcePaths.find(game->getPath()) != sourcePaths.cend())
+			continue;
+
+		FolderData* parent = game->getParent();
+		if (parent != nullptr)
+			parent->removeChild(game);
+
+		removeFromIndex(game);
+		removedFiles.push_back(game);
+
+		// Folders left without games disappear, as they do at load time
+		while (parent != nullptr && parent != mRootFolder && parent->getChildren().size() == 0)
+		{
+			FolderData* folder = parent;
+			parent = folder->getParent();
+
+			if (parent != nullptr)
+				parent->removeChild(folder);
+
+			removedFiles.push_back(folder);
+		}
+	}
+
+	return addedGames.size() > 0 || changedGames.size() > 0 || removedFiles.size() > 0;
+}
+
+bool SystemData::applyFolderChanges(const std::vector<std::string>& paths, const std::map<std::string, std::string>& renamedPaths, std::vector<FileData*>& addedGames, std::vector<FileData*>& changedGames, std::vector<FileData*>& removedFiles)
+{
+	std::unordered_map<std::string, FileData*> fileMap;
+	fileMap[mRootFolder->getPath()] = mRootFolder;
+
+	for (auto file : mRootFolder->getFilesRecursive(GAME | FOLDER))
+		fileMap[file->getPath()] = file;
+
+	// Folders left without games disappear, as they do at load time
+	auto removeEmptyFolders = [this, &fileMap, &removedFiles](FolderData* parent)
+	{
+		while (parent != nullptr && parent != mRootFolder && parent->getChildren().size() == 0)
+		{
+			FolderData* folder = parent;
+			parent = folder->getParent();
+
+			if (parent != nullptr)
+				parent->removeChild(folder);
+
+			fileMap.erase(folder->getPath());
+			removedFiles.push_back(folder);
+		}
+	};
+
+	// Detaches a file from the tree, with the folders it leaves empty
+	auto removeFile = [this, &fileMap, &removedFiles, &removeEmptyFolders](FileData* file)
+	{
+		FolderData* parent = file->getParent();
+
+		if (file->getType() == GAME)
+			removeFromIndex(file);
+		else
+		{
+			for (auto child : ((FolderData*)file)->getFilesRecursive(GAME | FOLDER))
 			{
-				// Recurse list files in medias folder, just to let OS build filesystem cache 
-				if (fn == "media" || fn == "medias")
-				{
-					Utils::FileSystem::getDirContent(filePath, true);
-					continue;
-				}
+				if (child->getType() == GAME)
+					removeFromIndex(child);
 
-				// List files in folder, just to get OS build filesystem cache 
-				if (fn == "manuals" || fn == "images" || fn == "videos" || Utils::String::startsWith(fn, "downloaded_"))
-				{
-					Utils::FileSystem::getDirectoryFiles(filePath);
-					continue;
-				}
+				fileMap.erase(child->getPath());
 			}
+		}
 
-			// Don't loose time looking in downloaded_images, downloaded_videos & media folders
-			if (fn == "media" || fn == "medias" || fn == "images" || fn == "manuals" || fn == "videos" || fn == "assets" || Utils::String::startsWith(fn, "downloaded_") || Utils::String::startsWith(fn, "."))
-				continue;
-			
-			// Hardcoded optimisation : WiiU has so many files in content & meta directories
-			if (mMetadata.name == "wiiu" && (fn == "content" || fn == "meta"))
-				continue;
+		if (parent != nullptr)
+			parent->removeChild(file);
+
+		fileMap.erase(file->getPath());
+		removedFiles.push_back(file);
+
+		removeEmptyFolders(parent);
+	};
+
+	const std::string rootPath = mRootFolder->getPath() + "/";
+	FolderScanOptions options = getFolderScanOptions();
+
+	// Every folder between the root & the file must be one populateFolder looks into
+	auto isScannedPath = [this, &rootPath, &options](const std::string& path)
+	{
+		if (!Utils::String::startsWith(path, rootPath))
+			return false;
+
+		for (std::string parentPath = Utils::FileSystem::getParent(path); parentPath.size() >= rootPath.size(); parentPath = Utils::FileSystem::getParent(parentPath))
+		{
+			Utils::FileSystem::FileInfo parentInfo;
+			parentInfo.path = parentPath;
+			parentInfo.hidden = Utils::FileSystem::isHidden(parentPath);
+			parentInfo.directory = true;
+
+			if (!isScannedFolder(parentInfo, getName(), options.showHidden, mEnvData))
+				return false;
+		}
+
+		return true;
+	};
+
+	// Renamed files are moved with their unsaved metadata ( play count, favorite... ) instead of being deleted & created again
+	for (auto renamed : renamedPaths)
+	{
+		const std::string& path = renamed.first;
+		const std::string& oldPath = renamed.second;
+
+		auto it = fileMap.find(oldPath);
+		if (it == fileMap.cend() || it->second == mRootFolder || fileMap.find(path) != fileMap.cend())
+			continue;
+
+		if (Utils::FileSystem::exists(oldPath) || !Utils::FileSystem::exists(path) || !isScannedPath(path))
+			continue;
+
+		FileData* file = it->second;
+
+		// The new name must give the same kind of entry, else the old one is removed & the new one added
+		Utils::FileSystem::FileInfo fileInfo;
+		fileInfo.path = path;
+		fileInfo.hidden = Utils::FileSystem::isHidden(path);
+		fileInfo.directory = Utils::FileSystem::isDirectory(path);
+
+		FileData* entry = createFolderEntry(fileInfo, options);
+		bool sameType = entry != nullptr && entry->getType() == file->getType();
+		delete entry;
+
+		if (!sameType)
+			continue;
+
+		FolderData* parent = getOrCreateFolder(Utils::FileSystem::getParent(path), nullptr, fileMap);
+		if (parent == nullptr)
+			continue;
+
+		std::vector<FileData*> movedFiles = { file };
+		if (file->getType() == FOLDER)
+			for (auto child : ((FolderData*)file)->getFilesRecursive(GAME | FOLDER))
+				movedFiles.push_back(child);
+
+		for (auto moved : movedFiles)
+		{
+			std::string movedPath = path + moved->getPath().substr(oldPath.size());
+			bool defaultName = moved->getName() == moved->getDisplayName();
+
+			fileMap.erase(moved->getPath());
+			moved->setPath(movedPath);
+			fileMap[movedPath] = moved;
+
+			// Names that were never scraped follow the file name
+			if (defaultName)
+				moved->getMetadata().set(MetaDataId::Name, moved->getDisplayName());
 
-			// Hardcoded optimisation : vpinball 'roms' subfolder must be excluded
-			if (mMetadata.name == "vpinball" && fn == "roms")
-				continue;			
+			// Written back to the gamelist under the new path
+			moved->getMetadata().setDirty();
 
-			FolderData* newFolder = new FolderData(filePath, this);
-			populateFolder(newFolder, fileMap);
+			if (moved->getType() == GAME)
+				changedGames.push_back(moved);
+		}
+
+		FolderData* oldParent = file->getParent();
+		if (oldParent != parent)
+		{
+			if (oldParent != nullptr)
+				oldParent->removeChild(file);
+
+			parent->addChild(file);
+			removeEmptyFolders(oldParent);
+		}
+	}
+
+	std::unordered_map<std::string, FileData*> addedMap;
+
+	for (auto path : paths)
+	{
+		bool exists = Utils::FileSystem::exists(path);
+
+		auto it = fileMap.find(path);
+		if (it != fileMap.cend())
+		{
+			if (!exists && it->second != mRootFolder)
+				removeFile(it->second);
+
+			continue;
+		}
 
-			//ignore folders that do not contain games
-			if(newFolder->getChildren().size() == 0)
-				delete newFolder;
-			else 
+		if (!exists || !isScannedPath(path))
+			continue;
+
+		Utils::FileSystem::FileInfo fileInfo;
+		fileInfo.path = path;
+		fileInfo.hidden = Utils::FileSystem::isHidden(path);
+		fileInfo.directory = Utils::FileSystem::isDirectory(path);
+
+		FileData* entry = createFolderEntry(fileInfo, options);
+		if (entry == nullptr)
+			continue;
+
+		if (entry->getType() == FOLDER)
+		{
+			// The folder fingerprint is computed again once the changes are applied
+			populateFolder((FolderData*)entry, addedMap, false);
+
+			if (((FolderData*)entry)->getChildren().size() == 0)
 			{
-				const std::string& key = newFolder->getPath();
-				if (fileMap.find(key) == fileMap.end())
-				{
-					folder->addChild(newFolder);
-					fileMap[key] = newFolder;
-				}
+				delete entry;
+				continue;
 			}
 		}
+
+		FolderData* parent = getOrCreateFolder(Utils::FileSystem::getParent(path), nullptr, fileMap);
+		if (parent == nullptr)
+		{
+			delete entry;
+			continue;
+		}
+
+		parent->addChild(entry);
+		fileMap[path] = entry;
+		addedMap[path] = entry;
+
+		if (entry->getType() == GAME)
+		{
+			addedGames.push_back(entry);
+			continue;
+		}
+
+		for (auto file : ((FolderData*)entry)->getFilesRecursive(GAME | FOLDER))
+		{
+			fileMap[file->getPath()] = file;
+
+			if (file->getType() == GAME)
+				addedGames.push_back(file);
+		}
 	}
+
+	// Roms deleted & copied back ( rsync, temporary files renamed by Samba ) get their scraped data back
+	if (!Settings::IgnoreGamelist())
+		loadGamelistMetadata(this, addedMap);
+
+	if (Settings::RemoveMultiDiskContent() && (mEnvData->isValidExtension(".cue") || mEnvData->isValidExtension(".ccd") || mEnvData->isValidExtension(".gdi") || mEnvData->isValidExtension(".m3u")))
+	{
+		// Discs referenced by added playlists, or by the playlists next to added discs
+		std::unordered_set<FileData*> playlists;
+		for (auto game : addedGames)
+		{
+			if (game->hasContentFiles())
+				playlists.insert(game);
+
+			if (game->getParent() != nullptr)
+				for (auto sibling : game->getParent()->getChildren())
+					if (sibling->getType() == GAME && sibling->hasContentFiles())
+						playlists.insert(sibling);
+		}
+
+		std::unordered_set<std::string> contentFiles;
+		for (auto playlist : playlists)
+			for (auto file : playlist->getContentFiles())
+				contentFiles.insert(file);
+
+		for (auto file : contentFiles)
+		{
+			auto it = fileMap.find(file);
+			if (it == fileMap.cend() || it->second->getType() != GAME)
+				continue;
+
+			FileData* game = it->second;
+
+			auto added = std::find(addedGames.begin(), addedGames.end(), game);
+			if (added != addedGames.end())
+				addedGames.erase(added);
+
+			auto moved = std::find(changedGames.begin(), changedGames.end(), game);
+			if (moved != changedGames.end())
+				changedGames.erase(moved);
+
+			removeFile(game);
+		}
+	}
+
+	for (auto game : addedGames)
+		addToIndex(game);
+
+	return addedGames.size() > 0 || changedGames.size() > 0 || removedFiles.size() > 0;
+}
+
+void SystemData::addDetachedFiles(const std::vector<FileData*>& files)
+{
+	if (files.size() == 0)
+		return;
+
+	mDetachedFiles.insert(mDetachedFiles.end(), files.cbegin(), files.cend());
+	sHasDetachedFiles = true;
+}
+
+void SystemData::deleteDetachedFiles()
+{
+	if (!sHasDetachedFiles)
+		return;
+
+	for (auto system : sSystemVector)
+	{
+		for (auto file : system->mDetachedFiles)
+			delete file;
+
+		system->mDetachedFiles.clear();
+	}
+
+	sHasDetachedFiles = false;
 }
 
 FileFilterIndex* SystemData::getIndex(bool createIndex)
@@ -1031,6 +1666,11 @@ void SystemData::loadAdditionnalConfig(pugi::xml_node& srcSystems)
 //creates systems from information located in a config file
  bool SystemData::loadConfig(Window* window) {
   deleteSystems();
+
+  {
+  std::unique_lock<std::mutex> lock(sEmptySystemsLock);
+  sEmptySystems.clear();
+  }
   ThemeData::setDefaultTheme(nullptr);
   UIModeController::getInstance();  // Init UIModeController before loading systems
  
@@ -2481,6 +3121,18 @@ SystemData* SystemData::loadSystem(pugi::xml_node system, bool fullMode)
   if (!UIModeController::LoadEmptySystems() && newSys->getRootFolder()->getChildren().size() == 0)
   {
    LOG(LogWarning) << "System \"" << md.name << "\" has no games! Ignoring it.";
+
+   if (!Settings::ParseGamelistOnly())
+   {
+    EmptySystem emptySystem;
+    emptySystem.path = envData->mStartPath;
+    emptySystem.showHidden = newSys->getFolderScanOptions().showHidden;
+    emptySystem.fingerprint = getFolderContentFingerprint(emptySystem.path, newSys->getName(), emptySystem.showHidden, nullptr);
+
+    std::unique_lock<std::mutex> lock(sEmptySystemsLock);
+    sEmptySystems[newSys->getName()] = emptySystem;
+   }
+
    delete newSys;
    return nullptr;
   }
@@ -9,6 +9,7 @@
 #include <vector>
 #include <map>
 #include <set>
+#include <mutex>
 #include <pugixml/src/pugixml.hpp>
 #include <unordered_map>
 #include <unordered_set>
@@ -17,6 +18,8 @@
 #include "math/Vector2f.h"
 #include "CustomFeatures.h"
 #include "utils/VectorEx.h"
+#include "utils/WorkStealingPool.h"
+#include "utils/FileSystemUtil.h"
 #include "BindingManager.h"
 
 class FileData;
@@ -215,6 +218,28 @@ public:
 	static SystemData* loadSystem(std::string systemName, bool fullMode = true);
 	static std::map<std::string, std::string> getKnownSystemNames();
 
+	// Folder & gamelist fingerprints taken at load time, so a reload only rescans the systems that changed
+	bool hasFolderContentChanged();
+	bool hasGamelistChanged();
+	void updateContentFingerprint();
+	static bool hasEmptySystemChanged();
+
+	// Applies the games of a freshly loaded copy of this system. Removed files are detached from the tree, not deleted
+	bool mergeContent(SystemData* source, std::vector<FileData*>& addedGames, std::vector<FileData*>& changedGames, std::vector<FileData*>& removedFiles);
+	// Same for a list of created, deleted or renamed paths ( RomFolderWatcher ). renamedPaths maps new paths to old ones, moved files keep their FileData
+	bool applyFolderChanges(const std::vector<std::string>& paths, const std::map<std::string, std::string>& renamedPaths, std::vector<FileData*>& addedGames, std::vector<FileData*>& changedGames, std::vector<FileData*>& removedFiles);
+
+	// Detached files are kept until no GUI can point to them anymore
+	void addDetachedFiles(const std::vector<FileData*>& files);
+	static void deleteDetachedFiles();
+
+	bool getShowHiddenFiles() { return getFolderScanOptions().showHidden; }
+
+	// Folders looked into by populateFolder. envData can be null to ignore folders matching a game extension
+	static bool isScannedFolder(const Utils::FileSystem::FileInfo& fileInfo, const std::string& systemName, bool showHidden, SystemEnvironmentData* envData);
+	static void getScannedFolders(const std::string& path, const std::string& systemName, bool showHidden, SystemEnvironmentData* envData, std::vector<std::string>& folders);
+	static size_t getFolderContentFingerprint(const std::string& path, const std::string& systemName, bool showHidden, SystemEnvironmentData* envData);
+
 	bool hasKeyboardMapping();
 	KeyMappingFile getKeyboardMapping();
 
@@ -242,6 +267,22 @@ private:
 	static void createGroupedSystems();
 
 	size_t mGameListHash;
+	size_t mFolderFingerprint;
+	size_t mGamelistFingerprint;
+
+	struct EmptySystem
+	{
+		std::string path;
+		bool showHidden;
+		size_t fingerprint;
+	};
+
+	// Systems dropped by loadSystem because they had no games
+	static std::map<std::string, EmptySystem> sEmptySystems;
+	static std::mutex sEmptySystemsLock;
+
+	std::vector<FileData*> mDetachedFiles;
+	static bool sHasDetachedFiles;
 
 	bool mIsCollectionSystem;
 	bool mIsGameSystem;
@@ -254,7 +295,27 @@ private:
 	SystemEnvironmentData* mEnvData;
 	std::shared_ptr<ThemeData> mTheme;
 
-	void populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap);
+	struct FolderScanOptions
+	{
+		bool showHidden;
+		bool preloadMedias;
+	};
+
+	struct FolderScanTask;
+
+	FolderScanOptions getFolderScanOptions();
+	FileData* createFolderEntry(const Utils::FileSystem::FileInfo& fileInfo, const FolderScanOptions& options);
+	static bool isExcludedFolder(const std::string& systemName, const std::string& fileName);
+
+	static size_t getFolderFingerprint(const std::string& path, size_t entryCount);
+	static bool isArcadeAsset(const std::string& path, SystemEnvironmentData* envData);
+	size_t getGamelistFingerprint();
+	FolderData* getOrCreateFolder(const std::string& path, SystemData* source, std::unordered_map<std::string, FileData*>& fileMap);
+
+	void populateFolder(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap, bool updateFingerprint = true);
+	void populateFolderThreaded(FolderData* folder, std::unordered_map<std::string, FileData*>& fileMap);
+	void scanFolderTask(FolderScanTask* task, const FolderScanOptions& options, Utils::WorkStealingPool* pool, Utils::WorkStealingPool::TaskGroup* group);
+	void mergeFolderTask(FolderScanTask* task, std::unordered_map<std::string, FileData*>& fileMap);
 	void indexAllGameFilters(const FolderData* folder);
 	void setIsGameSystemStatus();
 	void removeMultiDiskContent(std::unordered_map<std::string, FileData*>& fileMap);
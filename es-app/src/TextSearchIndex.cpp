@@ -0,0 +1,204 @@
+#include "TextSearchIndex.h"
+
+#include <algorithm>
+
+TextSearchIndex::TextSearchIndex() : mQueryActive(false), mQueryDirty(false)
+{
+
+}
+
+std::string TextSearchIndex::normalize(const std::string& text)
+{
+	std::string ret;
+	ret.reserve(text.size());
+
+	for (char c : text)
+	{
+		if (c == ':' || c == '.')
+			continue;
+
+		if (c >= 'A' && c <= 'Z')
+			c += 0x20;
+
+		ret += c;
+	}
+
+	return ret;
+}
+
+void TextSearchIndex::getTrigrams(const std::string& key, std::vector<uint32_t>& trigrams)
+{
+	trigrams.clear();
+	if (key.size() < 3)
+		return;
+
+	trigrams.reserve(key.size() - 2);
+
+	for (size_t i = 0; i + 2 < key.size(); i++)
+		trigrams.push_back(((uint32_t)(unsigned char)key[i] << 16) | ((uint32_t)(unsigned char)key[i + 1] << 8) | (uint32_t)(unsigned char)key[i + 2]);
+
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+void TextSearchIndex::add(uint32_t ordinal, const std::string& name)
+{
+	if (ordinal < mIndexed.size() && mIndexed[ordinal])
+		remove(ordinal);
+
+	if (ordinal >= mNames.size())
+	{
+		mNames.resize(ordinal + 1);
+		mIndexed.resize(ordinal + 1, false);
+	}
+
+	mNames[ordinal] = name;
+	mIndexed[ordinal] = true;
+
+	std::vector<uint32_t> trigrams;
+	getTrigrams(normalize(name), trigrams);
+
+	for (auto trigram : trigrams)
+	{
+		auto& posting = mPostings[trigram];
+		if (posting.empty() || posting.back() < ordinal)
+			posting.push_back(ordinal);
+		else
+			posting.insert(std::lower_bound(posting.begin(), posting.end(), ordinal), ordinal);
+	}
+
+	mQueryDirty = mQueryActive;
+}
+
+void TextSearchIndex::remove(uint32_t ordinal)
+{
+	if (ordinal >= mIndexed.size() || !mIndexed[ordinal])
+		return;
+
+	std::vector<uint32_t> trigrams;
+	getTrigrams(normalize(mNames[ordinal]), trigrams);
+
+	for (auto trigram : trigrams)
+	{
+		auto posting = mPostings.find(trigram);
+		if (posting == mPostings.cend())
+			continue;
+
+		auto& ordinals = posting->second;
+
+		auto pos = std::lower_bound(ordinals.begin(), ordinals.end(), ordinal);
+		if (pos != ordinals.end() && *pos == ordinal)
+			ordinals.erase(pos);
+
+		if (ordinals.empty())
+			mPostings.erase(posting);
+	}
+
+	mNames[ordinal].clear();
+	mIndexed[ordinal] = false;
+
+	mQueryDirty = mQueryActive;
+}
+
+void TextSearchIndex::clear()
+{
+	mNames.clear();
+	mIndexed.clear();
+	mPostings.clear();
+
+	clearQuery();
+}
+
+void TextSearchIndex::setQuery(const std::vector<std::string>& terms)
+{
+	mQueryTerms.clear();
+	mQueryActive = !terms.empty();
+
+	for (auto term : terms)
+	{
+		auto key = normalize(term);
+		if (key.size() < 3)
+		{
+			mQueryActive = false;
+			break;
+		}
+
+		mQueryTerms.push_back(key);
+	}
+
+	if (!mQueryActive)
+		mQueryTerms.clear();
+
+	mCandidates.clear();
+	mQueryDirty = mQueryActive;
+}
+
+void TextSearchIndex::clearQuery()
+{
+	mQueryTerms.clear();
+	mCandidates.clear();
+	mQueryActive = false;
+	mQueryDirty = false;
+}
+
+void TextSearchIndex::addTermCandidates(const std::string& term)
+{
+	std::vector<uint32_t> trigrams;
+	getTrigrams(term, trigrams);
+
+	std::vector<const std::vector<uint32_t>*> postings;
+	postings.reserve(trigrams.size());
+
+	for (auto trigram : trigrams)
+	{
+		auto it = mPostings.find(trigram);
+		if (it == mPostings.cend())
+			return; // No name contains this trigram
+
+		postings.push_back(&it->second);
+	}
+
+	if (postings.empty())
+		return;
+
+	// Intersect the smallest lists first, the candidate set only shrinks
+	std::sort(postings.begin(), postings.end(), [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+
+	std::vector<uint32_t> result = *postings[0];
+	std::vector<uint32_t> tmp;
+
+	for (size_t i = 1; i < postings.size() && !result.empty(); i++)
+	{
+		tmp.clear();
+		std::set_intersection(result.cbegin(), result.cend(), postings[i]->cbegin(), postings[i]->cend(), std::back_inserter(tmp));
+		result.swap(tmp);
+	}
+
+	for (auto ordinal : result)
+		mCandidates[ordinal] = true;
+}
+
+void TextSearchIndex::buildCandidates()
+{
+	mQueryDirty = false;
+
+	mCandidates.assign(mNames.size(), false);
+
+	for (const auto& term : mQueryTerms)
+		addTermCandidates(term);
+}
+
+bool TextSearchIndex::isExcluded(uint32_t ordinal, const std::string& name)
+{
+	if (!mQueryActive || ordinal >= mIndexed.size() || !mIndexed[ordinal])
+		return false;
+
+	if (mQueryDirty)
+		buildCandidates();
+
+	if (ordinal >= mCandidates.size() || mCandidates[ordinal])
+		return false;
+
+	// The name was changed without reindexing : let the caller do the full comparison
+	return mNames[ordinal] == name;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef ES_APP_TEXT_SEARCH_INDEX_H
+#define ES_APP_TEXT_SEARCH_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// Inverted trigram index over game names, used to narrow the text filter to a candidate set.
+// Names are folded the same way as Utils::String::containsIgnoreCase ( ASCII only ), ':' and '.' are ignored.
+// A candidate is a game whose name contains every trigram of at least one of the query terms :
+// it is a superset of the real matches, the caller still runs the exact comparison on candidates.
+class TextSearchIndex
+{
+public:
+	TextSearchIndex();
+
+	// Games are identified by the dense ordinal FileFilterIndex gives them
+	void add(uint32_t ordinal, const std::string& name);
+	void remove(uint32_t ordinal);
+	void clear();
+
+	// Terms shorter than a trigram can't narrow the search : the query is then disabled & every game is a candidate
+	void setQuery(const std::vector<std::string>& terms);
+	void clearQuery();
+
+	// True if the game is indexed under this name & can't match the current query
+	bool isExcluded(uint32_t ordinal, const std::string& name);
+
+	static std::string normalize(const std::string& text);
+
+private:
+	static void getTrigrams(const std::string& key, std::vector<uint32_t>& trigrams);
+
+	void buildCandidates();
+	void addTermCandidates(const std::string& term);
+
+	std::vector<std::string>							mNames;
+	std::vector<bool>									mIndexed;
+	std::unordered_map<uint32_t, std::vector<uint32_t>>	mPostings; // trigram -> sorted ordinals
+
+	std::vector<std::string>	mQueryTerms;
+	std::vector<bool>			mCandidates;
+	bool						mQueryActive;
+	bool						mQueryDirty;
+};
+
+#endif // ES_APP_TEXT_SEARCH_INDEX_H
@@ -11,27 +11,28 @@
 #include "ApiSystem.h"
 #include "utils/StringUtil.h"
 #include "Log.h"
+#include "Settings.h"
+#include "FileHashCache.h"
 #include <unordered_set>
-#include <queue>
 
 #include "LocaleES.h"
 
 #define ICONINDEX _U("\uF002 ")
 
 ThreadedHasher* ThreadedHasher::mInstance = nullptr;
-bool ThreadedHasher::mPaused = false;
+std::atomic<bool> ThreadedHasher::mPaused(false);
+std::mutex ThreadedHasher::mPauseLock;
+std::condition_variable ThreadedHasher::mPauseChanged;
 
-static std::mutex mLoaderLock;
-
-ThreadedHasher::ThreadedHasher(Window* window, HasherType type, std::queue<FileData*> searchQueue, bool forceAllGames)
-	: mWindow(window)
+ThreadedHasher::ThreadedHasher(Window* window, HasherType type, const std::vector<FileData*>& games, bool forceAllGames)
+	: mWindow(window), mNextGame(0)
 {
 	mForce = forceAllGames;
 	mExit = false;
 	mType = type;
 
-	mSearchQueue = searchQueue;
-	mTotal = mSearchQueue.size();
+	mGames = games;
+	mTotal = mGames.size();
 
 	if ((mType & HASH_CHEEVOS_MD5) == HASH_CHEEVOS_MD5)
 	{
@@ -39,8 +40,7 @@ ThreadedHasher::ThreadedHasher(Window* window, HasherType type, std::queue<FileD
 		{
 			mCheevosHashes = RetroAchievements::getCheevosHashes();
 			if (mCheevosHashes.size() == 0)
-				while (!mSearchQueue.empty())
-					mSearchQueue.pop();
+				mNextGame = mGames.size();
 		}
 		catch (const std::exception& e)
 		{
@@ -56,10 +56,15 @@ ThreadedHasher::ThreadedHasher(Window* window, HasherType type, std::queue<FileD
 	else 
 		mWndNotification->updateTitle(ICONINDEX + _("SEARCHING NETPLAY GAMES"));
 
-	int num_threads = std::thread::hardware_concurrency() / 2;
+	int num_threads = Settings::getInstance()->getInt("HashingThreads");
+	if (num_threads <= 0)
+		num_threads = std::thread::hardware_concurrency() / 2;
 	if (num_threads == 0)
 		num_threads = 1;
 
+	// Files already hashed are lookups in the hash cache, only the reads are limited
+	FileHashCache::getInstance()->setMaxReaders(Settings::getInstance()->getInt("HashingReaders"));
+
 	mThreadCount = num_threads;
 	for (size_t i = 0; i < num_threads; i++)
 		mThreads.push_back(new std::thread(&ThreadedHasher::run, this));
@@ -81,44 +86,57 @@ std::string ThreadedHasher::formatGameName(FileData* game)
 	return "[" + game->getSystemName() + "] " + game->getName();
 }
 
-void ThreadedHasher::updateUI(const std::string label)
+void ThreadedHasher::updateUI(const std::string label, size_t index)
 {
-	std::string idx = std::to_string(mTotal + 1 - mSearchQueue.size()) + "/" + std::to_string(mTotal);
-	int percent = 100 - (mSearchQueue.size() * 100 / mTotal);
+	int percent = 100 - ((mTotal - index) * 100 / mTotal);
 		
 	mWndNotification->updateText(label);
 	mWndNotification->updatePercent(percent);	
 }
 
-void ThreadedHasher::run()
+void ThreadedHasher::pause()
+{
+	mPaused = true;
+}
+
+void ThreadedHasher::resume()
 {
-	std::unique_lock<std::mutex> lock(mLoaderLock);
+	std::unique_lock<std::mutex> lock(mPauseLock);
+	mPaused = false;
+	mPauseChanged.notify_all();
+}
 
+void ThreadedHasher::run()
+{
 	bool cheevos = ((mType & HASH_CHEEVOS_MD5) == HASH_CHEEVOS_MD5);
 	bool netplay = ((mType & HASH_NETPLAY_CRC) == HASH_NETPLAY_CRC);
 
-	while (!mExit && !mSearchQueue.empty())
+	while (!mExit)
 	{
-		FileData* game = mSearchQueue.front();
+		size_t index = mNextGame++;
+		if (index >= mGames.size())
+			break;
 
-		auto label = formatGameName(game);
+		FileData* game = mGames[index];
 
-		LOG(LogDebug) << "Hashing " << formatGameName(game);
-		updateUI(label);
+		auto label = formatGameName(game);
 
-		mSearchQueue.pop();
+		LOG(LogDebug) << "Hashing " << label;
 
-		lock.unlock();
+		{
+			std::unique_lock<std::mutex> lock(mLock);
+			updateUI(label, index);
+		}
 
 		if (mPaused)
 		{
-			while (!mExit && mPaused)
-			{
-				std::this_thread::yield();
-				std::this_thread::sleep_for(std::chrono::milliseconds(500));
-			}
+			std::unique_lock<std::mutex> lock(mPauseLock);
+			mPauseChanged.wait(lock, [this] { return mExit || !mPaused; });
 		}		
 
+		if (mExit)
+			break;
+
 		if (netplay)
 		{
 			LOG(LogDebug) << "CheckCrc32 : " << label;
@@ -142,10 +160,10 @@ void ThreadedHasher::run()
 
 			LOG(LogDebug) << "CheckCheevosHash OK : " << label;;
 		}		
-
-		lock.lock();
 	}
 
+	std::unique_lock<std::mutex> lock(mLock);
+
 	mThreadCount--;
 
 	if (mThreadCount == 0)
@@ -183,7 +201,7 @@ void ThreadedHasher::start(Window* window, HasherType type, bool forceAllGames,
 			return;
 	}
 	
-	std::queue<FileData*> searchQueue;
+	std::vector<FileData*> searchQueue;
 	
 	for (auto sys : SystemData::sSystemVector)
 	{
@@ -219,7 +237,7 @@ void ThreadedHasher::start(Window* window, HasherType type, bool forceAllGames,
 			}
 
 			if (netPlay || cheevos)
-				searchQueue.push(file);
+				searchQueue.push_back(file);
 		}
 	}
 
@@ -252,7 +270,9 @@ void ThreadedHasher::stop()
 
 	try
 	{
+		std::unique_lock<std::mutex> lock(mPauseLock);
 		thread->mExit = true;
+		mPauseChanged.notify_all();
 	}
 	catch (...) {}
 }
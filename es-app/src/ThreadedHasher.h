@@ -1,8 +1,11 @@
 #pragma once
 
 #include <thread>
-#include <queue>
+#include <vector>
 #include <set>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include "components/AsyncNotificationComponent.h"
 
 class FileData;
@@ -22,17 +25,20 @@ public:
 	static bool isRunning() { return mInstance != nullptr; }
 	static bool checkCloseIfRunning(Window* window);
 
-	static void pause() { mPaused = true; }
-	static void resume() { mPaused = false; }
+	static void pause();
+	static void resume();
 
 private:
-	ThreadedHasher(Window* window, HasherType type, std::queue<FileData*> searchQueue, bool forceAllGames = false);
+	ThreadedHasher(Window* window, HasherType type, const std::vector<FileData*>& games, bool forceAllGames = false);
 	~ThreadedHasher();
 
-	void updateUI(const std::string label);
+	void updateUI(const std::string label, size_t index);
 	static std::string formatGameName(FileData* game);
 
-	std::queue<FileData*> mSearchQueue;
+	// Workers take the next game with an atomic index, no lock is held while hashing
+	std::vector<FileData*>	mGames;
+	std::atomic<size_t>		mNextGame;
+	std::mutex				mLock;
 
 	Window* mWindow;
 	AsyncNotificationComponent* mWndNotification;
@@ -53,7 +59,10 @@ private:
 	bool mExit;
 	bool mForce;
 
-	static bool mPaused;
+	static std::atomic<bool> mPaused;
+	static std::mutex mPauseLock;
+	static std::condition_variable mPauseChanged;
+
 	static ThreadedHasher* mInstance;
 };
 
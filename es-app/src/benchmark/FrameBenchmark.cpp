@@ -0,0 +1,463 @@
+//
+// Headless frame benchmark : loads a theme and a synthetic library with the NULL renderer, replays a scripted
+// navigation ( system carousel, gamelist, grid, menus ) through Window::update / Window::render and reports
+// the CPU time of each frame as percentiles.
+//
+// es-benchmark [--home <dir>] [--theme <name>] [--systems <n>] [--games <n>] [--resolution <w> <h>]
+//              [--csv <file>] [--max-p99 <ms>]
+//
+// Exits with 2 when the p99 of all frames is above --max-p99, so CI boxes without display can catch regressions.
+//
+
+#include "views/ViewController.h"
+#include "CollectionSystemManager.h"
+#include "InputManager.h"
+#include "InputConfig.h"
+#include "Log.h"
+#include "MameNames.h"
+#include "Genres.h"
+#include "MetaData.h"
+#include "Settings.h"
+#include "SystemData.h"
+#include "Window.h"
+#include "ImageIO.h"
+#include "Paths.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "renderers/Renderer.h"
+
+#include <SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+// Defined by main.cpp in the application
+Uint32 SDL_EPIC_REFRESH_COMPLETE;
+Uint32 SDL_STEAM_REFRESH_COMPLETE;
+Uint32 SDL_XBOX_REFRESH_COMPLETE;
+Uint32 SDL_GAMELIST_UPDATED;
+Uint32 SDL_XBOX_AUTH_COMPLETE_EVENT;
+
+struct BenchmarkOptions
+{
+	BenchmarkOptions() : systems(8), games(500), width(1280), height(720), maxP99(0) { }
+
+	std::string home;
+	std::string theme;
+	std::string csv;
+	int systems;
+	int games;
+	int width;
+	int height;
+	double maxP99;
+};
+
+struct FrameSample
+{
+	std::string step;
+	double ms;
+	Renderer::FrameStats stats;
+};
+
+// A step presses a button "presses" times. Each press is held "holdFrames" frames then released for "settleFrames" frames.
+struct BenchmarkStep
+{
+	std::string name;
+	std::string button;
+	int presses;
+	int holdFrames;
+	int settleFrames;
+	std::function<void()> action;
+};
+
+static const char* SYSTEM_NAMES[] = { "nes", "snes", "megadrive", "psx", "n64", "gba", "mastersystem", "pcengine", "gb", "gbc", "atari2600", "neogeo", "dreamcast", "psp", "nds", "mame" };
+static const char* GENRES[] = { "Action", "Platform", "Shooter", "Racing", "Sports", "Puzzle", "Role Playing Game", "Fighting", "Adventure", "Strategy" };
+static const char* COMPANIES[] = { "Nintendo", "Sega", "Capcom", "Konami", "Namco", "Taito", "Hudson Soft", "SNK", "Irem", "Data East" };
+
+static bool parseArgs(int argc, char* argv[], BenchmarkOptions& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		bool hasValue = i < argc - 1;
+
+		if (arg == "--home" && hasValue)
+			options.home = argv[++i];
+		else if (arg == "--theme" && hasValue)
+			options.theme = argv[++i];
+		else if (arg == "--csv" && hasValue)
+			options.csv = argv[++i];
+		else if (arg == "--systems" && hasValue)
+			options.systems = std::max(1, std::min((int)(sizeof(SYSTEM_NAMES) / sizeof(SYSTEM_NAMES[0])), atoi(argv[++i])));
+		else if (arg == "--games" && hasValue)
+			options.games = std::max(1, atoi(argv[++i]));
+		else if (arg == "--max-p99" && hasValue)
+			options.maxP99 = atof(argv[++i]);
+		else if (arg == "--resolution" && i < argc - 2)
+		{
+			options.width = atoi(argv[++i]);
+			options.height = atoi(argv[++i]);
+		}
+		else
+		{
+			std::cerr << "Usage: es-benchmark [--home <dir>] [--theme <name>] [--systems <n>] [--games <n>] [--resolution <w> <h>] [--csv <file>] [--max-p99 <ms>]\n";
+			return false;
+		}
+	}
+
+	if (options.home.empty())
+		options.home = Utils::FileSystem::getGenericPath(Utils::FileSystem::getTempPath() + "/es-benchmark");
+
+	return true;
+}
+
+// Writes es_systems.cfg and one folder of empty roms with a gamelist.xml per system. Contents are deterministic.
+static void createSyntheticLibrary(const BenchmarkOptions& options)
+{
+	std::string configPath = Paths::getUserEmulationStationPath();
+	std::string romsPath = options.home + "/roms";
+
+	Utils::FileSystem::createDirectory(configPath);
+	Utils::FileSystem::createDirectory(romsPath);
+
+	std::ofstream systems(configPath + "/es_systems.cfg");
+	systems << "<?xml version=\"1.0\"?>\n<systemList>\n";
+
+	unsigned int seed = 12345;
+	auto random = [&seed](int max) { seed = seed * 1103515245 + 12345; return (int)((seed >> 16) % max); };
+
+	for (int s = 0; s < options.systems; s++)
+	{
+		std::string name = SYSTEM_NAMES[s];
+		std::string path = romsPath + "/" + name;
+		Utils::FileSystem::createDirectory(path);
+
+		systems << "\t<system>\n";
+		systems << "\t\t<name>" << name << "</name>\n";
+		systems << "\t\t<fullname>" << Utils::String::toUpper(name) << "</fullname>\n";
+		systems << "\t\t<path>" << path << "</path>\n";
+		systems << "\t\t<extension>.zip</extension>\n";
+		systems << "\t\t<command>true</command>\n";
+		systems << "\t\t<platform>" << name << "</platform>\n";
+		systems << "\t\t<theme>" << name << "</theme>\n";
+		systems << "\t</system>\n";
+
+		std::ofstream gamelist(path + "/gamelist.xml");
+		gamelist << "<?xml version=\"1.0\"?>\n<gameList>\n";
+
+		for (int g = 0; g < options.games; g++)
+		{
+			char fileName[64];
+			snprintf(fileName, sizeof(fileName), "Game %04d.zip", g + 1);
+
+			std::string romPath = path + "/" + fileName;
+			if (!Utils::FileSystem::exists(romPath))
+				std::ofstream(romPath).close();
+
+			gamelist << "\t<game>\n";
+			gamelist << "\t\t<path>./" << fileName << "</path>\n";
+			gamelist << "\t\t<name>" << COMPANIES[random(10)] << " " << GENRES[random(10)] << " " << (g + 1) << "</name>\n";
+			gamelist << "\t\t<desc>Synthetic game generated by the frame benchmark.</desc>\n";
+			gamelist << "\t\t<rating>" << (random(11) / 10.0f) << "</rating>\n";
+			gamelist << "\t\t<releasedate>" << (1980 + random(30)) << "0101T000000</releasedate>\n";
+			gamelist << "\t\t<developer>" << COMPANIES[random(10)] << "</developer>\n";
+			gamelist << "\t\t<publisher>" << COMPANIES[random(10)] << "</publisher>\n";
+			gamelist << "\t\t<genre>" << GENRES[random(10)] << "</genre>\n";
+			gamelist << "\t\t<players>" << (1 + random(4)) << "</players>\n";
+			gamelist << "\t</game>\n";
+		}
+
+		gamelist << "</gameList>\n";
+	}
+
+	systems << "</systemList>\n";
+}
+
+static void mapKeyboard()
+{
+	InputConfig* config = InputManager::getInstance()->getInputConfigByDevice(DEVICE_KEYBOARD);
+
+	config->clear();
+	config->mapInput("up", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_UP, 1, true));
+	config->mapInput("down", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_DOWN, 1, true));
+	config->mapInput("left", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_LEFT, 1, true));
+	config->mapInput("right", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_RIGHT, 1, true));
+	config->mapInput(BUTTON_OK, Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_RETURN, 1, true));
+	config->mapInput(BUTTON_BACK, Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_ESCAPE, 1, true));
+	config->mapInput("start", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_F1, 1, true));
+	config->mapInput("select", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_F2, 1, true));
+	config->mapInput("pageup", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_RIGHTBRACKET, 1, true));
+	config->mapInput("pagedown", Input(DEVICE_KEYBOARD, TYPE_KEY, SDLK_LEFTBRACKET, 1, true));
+}
+
+static double percentile(std::vector<double> values, double p)
+{
+	if (values.empty())
+		return 0;
+
+	size_t index = std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+	std::nth_element(values.begin(), values.begin() + index, values.end());
+	return values[index];
+}
+
+class FrameBenchmark
+{
+public:
+	FrameBenchmark(Window* window) : mWindow(window) { }
+
+	void runFrames(const std::string& step, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			// Fixed time step : animations advance the same way on every run
+			mWindow->update(16);
+			mWindow->render();
+			Renderer::swapBuffers();
+
+			auto end = std::chrono::steady_clock::now();
+
+			FrameSample sample;
+			sample.step = step;
+			sample.ms = std::chrono::duration<double, std::milli>(end - start).count();
+			sample.stats = Renderer::getFrameStats();
+			mSamples.push_back(sample);
+
+			// Background loaders post their results as SDL events
+			SDL_Event event;
+			while (SDL_PollEvent(&event))
+				;
+		}
+	}
+
+	void run(const BenchmarkStep& step)
+	{
+		if (step.action)
+			step.action();
+
+		InputConfig* config = InputManager::getInstance()->getInputConfigByDevice(DEVICE_KEYBOARD);
+
+		Input input;
+		bool hasInput = !step.button.empty() && config->getInputByName(step.button, &input);
+
+		for (int i = 0; i < std::max(1, step.presses); i++)
+		{
+			if (hasInput)
+			{
+				input.value = 1;
+				mWindow->input(config, input);
+				runFrames(step.name, step.holdFrames);
+
+				input.value = 0;
+				mWindow->input(config, input);
+			}
+
+			runFrames(step.name, step.settleFrames);
+		}
+	}
+
+	void report(std::ostream& out)
+	{
+		std::vector<std::string> steps;
+		for (auto& sample : mSamples)
+			if (std::find(steps.cbegin(), steps.cend(), sample.step) == steps.cend())
+				steps.push_back(sample.step);
+
+		out << std::left << std::setw(28) << "STEP" << std::right
+			<< std::setw(8) << "FRAMES" << std::setw(9) << "P50" << std::setw(9) << "P90" << std::setw(9) << "P99" << std::setw(9) << "MAX"
+			<< std::setw(10) << "DRAWS" << std::setw(11) << "VERTICES" << std::setw(9) << "UPLOADS" << "\n";
+
+		for (auto& step : steps)
+			reportLine(out, step, [step](const FrameSample& sample) { return sample.step == step; });
+
+		reportLine(out, "ALL", [](const FrameSample& sample) { return true; });
+	}
+
+	void writeCsv(const std::string& path)
+	{
+		std::ofstream csv(path);
+		csv << "frame;step;ms;drawCalls;batchedDraws;vertices;textureUploads;stateChanges\n";
+
+		for (size_t i = 0; i < mSamples.size(); i++)
+		{
+			auto& sample = mSamples[i];
+			csv << i << ";" << sample.step << ";" << sample.ms << ";" << sample.stats.drawCalls << ";" << sample.stats.batchedDraws << ";"
+				<< sample.stats.vertices << ";" << sample.stats.textureUploads << ";" << sample.stats.stateChanges << "\n";
+		}
+	}
+
+	double getPercentile(double p)
+	{
+		std::vector<double> times;
+		for (auto& sample : mSamples)
+			times.push_back(sample.ms);
+
+		return percentile(times, p);
+	}
+
+private:
+	void reportLine(std::ostream& out, const std::string& name, const std::function<bool(const FrameSample&)>& filter)
+	{
+		std::vector<double> times;
+		double draws = 0, vertices = 0, uploads = 0;
+
+		for (auto& sample : mSamples)
+		{
+			if (!filter(sample))
+				continue;
+
+			times.push_back(sample.ms);
+			draws += sample.stats.drawCalls;
+			vertices += sample.stats.vertices;
+			uploads += sample.stats.textureUploads;
+		}
+
+		if (times.empty())
+			return;
+
+		double count = (double)times.size();
+
+		out << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(8) << times.size()
+			<< std::setw(9) << percentile(times, 0.50)
+			<< std::setw(9) << percentile(times, 0.90)
+			<< std::setw(9) << percentile(times, 0.99)
+			<< std::setw(9) << *std::max_element(times.cbegin(), times.cend())
+			<< std::setprecision(0)
+			<< std::setw(10) << draws / count
+			<< std::setw(11) << vertices / count
+			<< std::setw(9) << uploads
+			<< "\n";
+	}
+
+	Window*						mWindow;
+	std::vector<FrameSample>	mSamples;
+};
+
+int main(int argc, char* argv[])
+{
+	std::locale::global(std::locale("C"));
+
+	Paths::setExePath(argv[0]);
+
+	BenchmarkOptions options;
+	if (!parseArgs(argc, argv, options))
+		return 1;
+
+	// Must be set before the first Settings::getInstance()
+	Paths::setHomePath(options.home);
+
+	// No display & no sound card on CI boxes
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+	SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+	createSyntheticLibrary(options);
+
+	Log::init();
+
+	Settings* settings = Settings::getInstance();
+	settings->setString("Renderer", "NULL");
+	settings->setBool("Windowed", true);
+	settings->setInt("WindowWidth", options.width);
+	settings->setInt("WindowHeight", options.height);
+	settings->setBool("SplashScreen", false);
+	settings->setBool("VSync", false);
+	settings->setString("GamelistViewStyle", "basic");
+
+	if (!options.theme.empty())
+		settings->setString("ThemeSet", options.theme);
+
+	Genres::init();
+	MetaDataList::initMetadata();
+
+	Window window;
+	ViewController::init(&window);
+	CollectionSystemManager::init(&window);
+
+	window.pushGui(ViewController::get());
+	if (!window.init(true, false))
+	{
+		std::cerr << "Window failed to initialize\n";
+		return 1;
+	}
+
+	MameNames::init();
+	ImageIO::loadImageCache();
+
+	auto loadStart = std::chrono::steady_clock::now();
+
+	if (!SystemData::loadConfig(nullptr) || SystemData::sSystemVector.size() == 0)
+	{
+		std::cerr << "Synthetic library failed to load\n";
+		return 1;
+	}
+
+	ViewController::get()->preload();
+
+	InputManager::getInstance()->init();
+	mapKeyboard();
+
+	ViewController::get()->goToStart(true);
+
+	auto loadTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+
+	std::vector<BenchmarkStep> script =
+	{
+		{ "idle system view",		"",				0, 0, 120, nullptr },
+		{ "scroll system carousel",	"right",		(int)SystemData::sSystemVector.size(), 2, 20, nullptr },
+		{ "open gamelist",			BUTTON_OK,		1, 2, 90, nullptr },
+		{ "scroll gamelist",		"down",			1, 240, 60, nullptr },
+		{ "page gamelist",			"pagedown",		10, 2, 15, nullptr },
+		{ "back to systems",		BUTTON_BACK,	1, 2, 60, nullptr },
+		{ "open grid",				BUTTON_OK,		1, 2, 90, [&window]()
+			{
+				Settings::getInstance()->setString("GamelistViewStyle", "grid");
+				ViewController::get()->reloadAll(&window);
+			} },
+		{ "page through grid",		"down",			20, 2, 10, nullptr },
+		{ "back to systems (grid)",	BUTTON_BACK,	1, 2, 60, nullptr },
+		{ "open main menu",			"start",		1, 2, 60, nullptr },
+		{ "scroll main menu",		"down",			15, 2, 8, nullptr },
+		{ "close main menu",		BUTTON_BACK,	1, 2, 60, nullptr },
+	};
+
+	FrameBenchmark benchmark(&window);
+	for (auto& step : script)
+		benchmark.run(step);
+
+	std::cout << "Renderer: " << Renderer::getDriverName() << ", theme: " << settings->getString("ThemeSet")
+		<< ", systems: " << SystemData::sSystemVector.size() << ", games per system: " << options.games
+		<< ", load: " << std::fixed << std::setprecision(0) << loadTime << " ms\n\n";
+
+	benchmark.report(std::cout);
+
+	if (!options.csv.empty())
+		benchmark.writeCsv(options.csv);
+
+	double p99 = benchmark.getPercentile(0.99);
+
+	while (window.peekGui() != nullptr && window.peekGui() != ViewController::get())
+		delete window.peekGui();
+
+	CollectionSystemManager::deinit();
+	SystemData::deleteSystems();
+
+	while (window.peekGui() != nullptr)
+		delete window.peekGui();
+
+	window.deinit();
+
+	if (options.maxP99 > 0 && p99 > options.maxP99)
+	{
+		std::cerr << "\nFrame time p99 " << p99 << " ms is above the limit of " << options.maxP99 << " ms\n";
+		return 2;
+	}
+
+	return 0;
+}
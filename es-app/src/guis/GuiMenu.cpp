@@ -1152,6 +1152,12 @@ void GuiMenu::openDeveloperSettings()
 	s->addWithLabel(_("THREADED LOADING"), threadedLoading);
 	s->addSaveFunc([threadedLoading] { Settings::getInstance()->setBool("ThreadedLoading", threadedLoading->getState()); });
 
+	// watch rom folders
+	auto watchRomFolders = std::make_shared<SwitchComponent>(mWindow);
+	watchRomFolders->setState(Settings::getInstance()->getBool("WatchRomFolders"));
+	s->addWithDescription(_("WATCH ROM FOLDERS"), _("Adds & removes games as soon as rom files are copied or deleted"), watchRomFolders);
+	s->addSaveFunc([watchRomFolders] { Settings::getInstance()->setBool("WatchRomFolders", watchRomFolders->getState()); });
+
 	// threaded loading
 	auto asyncImages = std::make_shared<SwitchComponent>(mWindow);
 	asyncImages->setState(Settings::getInstance()->getBool("AsyncImages"));
@@ -2964,7 +2970,7 @@ void GuiMenu::openMissingBiosSettings()
 	GuiBios::show(mWindow);
 }
 
-void GuiMenu::updateGameLists(Window* window, bool confirm)
+void GuiMenu::updateGameLists(Window* window, bool confirm, bool changedOnly)
 {
 	if (ThreadedScraper::isRunning())
 	{
@@ -2986,13 +2992,20 @@ void GuiMenu::updateGameLists(Window* window, bool confirm)
 	
 	if (!confirm)
 	{
-		ViewController::reloadAllGames(window, true, true);
+		if (changedOnly)
+			ViewController::reloadChangedGames(window, true);
+		else
+			ViewController::reloadAllGames(window, true, true);
+
 		return;
 	}
 
-	window->pushGui(new GuiMsgBox(window, _("REALLY UPDATE GAMELISTS?"), _("YES"), [window]
+	window->pushGui(new GuiMsgBox(window, _("REALLY UPDATE GAMELISTS?"), _("YES"), [window, changedOnly]
 		{
-		ViewController::reloadAllGames(window, true, true);
+		if (changedOnly)
+			ViewController::reloadChangedGames(window, true);
+		else
+			ViewController::reloadAllGames(window, true, true);
 		}, 
 		_("NO"), nullptr));
 }
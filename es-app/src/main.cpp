@@ -54,6 +54,7 @@
 #include "GameStore/Xbox/XboxUI.h"
 #include "SpotifyManager.h"
 #include "MusicStartupHelper.h"
+#include "RomFolderWatcher.h"
 
 #ifdef WIN32
 #include <Windows.h>
@@ -637,6 +638,10 @@ if (SDL_GAMELIST_UPDATED == ((Uint32)-1)) {
 		window.pushGui(new GuiMsgBox(&window, errorMsg, _("QUIT"), [] { Utils::Platform::quitES(); }));
 	}
 
+	RomFolderWatcher* romFolderWatcher = WatchersManager::GetComponent<RomFolderWatcher>();
+	if (romFolderWatcher != nullptr)
+		romFolderWatcher->updateSystems();
+
 	SystemConf* systemConf = SystemConf::getInstance();
 
   
@@ -16,8 +16,10 @@
 #include "utils/md5.h"
 #include "scrapers/Scraper.h"
 #include <unordered_map>
+#include <algorithm>
 
-void HttpApi::getSystemDataJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer, SystemData* sys, bool localpaths)
+template<typename TWriter>
+void HttpApi::getSystemDataJson(TWriter& writer, SystemData* sys, bool localpaths)
 {
 	writer.StartObject();
 	writer.Key("name"); writer.String(sys->getName().c_str());
@@ -129,39 +131,47 @@ FileData* HttpApi::findFileData(SystemData* system, const std::string& id)
 	return nullptr;
 }
 
-void HttpApi::getFileDataJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer, FileData* game, bool localpaths)
+template<typename TWriter>
+void HttpApi::getFileDataJson(TWriter& writer, FileData* game, bool localpaths, const std::set<std::string>* fields)
 {
 	if (game->getType() != GAME)
 		return;
 
-	std::string id = getFileDataId(game);
+	auto hasField = [fields](const std::string& name) { return fields == nullptr || fields->size() == 0 || fields->find(name) != fields->cend(); };
+
+	// md5 of the path, only computed when written
+	std::string id;
+	auto getId = [&id, game]() -> const std::string& { if (id.empty()) id = getFileDataId(game); return id; };
 
 	writer.StartObject();
-	writer.Key("id"); writer.String(id.c_str());
-	writer.Key("path"); writer.String(game->getPath().c_str());
-	writer.Key("name"); writer.String(game->getName().c_str());
 
-	writer.Key("systemName"); writer.String(game->getSystemName().c_str());
+	if (hasField("id")) { writer.Key("id"); writer.String(getId().c_str()); }
+	if (hasField("path")) { writer.Key("path"); writer.String(game->getPath().c_str()); }
+	if (hasField("name")) { writer.Key("name"); writer.String(game->getName().c_str()); }
+	if (hasField("systemName")) { writer.Key("systemName"); writer.String(game->getSystemName().c_str()); }
 
-	auto meta = game->getMetadata();
-	for (auto mdd : MetaDataList::getMDD())
+	static const std::string scraperIdKey = "scraperId";
+
+	const MetaDataList& meta = game->getMetadata();
+
+	for (const auto& mdd : MetaDataList::getMDD())
 	{
 		if (mdd.id == MetaDataId::Name)
 			continue;
 
-		std::string value = game->getMetadata(mdd.id);
-		if (!value.empty())
-		{
-			if (meta.getType(mdd.id) == MD_PATH && localpaths == false)
-				value = "/systems/" + game->getSourceFileData()->getSystemName() + "/games/" + id + "/media/" + mdd.key;
+		const std::string& key = mdd.id == MetaDataId::ScraperId ? scraperIdKey : mdd.key;
+		if (!hasField(key))
+			continue;
+
+		std::string value = meta.get(mdd.id);
+		if (value.empty())
+			continue;
 
-			if (mdd.id == MetaDataId::ScraperId)
-				writer.Key("scraperId");
-			else 
-				writer.Key(mdd.key.c_str());
+		if (mdd.type == MD_PATH && localpaths == false)
+			value = "/systems/" + game->getSourceFileData()->getSystemName() + "/games/" + getId() + "/media/" + mdd.key;
 
-			writer.String(value.c_str());
-		}
+		writer.Key(key.c_str());
+		writer.String(value.c_str());
 	}
 
 	writer.EndObject();
@@ -280,13 +290,8 @@ std::string HttpApi::ToJson(SystemData* system, bool localpaths)
 	return s.GetString();
 }
 
-std::string HttpApi::getSystemGames(SystemData* system)
+std::vector<FileData*> HttpApi::getSystemGameList(SystemData* system)
 {
-	rapidjson::StringBuffer s;
-	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(s);
-
-	writer.StartArray();
-
 	std::vector<FileData*> files;
 
 	std::stack<FolderData*> stack;
@@ -299,18 +304,49 @@ std::string HttpApi::getSystemGames(SystemData* system)
 
 		for (auto it : current->getChildren())
 		{
-			files.push_back(it);
 			if (it->getType() == FOLDER)
 				stack.push((FolderData*)it);
+			else if (it->getType() == GAME)
+				files.push_back(it);
 		}
 	}
 
-	for (auto game : files)
-		getFileDataJson(writer, game);
+	return files;
+}
 
-	writer.EndArray();
+std::string HttpApi::getGamesJson(const std::vector<FileData*>& games, size_t from, size_t to, const std::set<std::string>& fields, bool pretty)
+{
+	rapidjson::StringBuffer s;
+	rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> prettyWriter(s);
 
-	return s.GetString();
+	to = std::min(to, games.size());
+
+	for (size_t i = from; i < to; i++)
+	{
+		if (i != from)
+			s.Put(',');
+
+		// Each game is a root value
+		if (pretty)
+		{
+			prettyWriter.Reset(s);
+			getFileDataJson(prettyWriter, games[i], false, &fields);
+		}
+		else
+		{
+			writer.Reset(s);
+			getFileDataJson(writer, games[i], false, &fields);
+		}
+	}
+
+	return std::string(s.GetString(), s.GetSize());
+}
+
+std::string HttpApi::getSystemGames(SystemData* system)
+{
+	auto games = getSystemGameList(system);
+	return "[" + getGamesJson(games, 0, games.size(), std::set<std::string>(), true) + "]";
 }
 
 std::string HttpApi::getRunnningGameInfo()
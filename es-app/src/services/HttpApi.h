@@ -1,8 +1,11 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <set>
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/pointer.h>
+#include <rapidjson/writer.h>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 
@@ -16,6 +19,11 @@ public:
 	static std::string getSystemList();
 	static std::string getSystemGames(SystemData* system);
 
+	// Games of a system, in listing order ( folders excluded )
+	static std::vector<FileData*> getSystemGameList(SystemData* system);
+	// Comma separated json objects for games [from, to[, without the enclosing array. Empty fields writes all the keys
+	static std::string getGamesJson(const std::vector<FileData*>& games, size_t from, size_t to, const std::set<std::string>& fields, bool pretty = true);
+
 	static std::string getRunnningGameInfo();
 
 	static std::string ToJson(SystemData* system, bool localpaths = false);
@@ -30,6 +38,10 @@ public:
 
 private:
 	static std::string getFileDataId(FileData* game);
-	static void getFileDataJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer, FileData* game, bool localpaths = false);
-	static void getSystemDataJson(rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer, SystemData* sys, bool localpaths = false);
+
+	template<typename TWriter>
+	static void getFileDataJson(TWriter& writer, FileData* game, bool localpaths = false, const std::set<std::string>* fields = nullptr);
+
+	template<typename TWriter>
+	static void getSystemDataJson(TWriter& writer, SystemData* sys, bool localpaths = false);
 };
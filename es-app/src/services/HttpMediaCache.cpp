@@ -0,0 +1,78 @@
+#include "HttpMediaCache.h"
+#include "Settings.h"
+
+#include <algorithm>
+
+HttpMediaCache* HttpMediaCache::getInstance()
+{
+	static HttpMediaCache instance;
+	return &instance;
+}
+
+HttpMediaCache::HttpMediaCache() : mSize(0)
+{
+
+}
+
+bool HttpMediaCache::find(const std::string& path, const std::string& etag, std::shared_ptr<std::string>& data)
+{
+	std::unique_lock<std::mutex> lock(mLock);
+
+	auto it = mLookup.find(path);
+	if (it == mLookup.cend())
+		return false;
+
+	if (it->second->etag != etag)
+	{
+		mSize -= it->second->data->size();
+		mEntries.erase(it->second);
+		mLookup.erase(it);
+		return false;
+	}
+
+	mEntries.splice(mEntries.begin(), mEntries, it->second);
+	data = it->second->data;
+	return true;
+}
+
+void HttpMediaCache::insert(const std::string& path, const std::string& etag, const std::shared_ptr<std::string>& data)
+{
+	size_t maxSize = (size_t)std::max(0, Settings::getInstance()->getInt("HttpMediaCacheSize")) * 1024 * 1024;
+	if (data == nullptr || data->size() > maxSize)
+		return;
+
+	std::unique_lock<std::mutex> lock(mLock);
+
+	auto it = mLookup.find(path);
+	if (it != mLookup.cend())
+	{
+		mSize -= it->second->data->size();
+		mEntries.erase(it->second);
+		mLookup.erase(it);
+	}
+
+	evict(maxSize - data->size());
+
+	mEntries.push_front(Entry{ path, etag, data });
+	mLookup[path] = mEntries.begin();
+	mSize += data->size();
+}
+
+void HttpMediaCache::evict(size_t maxSize)
+{
+	while (mSize > maxSize && mEntries.size())
+	{
+		auto& entry = mEntries.back();
+		mSize -= entry.data->size();
+		mLookup.erase(entry.path);
+		mEntries.pop_back();
+	}
+}
+
+void HttpMediaCache::clear()
+{
+	std::unique_lock<std::mutex> lock(mLock);
+	mEntries.clear();
+	mLookup.clear();
+	mSize = 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#ifndef ES_APP_SERVICES_HTTP_MEDIA_CACHE_H
+#define ES_APP_SERVICES_HTTP_MEDIA_CACHE_H
+
+#include <string>
+#include <memory>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+//
+// Small files served by the web server ( box art, logos, web ui resources ), least recently used evicted first.
+// Entries are keyed by path & ETag : a modified file is read again from disk.
+//
+class HttpMediaCache
+{
+public:
+	static HttpMediaCache* getInstance();
+
+	bool find(const std::string& path, const std::string& etag, std::shared_ptr<std::string>& data);
+	void insert(const std::string& path, const std::string& etag, const std::shared_ptr<std::string>& data);
+
+	void clear();
+
+private:
+	HttpMediaCache();
+
+	struct Entry
+	{
+		std::string					 path;
+		std::string					 etag;
+		std::shared_ptr<std::string> data;
+	};
+
+	void evict(size_t maxSize);
+
+	std::mutex														mLock;
+	std::list<Entry>												mEntries; // Most recently used first
+	std::unordered_map<std::string, std::list<Entry>::iterator>	mLookup;
+	size_t															mSize;
+};
+
+#endif // ES_APP_SERVICES_HTTP_MEDIA_CACHE_H
@@ -17,6 +17,7 @@
 #include "guis/GuiMsgBox.h"
 #include "utils/FileSystemUtil.h"
 #include "HttpApi.h"
+#include "HttpMediaCache.h"
 #include "Settings.h"
 #include "ApiSystem.h"
 #include <future> // Per std::async
@@ -29,6 +30,10 @@
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <memory>
+#include <set>
+#include <fstream>
+#include <ctime>
 
 /* 
 
@@ -38,7 +43,7 @@ GET  /caps                                                      -> capability in
 GET  /restart
 GET  /quit
 GET  /emukill
-GET  /reloadgames
+GET  /reloadgames?changed=1                                     -> changed=1 only rescans the systems whose folders or gamelists changed
 POST /messagebox												-> body must contain the message text as text/plain
 POST /notify													-> body must contain the message text as text/plain
 POST /launch													-> body must contain the exact file path as text/plain
@@ -50,6 +55,7 @@ System/Games APIS
 GET  /systems
 GET  /systems/{systemName}
 GET  /systems/{systemName}/logo
+GET  /systems/{systemName}/games?offset=&limit=&fields=&compact=	-> chunked json array, X-Total-Count header holds the number of games
 GET  /systems/{systemName}/games/{gameId}		
 POST /systems/{systemName}/games/{gameId}						-> body must contain the game metadata to save as application/json
 GET  /systems/{systemName}/games/{gameId}/media/{mediaType}
@@ -128,6 +134,154 @@ std::string HttpServerThread::getMimeType(const std::string &path)
 	return "text/plain";
 }
 
+#define GAMES_PER_CHUNK 256
+
+// Maximum time a request waits for the UI thread ( a game may be running )
+#define GAMES_UI_TIMEOUT 5000
+
+// State of a /systems/{systemName}/games response between two chunks
+// Games are only kept by position : watchers & gamelist updates can delete them while a slow client reads
+struct GameListStream
+{
+	std::string				systemName;
+	std::set<std::string>	fields;
+	size_t					position;
+	size_t					end;
+	bool					pretty;
+	bool					started;
+};
+
+// Runs func on the UI thread, where games are created & deleted, and waits for its result
+template<typename T>
+static bool runOnUiThread(Window* window, const std::function<T()>& func, T& result)
+{
+	auto promise = std::make_shared<std::promise<T>>();
+	std::future<T> future = promise->get_future();
+
+	window->postToUiThread([promise, func]() { promise->set_value(func()); });
+
+	if (future.wait_for(std::chrono::milliseconds(GAMES_UI_TIMEOUT)) != std::future_status::ready)
+		return false;
+
+	result = future.get();
+	return true;
+}
+
+#define HTTP_CACHED_FILE_MAXSIZE	(512 * 1024)
+#define HTTP_FILE_READ_SIZE			(64 * 1024)
+
+static std::string getHttpDate(time_t time)
+{
+	struct tm tm;
+#if WIN32
+	gmtime_s(&tm, &time);
+#else
+	gmtime_r(&time, &tm);
+#endif
+
+	char buffer[64];
+	strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+	return buffer;
+}
+
+// Sends a file with ETag & Last-Modified validators.
+// Answers 304 when the client copy is current, serves Range requests from disk, and keeps small files in HttpMediaCache.
+static bool sendFile(const httplib::Request& req, httplib::Response& res, const std::string& path)
+{
+	std::string filePath = ResourceManager::getInstance()->getResourcePath(path);
+	if (!Utils::FileSystem::exists(filePath) || Utils::FileSystem::isDirectory(filePath))
+		return false;
+
+	size_t size = Utils::FileSystem::getFileSize(filePath);
+	time_t time = Utils::FileSystem::getFileModificationDate(filePath).getTime();
+
+	char etagBuffer[64];
+	snprintf(etagBuffer, sizeof(etagBuffer), "\"%llx-%llx\"", (unsigned long long)size, (unsigned long long)time);
+
+	std::string etag = etagBuffer;
+	std::string lastModified = getHttpDate(time);
+
+	res.set_header("ETag", etag);
+	res.set_header("Last-Modified", lastModified);
+	res.set_header("Cache-Control", "no-cache");
+	res.set_header("Accept-Ranges", "bytes");
+
+	// If-None-Match takes precedence over If-Modified-Since
+	if (req.has_header("If-None-Match"))
+	{
+		std::string ifNoneMatch = req.get_header_value("If-None-Match");
+		if (ifNoneMatch == "*" || ifNoneMatch.find(etag) != std::string::npos)
+		{
+			res.status = 304;
+			return true;
+		}
+	}
+	else if (req.get_header_value("If-Modified-Since") == lastModified)
+	{
+		res.status = 304;
+		return true;
+	}
+
+	std::string mimeType = HttpServerThread::getMimeType(path);
+
+	if (size == 0)
+	{
+		res.set_content("", mimeType.c_str());
+		return true;
+	}
+
+	for (auto range : req.ranges)
+	{
+		if (range.first >= (ssize_t)size || (range.first == -1 && range.second == 0))
+		{
+			res.set_header("Content-Range", "bytes */" + std::to_string(size));
+			res.status = 416;
+			return true;
+		}
+	}
+
+	if (req.ranges.empty() && size <= HTTP_CACHED_FILE_MAXSIZE)
+	{
+		std::shared_ptr<std::string> data;
+		if (!HttpMediaCache::getInstance()->find(filePath, etag, data))
+		{
+			auto resource = ResourceManager::getInstance()->getFileData(filePath);
+			if (!resource.ptr)
+				return false;
+
+			data = std::make_shared<std::string>((char*)resource.ptr.get(), resource.length);
+			HttpMediaCache::getInstance()->insert(filePath, etag, data);
+		}
+
+		res.set_content(*data, mimeType.c_str());
+		return true;
+	}
+
+	// Large files ( videos, manuals ) & ranges : read from disk while sending, httplib writes the requested ranges & the 206 status
+	auto stream = std::make_shared<std::ifstream>(WINSTRINGW(filePath), std::ios::binary);
+	if (!stream->is_open())
+		return false;
+
+	res.set_content_provider(size, [stream](size_t offset, size_t length, httplib::DataSink& sink)
+	{
+		std::vector<char> buffer(std::min(length, (size_t)HTTP_FILE_READ_SIZE));
+
+		stream->clear();
+		stream->seekg(offset);
+		stream->read(buffer.data(), buffer.size());
+
+		auto read = stream->gcount();
+		if (read <= 0)
+			return false;
+
+		sink.write(buffer.data(), (size_t)read);
+		return true;
+	});
+
+	res.set_header("Content-Type", mimeType);
+	return true;
+}
+
 static bool isAllowed(const httplib::Request& req, httplib::Response& res)
 {
 	if (req.remote_addr != "127.0.0.1" && !Settings::getInstance()->getBool("PublicWebAccess"))
@@ -408,16 +562,8 @@ void HttpServerThread::run()
 			if (theme != nullptr)
 			{
 				const ThemeData::ThemeElement* elem = theme->getElement("system", "logo", "image");
-				if (elem && elem->has("path"))
-				{
-					std::string logo = elem->get<std::string>("path");
-					auto data = ResourceManager::getInstance()->getFileData(logo);
-					if (data.ptr)
-					{
-						res.set_content((char*)data.ptr.get(), data.length, getMimeType(logo).c_str());
-						return;
-					}
-				}
+				if (elem && elem->has("path") && sendFile(req, res, elem->get<std::string>("path")))
+					return;
 			}
 		}
 
@@ -425,21 +571,108 @@ void HttpServerThread::run()
 		res.status = 404;
 	});
 	
-	mHttpServer->Get(R"(/systems/(/?.*)/games)", [](const httplib::Request& req, httplib::Response& res)
+	mHttpServer->Get(R"(/systems/(/?.*)/games)", [this](const httplib::Request& req, httplib::Response& res)
 	{
 		if (!isAllowed(req, res))
 			return;
 
 		std::string systemName = req.matches[1];
-		SystemData* system = SystemData::getSystem(systemName);
-		if (system != nullptr)
+
+		// ?offset=&limit=&fields=name,path,...&compact=1
+		auto stream = std::make_shared<GameListStream>();
+		stream->systemName = systemName;
+
+		// -1 when the system doesn't exist
+		std::function<int()> countGames = [systemName]()
 		{
-			res.set_content(HttpApi::getSystemGames(system), "application/json");
+			SystemData* system = SystemData::getSystem(systemName);
+			if (system == nullptr)
+				return -1;
+
+			return (int)HttpApi::getSystemGameList(system).size();
+		};
+
+		int count = -1;
+		if (!runOnUiThread(mWindow, countGames, count))
+		{
+			res.set_content("503 service unavailable", "text/html");
+			res.status = 503;
 			return;
 		}
-		
-		res.set_content("404 system not found", "text/html");
-		res.status = 404;		
+
+		size_t total = (size_t)std::max(0, count);
+
+		if (count < 0)
+		{
+			res.set_content("404 system not found", "text/html");
+			res.status = 404;
+			return;
+		}
+
+		stream->position = req.has_param("offset") ? (size_t)std::max(0, Utils::String::toInteger(req.get_param_value("offset"))) : 0;
+		stream->position = std::min(stream->position, total);
+
+		stream->end = total;
+		if (req.has_param("limit"))
+			stream->end = std::min(total, stream->position + (size_t)std::max(0, Utils::String::toInteger(req.get_param_value("limit"))));
+
+		if (req.has_param("fields"))
+			for (auto field : Utils::String::split(req.get_param_value("fields"), ',', true))
+				stream->fields.insert(Utils::String::trim(field));
+
+		stream->pretty = !(req.has_param("compact") && req.get_param_value("compact") != "false" && req.get_param_value("compact") != "0");
+		stream->started = false;
+
+		res.set_header("X-Total-Count", std::to_string(total));
+
+		// Written GAMES_PER_CHUNK games at a time with chunked transfer, each chunk is serialized on the UI thread when the client asks for it
+		Window* window = mWindow;
+		res.set_chunked_content_provider([stream, window](size_t offset, httplib::DataSink& sink)
+		{
+			std::string chunk = stream->started ? "" : "[";
+			stream->started = true;
+
+			if (stream->position < stream->end)
+			{
+				size_t from = stream->position;
+				size_t to = std::min(stream->end, from + GAMES_PER_CHUNK);
+
+				std::function<std::string()> serialize = [stream, from, to]()
+				{
+					SystemData* system = SystemData::getSystem(stream->systemName);
+					if (system == nullptr)
+						return std::string();
+
+					return HttpApi::getGamesJson(HttpApi::getSystemGameList(system), from, to, stream->fields, stream->pretty);
+				};
+
+				std::string games;
+				if (!runOnUiThread(window, serialize, games))
+					return false;
+
+				stream->position = to;
+
+				// Games removed since the request started : the listing ends early
+				if (games.empty())
+					stream->position = stream->end;
+				else
+				{
+					if (chunk.empty())
+						chunk = ",";
+
+					chunk += games;
+					sink.write(chunk.data(), chunk.size());
+					return true;
+				}
+			}
+
+			chunk += "]";
+			sink.write(chunk.data(), chunk.size());
+			sink.done();
+			return true;
+		});
+
+		res.set_header("Content-Type", "application/json");
 	});
 
 	mHttpServer->Get(R"(/systems/(/?.*)/games/(/?.*)/media/(/?.*))", [](const httplib::Request& req, httplib::Response& res)
@@ -460,17 +693,8 @@ void HttpServerThread::run()
 				if (game->getMetadata().getType(metadataName) == MD_PATH)
 				{
 					std::string path = game->getMetadata().get(metadataName);
-					if (!path.empty())
-					{
-						auto data = ResourceManager::getInstance()->getFileData(path);
-						if (data.ptr)
-						{
-							res.set_content((char*)data.ptr.get(), data.length, getMimeType(path).c_str());
-							return;
-						}
-
+					if (!path.empty() && sendFile(req, res, path))
 						return;
-					}
 				}
 			}
 		}
@@ -610,10 +834,12 @@ void HttpServerThread::run()
 		if (!isAllowed(req, res))
 			return;
 
+		bool changedOnly = req.has_param("changed") && req.get_param_value("changed") != "0";
+
 		Window* w = mWindow;
-		mWindow->postToUiThread([w]()
+		mWindow->postToUiThread([w, changedOnly]()
 		{
-			GuiMenu::updateGameLists(w, false);
+			GuiMenu::updateGameLists(w, false, changedOnly);
 		});
 	});
 
@@ -835,10 +1061,7 @@ void HttpServerThread::run()
 			return;
 
 		std::string url = req.matches[1];
-		auto data = ResourceManager::getInstance()->getFileData(":/" + url);
-		if (data.ptr)
-			res.set_content((char*)data.ptr.get(), data.length, getMimeType(url).c_str());
-		else
+		if (!sendFile(req, res, ":/" + url))
 		{
 			res.set_content("404 not found", "text/html");
 			res.status = 404;
@@ -32,6 +32,8 @@
 #include "VolumeControl.h"
 #include "guis/GuiNetPlay.h"
 #include "MusicStartupHelper.h"
+#include "RomFolderWatcher.h"
+#include "VideoProbeCache.h"
 
 ViewController* ViewController::sInstance = nullptr;
 
@@ -293,6 +295,17 @@ void ViewController::goToGameList(SystemData* system, bool forceImmediate)
 
 	std::shared_ptr<IGameListView> view = getGameListView(destinationSystem);
 
+	// Video sizes are probed in the background, players won't wait for the media parser
+	std::vector<std::string> videos;
+	for (auto game : destinationSystem->getRootFolder()->getFilesRecursive(GAME, true))
+	{
+		std::string video = game->getMetadata(MetaDataId::Video);
+		if (!video.empty())
+			videos.push_back(video);
+	}
+
+	VideoProbeCache::getInstance()->prefetch(videos);
+
 
 	if (mState.viewing == SYSTEM_SELECT)
 	{
@@ -972,6 +985,9 @@ void ViewController::update(int deltaTime)
 
 	updateSelf(deltaTime);
 
+	if (mWindow->peekGui() == this && !mWindow->isScreenSaverActive())
+		SystemData::deleteDetachedFiles();
+
 	if (mDeferPlayViewTransitionTo != nullptr)
 	{
 		if (mCurrentView)
@@ -1398,8 +1414,13 @@ void ViewController::reloadAllGames(Window* window, bool deleteCurrentGui, bool
 
 	ViewController::init(window);
 	
+	FileSorts::clearFileCache();
 	CollectionSystemManager::init(window);		
 	SystemData::loadConfig(window);
+
+	RomFolderWatcher* watcher = WatchersManager::GetComponent<RomFolderWatcher>();
+	if (watcher != nullptr)
+		watcher->updateSystems();
 	
 	ViewController::get()->goToSystemView(systemName, true, viewMode);	
 	ViewController::get()->reloadAll(nullptr, false); // Avoid reloading themes a second time
@@ -1408,6 +1429,123 @@ void ViewController::reloadAllGames(Window* window, bool deleteCurrentGui, bool
 	window->pushGui(ViewController::get());
 }
 
+void ViewController::reloadChangedGames(Window* window, bool doCallExternalTriggers)
+{
+	if (sInstance == nullptr)
+		return;
+
+	// call external triggers
+	if (doCallExternalTriggers && ApiSystem::getInstance()->isScriptingSupported(ApiSystem::BATOCERAPREGAMELISTSHOOK))
+		ApiSystem::getInstance()->callBatoceraPreGameListsHook();
+
+	if (!applyChangedGames())
+		reloadAllGames(window, true, false);
+}
+
+bool ViewController::applyChangedGames()
+{
+	StopWatch stopWatch("ViewController::applyChangedGames", LogDebug);
+
+	Utils::FileSystem::FileSystemCacheActivator fsc;
+
+	if (SystemData::hasEmptySystemChanged())
+		return false;
+
+	std::vector<SystemData*> changedSystems;
+
+	for (auto system : SystemData::sSystemVector)
+	{
+		if (system->isCollection() || system->isGroupSystem() || !system->isGameSystem() || system->isStoreSystem())
+			continue;
+
+		if (!system->hasFolderContentChanged() && !system->hasGamelistChanged())
+			continue;
+
+		// Group views hold copies of the child root folders
+		if (system->isGroupChildSystem())
+			return false;
+
+		changedSystems.push_back(system);
+	}
+
+	if (changedSystems.size() == 0)
+		return true;
+
+	// Load everything before touching the live systems : nothing is changed if a full reload is needed
+	std::vector<SystemData*> sources;
+
+	for (auto system : changedSystems)
+	{
+		SystemData* source = SystemData::loadSystem(system->getName(), false);
+		if (source == nullptr || (source->getRootFolder()->getChildren().size() == 0 && !UIModeController::LoadEmptySystems()))
+		{
+			delete source;
+
+			for (auto loaded : sources)
+				delete loaded;
+
+			return false;
+		}
+
+		sources.push_back(source);
+	}
+
+	for (size_t i = 0; i < changedSystems.size(); i++)
+	{
+		SystemData* system = changedSystems[i];
+		SystemData* source = sources[i];
+
+		std::vector<FileData*> addedGames;
+		std::vector<FileData*> changedGames;
+		std::vector<FileData*> removedFiles;
+
+		bool changed = system->mergeContent(source, addedGames, changedGames, removedFiles);
+
+		delete source;
+		system->updateContentFingerprint();
+
+		if (changed)
+			applyGameChanges(system, addedGames, changedGames, removedFiles);
+	}
+
+	return true;
+}
+
+void ViewController::applyGameChanges(SystemData* system, std::vector<FileData*>& addedGames, std::vector<FileData*>& changedGames, std::vector<FileData*>& removedFiles)
+{
+	if (sInstance == nullptr)
+		return;
+
+	LOG(LogInfo) << "ViewController::applyGameChanges : " << system->getName() << " " << addedGames.size() << " added, " << changedGames.size() << " changed, " << removedFiles.size() << " removed";
+
+	FileSorts::clearFileCache();
+
+	for (auto file : removedFiles)
+	{
+		if (file->getType() == GAME)
+			CollectionSystemManager::get()->deleteCollectionFiles(file, false);
+		else
+			for (auto game : ((FolderData*)file)->getFilesRecursive(GAME))
+				CollectionSystemManager::get()->deleteCollectionFiles(game, false);
+	}
+
+	for (auto file : addedGames)
+		CollectionSystemManager::get()->refreshCollectionSystems(file);
+
+	for (auto file : changedGames)
+		CollectionSystemManager::get()->refreshCollectionSystems(file);
+
+	// Keeps the cursor on the same game
+	IGameListView* view = sInstance->getGameListView(system, false).get();
+	if (view != nullptr)
+		sInstance->reloadGameListView(view);
+	else
+		system->updateDisplayedGameCount();
+
+	// Game options, metadata editor or screensaver may still point to them : deleted by update() once the game lists are back on top
+	system->addDetachedFiles(removedFiles);
+}
+
 void ViewController::setActiveView(std::shared_ptr<GuiComponent> view)
 {
 	if (mCurrentView != nullptr)
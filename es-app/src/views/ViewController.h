@@ -115,6 +115,10 @@ public:
 	ViewMode getViewMode();
 
 	static void reloadAllGames(Window* window, bool deleteCurrentGui = false, bool doCallExternalTriggers = false);
+	// Rescans only the systems whose roms or gamelist changed and updates their views in place. Falls back to reloadAllGames when systems appear or disappear
+	static void reloadChangedGames(Window* window, bool doCallExternalTriggers = false);
+	// Updates collections & the game list view after games were added, changed or detached. Detached files are deleted once no GUI is open
+	static void applyGameChanges(SystemData* system, std::vector<FileData*>& addedGames, std::vector<FileData*>& changedGames, std::vector<FileData*>& removedFiles);
 
 	void setActiveView(std::shared_ptr<GuiComponent> view);
 	
@@ -123,6 +127,8 @@ public:
 private:
 	ViewController(Window* window);
 	static ViewController* sInstance;
+
+	static bool applyChangedGames();
 	
 	std::future<void> mEpicUpdateFuture;          
     std::set<SystemData*> mSystemsCheckedForUpdate;
@@ -76,6 +76,8 @@ void BasicGameListView::populateList(const std::vector<FileData*>& files)
 		for (auto file : files)		
 			mList.add(formatter.getDisplayName(file), file, file->getType() == FOLDER);
 
+		mList.prewarmGlyphs();
+
 		// if we have the ".." PLACEHOLDER, then select the first game instead of the placeholder
 		if (showParentFolder && mCursorStack.size() && mList.size() > 1 && mList.getCursorIndex() == 0)
 			mList.setCursorIndex(1);
@@ -12,6 +12,10 @@
 #include "SystemConf.h"
 #include "utils/MathExpr.h"
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 BindableProperty BindableProperty::Null;
 BindableProperty BindableProperty::EmptyString("", BindablePropertyType::String);
 
@@ -100,31 +104,162 @@ static SettingsBinding settingsBinding;
 // BindingManager
 /////////////////////////////////////////////////////////////////////////////////////////////
 
-void BindingManager::bindValues(IBindable* current, std::string& xp, bool showDefaultText, std::string& evaluableExpression)
+struct BindingManager::CompiledBinding
+{
+	struct Segment
+	{
+		Segment(const std::string& value) : text(value), placeholder(false) { }
+
+		std::string					text;	// Literal text, or the whole {type:name} placeholder
+		bool						placeholder;
+		std::string					type;
+		std::vector<std::string>	path;	// {game:system:name} -> system, name
+	};
+
+	std::string				source;
+	std::vector<Segment>	segments;
+	bool					uniqueVariable;
+	bool					pure;	// No method reading files, time or locale : results can be memoized
+};
+
+std::shared_ptr<BindingManager::CompiledBinding> BindingManager::compile(const std::string& xp)
 {
-	std::string typeName = current->getBindableTypeName();
+	static std::mutex lock;
+	static std::unordered_map<std::string, std::shared_ptr<CompiledBinding>> compiled;
+
+	std::unique_lock<std::mutex> guard(lock);
+
+	auto it = compiled.find(xp);
+	if (it != compiled.cend())
+		return it->second;
+
+	auto binding = std::make_shared<CompiledBinding>();
+	binding->source = xp;
+	binding->uniqueVariable = !xp.empty() && xp[0] == '{' && xp[xp.size() - 1] == '}' && Utils::String::occurs(xp, '{') == 1;
+
+	std::string expression = Utils::String::replace(xp, "{binding:", "{system:"); // Retrocompatibility for old {binding: which is {system
+	expression = Utils::String::replace(expression, "{collection:", "{game:collection:"); // Retrocompatibility for old {binding: which is {system
 
-	for (auto name : Utils::String::extractStrings(xp, "{" + typeName + ":", "}"))
+	std::string literal;
+
+	size_t pos = 0;
+	while (pos < expression.size())
 	{
-		std::string dataAsString;
-		std::string dataAsEvaluable;
+		size_t colon = expression[pos] == '{' ? expression.find_first_of(":{}\"' ", pos + 1) : std::string::npos;
+		size_t end = colon != std::string::npos && expression[colon] == ':' && colon > pos + 1 ? expression.find('}', colon + 1) : std::string::npos;
+
+		if (end == std::string::npos || end == colon + 1)
+		{
+			literal += expression[pos++];
+			continue;
+		}
+
+		if (!literal.empty())
+		{
+			binding->segments.push_back(CompiledBinding::Segment(literal));
+			literal.clear();
+		}
+
+		CompiledBinding::Segment segment(expression.substr(pos, end - pos + 1));
+		segment.placeholder = true;
+		segment.type = expression.substr(pos + 1, colon - pos - 1);
+		segment.path = Utils::String::split(expression.substr(colon + 1, end - colon - 1), ':', true);
+		binding->segments.push_back(segment);
+
+		pos = end + 1;
+	}
+
+	if (!literal.empty())
+		binding->segments.push_back(CompiledBinding::Segment(literal));
+
+	static const char* impureMethods[] = { "exists(", "isdirectory(", "filesize", "firstfile(", "elapsed(", "time(", "date(", "translate(", "default(" };
+
+	std::string lower = Utils::String::toLower(expression);
+
+	binding->pure = true;
+	for (auto method : impureMethods)
+		if (lower.find(method) != std::string::npos)
+			binding->pure = false;
+
+	compiled[xp] = binding;
+	return binding;
+}
+
+const BindingManager::BindableChain& BindingManager::getGlobalChain()
+{
+	static BindableChain chain = []()
+	{
+		BindableChain ret;
+		for (IBindable* current : { (IBindable*) &globalBinding, (IBindable*) &settingsBinding })
+			ret.push_back(std::pair<std::string, IBindable*>(current->getBindableTypeName(), current));
+
+		return ret;
+	}();
+
+	return chain;
+}
+
+BindingManager::BindableChain BindingManager::getBindableChain(IBindable* bindable)
+{
+	BindableChain chain;
 
-		IBindable* root = current;
-		std::string propertyName = name;
+	// Without bindable, only global & settings placeholders are resolved ( see bindValues )
+	if (bindable == nullptr)
+		return chain;
+
+	for (IBindable* current = bindable; current != nullptr; current = current->getBindableParent())
+		chain.push_back(std::pair<std::string, IBindable*>(current->getBindableTypeName(), current));
+
+	for (auto& scope : getGlobalChain())
+		chain.push_back(scope);
+
+	return chain;
+}
+
+std::string BindingManager::bindValues(const CompiledBinding& binding, const BindableChain& chain, bool showDefaultText, std::string& evaluableExpression)
+{
+	std::string xp;
+
+	// Without bindable, the other placeholders are removed from the text
+	bool unbound = chain.empty();
+	const BindableChain& scopes = unbound ? getGlobalChain() : chain;
+
+	evaluableExpression.clear();
 
-		for (auto propName : Utils::String::split(name, ':', true))
+	for (auto& segment : binding.segments)
+	{
+		auto scope = segment.placeholder ? std::find_if(scopes.cbegin(), scopes.cend(), [&segment](const std::pair<std::string, IBindable*>& item) { return item.first == segment.type; }) : scopes.cend();
+		if (scope == scopes.cend())
 		{
-			propertyName = propName;
+			if (!unbound || !segment.placeholder)
+				xp += segment.text;
+
+			evaluableExpression += segment.text;
+			continue;
+		}
+
+		IBindable* root = scope->second;
+		BindableProperty value;
 
-			auto value = root->getProperty(propName);
+		bool resolved = false;
+		for (auto& propName : segment.path)
+		{
+			value = root->getProperty(propName);
 			if (value.type != BindablePropertyType::Bindable || value.bindable == nullptr)
+			{
+				resolved = true;
 				break;
+			}
 
-			propertyName = "name"; // use default "name" property for IBinding if not property specified later
 			root = value.bindable;
 		}
 
-		auto value = root->getProperty(propertyName);
+		if (!resolved)
+			value = root->getProperty("name"); // use default "name" property for IBinding if not property specified later
+
+		std::string dataAsString;
+		std::string dataAsEvaluable;
+
 		switch (value.type)
 		{
 		case BindablePropertyType::String:
@@ -149,47 +284,49 @@ void BindingManager::bindValues(IBindable* current, std::string& xp, bool showDe
 		if (showDefaultText && value.type != BindablePropertyType::Path)
 			dataAsString = dataAsString.empty() ? _("Unknown") : dataAsString == "0" ? _("None") : dataAsString;
 
-		xp = Utils::String::replace(xp, "{" + typeName + ":" + name + "}", dataAsString);
-		evaluableExpression = Utils::String::replace(evaluableExpression, "{" + typeName + ":" + name + "}", dataAsEvaluable);
+		xp += dataAsString;
+		evaluableExpression += dataAsEvaluable;
 	}
+
+	return xp;
 }
 
-std::string BindingManager::updateBoundExpression(std::string& xp, IBindable* bindable, bool showDefaultText)
+Utils::MathExpr::Value BindingManager::evaluate(const CompiledBinding& binding, const std::string& evaluableExpression)
 {
-	std::string evaluableExpression = xp;
+	if (!binding.pure)
+		return Utils::MathExpr::evaluate(evaluableExpression.c_str());
+
+	static std::mutex lock;
+	static std::unordered_map<std::string, Utils::MathExpr::Value> results;
 
-	if (bindable == nullptr)
 	{
-		for (auto name : Utils::String::extractStrings(xp, "{", "}"))
-			if (name.find(":") != std::string::npos)
-				xp = Utils::String::replace(xp, "{" + name + "}", "");
+		std::unique_lock<std::mutex> guard(lock);
+
+		auto it = results.find(evaluableExpression);
+		if (it != results.cend())
+			return it->second;
 	}
-	else
-	{
-		xp = Utils::String::replace(xp, "{binding:", "{system:"); // Retrocompatibility for old {binding: which is {system
-		xp = Utils::String::replace(xp, "{collection:", "{game:collection:"); // Retrocompatibility for old {binding: which is {system
-		evaluableExpression = xp;
 
-		IBindable* current = bindable;
+	// Exceptions are not memoized, they are logged by the callers
+	auto ret = Utils::MathExpr::evaluate(evaluableExpression.c_str());
+
+	std::unique_lock<std::mutex> guard(lock);
 
-		while (current != nullptr)
-		{
-			bindValues(current, xp, showDefaultText, evaluableExpression);
-			current = current->getBindableParent();
-		}
-	}
+	if (results.size() >= 4096)
+		results.clear();
 
-	bindValues(&globalBinding, xp, showDefaultText, evaluableExpression);
-	bindValues(&settingsBinding, xp, showDefaultText, evaluableExpression);
-	
-	return evaluableExpression;
+	results[evaluableExpression] = ret;
+	return ret;
 }
 
 std::string   BindingManager::evaluateBindableExpression(const std::string& xp, IBindable* bindable)
 {
-	std::string val = xp;
-	std::string evaluableExpression = BindingManager::updateBoundExpression(val, bindable, false);
-	auto ret = Utils::MathExpr::evaluate(evaluableExpression.c_str());
+	auto binding = compile(xp);
+
+	std::string evaluableExpression;
+	bindValues(*binding, getBindableChain(bindable), false, evaluableExpression);
+
+	auto ret = evaluate(*binding, evaluableExpression);
 
 	if (ret.type == Utils::MathExpr::STRING)
 		return ret.string;
@@ -208,22 +345,25 @@ void BindingManager::updateBindings(GuiComponent* comp, IBindable* bindable, boo
 	TextComponent* text = dynamic_cast<TextComponent*>(comp);	
 	bool showDefaultText = text != nullptr && text->getBindingDefaults();
 
-	auto expressions = comp->getBindingExpressions();
-	for (auto expression : expressions)
+	BindableChain chain = getBindableChain(bindable);
+
+	auto& expressions = comp->getBindingExpressions();
+	for (auto& expression : expressions)
 	{
-		std::string xp = expression.second;
-		if (xp.empty())
+		if (expression.second.empty())
 			continue;
 		
-		std::string propertyName = expression.first;
+		const std::string& propertyName = expression.first;
 
 		auto existing = comp->getProperty(propertyName);
 		if (existing.type == ThemeData::ThemeElement::Property::PropertyType::Unknown)
 			continue;
 
-		bool uniqueVariable = xp[0] == '{' && xp[xp.size() - 1] == '}' && Utils::String::occurs(xp, '{') == 1;
+		auto binding = compile(expression.second);
+		bool uniqueVariable = binding->uniqueVariable;
 
-		std::string evaluableExpression = updateBoundExpression(xp, bindable, text != nullptr && (text->getBindingDefaults() || showDefaultText));
+		std::string evaluableExpression;
+		std::string xp = bindValues(*binding, chain, showDefaultText, evaluableExpression);
 		
 		switch (existing.type)
 		{
@@ -233,7 +373,7 @@ void BindingManager::updateBindings(GuiComponent* comp, IBindable* bindable, boo
 			{
 				try
 				{
-					auto ret = Utils::MathExpr::evaluate(evaluableExpression.c_str());
+					auto ret = evaluate(*binding, evaluableExpression);
 					if (ret.type == Utils::MathExpr::STRING)
 						xp = ret.string;
 					else if (ret.type == Utils::MathExpr::NUMBER)
@@ -259,7 +399,7 @@ void BindingManager::updateBindings(GuiComponent* comp, IBindable* bindable, boo
 				{
 					try
 					{
-						auto ret = Utils::MathExpr::evaluate(evaluableExpression.c_str());
+						auto ret = evaluate(*binding, evaluableExpression);
 						if (ret.type == Utils::MathExpr::NUMBER)
 							value = (int)ret.number;
 					}
@@ -285,7 +425,7 @@ void BindingManager::updateBindings(GuiComponent* comp, IBindable* bindable, boo
 				{
 					try
 					{
-						auto ret = Utils::MathExpr::evaluate(evaluableExpression.c_str());
+						auto ret = evaluate(*binding, evaluableExpression);
 						if (ret.type == Utils::MathExpr::NUMBER)
 							value = ret.number;
 					}
@@ -316,7 +456,7 @@ void BindingManager::updateBindings(GuiComponent* comp, IBindable* bindable, boo
 				{
 					try
 					{
-						auto ret = Utils::MathExpr::evaluate(evaluableExpression.c_str());
+						auto ret = evaluate(*binding, evaluableExpression);
 						if (ret.type == Utils::MathExpr::NUMBER)
 							value = (ret.number != 0);
 					}
@@ -345,8 +485,10 @@ void BindingManager::updateBindings(GuiComponent* comp, IBindable* bindable, boo
 			if (anim->enabledExpression.empty())
 				continue;
 			
-			std::string xp = anim->enabledExpression;
-			std::string evaluableExpression = updateBoundExpression(xp, bindable, text != nullptr && showDefaultText);
+			auto binding = compile(anim->enabledExpression);
+
+			std::string evaluableExpression;
+			bindValues(*binding, chain, showDefaultText, evaluableExpression);
 			
 			bool value = false;
 
@@ -354,7 +496,7 @@ void BindingManager::updateBindings(GuiComponent* comp, IBindable* bindable, boo
 			{
 				try
 				{
-					auto ret = Utils::MathExpr::evaluate(evaluableExpression.c_str());
+					auto ret = evaluate(*binding, evaluableExpression);
 					if (ret.type == Utils::MathExpr::NUMBER)
 						value = (ret.number != 0);
 				}
@@ -4,6 +4,8 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include "utils/MathExpr.h"
 
 class GuiComponent;
 class IBindable;
@@ -106,11 +108,19 @@ class BindingManager
 {
 public:
 	static void          updateBindings(GuiComponent* comp, IBindable* system, bool recursive = true);
-       static std::string evaluateBindableExpression(const std::string& xp, IBindable* bindable);
+	static std::string   evaluateBindableExpression(const std::string& xp, IBindable* bindable);
 
 private:
-	static void          bindValues(IBindable* current, std::string& xp, bool showDefaultText, std::string& evaluableExpression);
-	static std::string   updateBoundExpression(std::string& xp, IBindable* bindable, bool showDefaultText);
+	// Expression parsed once into literal text & {type:property} placeholders, shared by all components using it
+	struct CompiledBinding;
+	typedef std::vector<std::pair<std::string, IBindable*>> BindableChain;
+
+	static std::shared_ptr<CompiledBinding> compile(const std::string& xp);
+	static BindableChain getBindableChain(IBindable* bindable);
+	static const BindableChain& getGlobalChain();
+
+	static std::string   bindValues(const CompiledBinding& binding, const BindableChain& chain, bool showDefaultText, std::string& evaluableExpression);
+	static Utils::MathExpr::Value evaluate(const CompiledBinding& binding, const std::string& evaluableExpression);
 };
 
 #endif
@@ -0,0 +1,221 @@
+#include "FileHashCache.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "Paths.h"
+#include "Log.h"
+
+#include <fstream>
+
+static FILE* openFile(const std::string& path, const char* mode)
+{
+#if defined(_WIN32)
+	return _wfopen(Utils::String::convertToWideString(path).c_str(), Utils::String::convertToWideString(mode).c_str());
+#else
+	return fopen(path.c_str(), mode);
+#endif
+}
+
+// Files extracted from archives are deleted right after hashing : another inner file may later get the same path, size & time
+static bool isTemporaryPath(const std::string& path)
+{
+	return Utils::String::startsWith(path, Utils::FileSystem::getTempPath());
+}
+
+FileHashCache* FileHashCache::getInstance()
+{
+	static FileHashCache instance;
+	return &instance;
+}
+
+FileHashCache::FileHashCache() : mFile(nullptr), mLines(0), mMaxReaders(0), mReaders(0)
+{
+	mPath = Paths::getUserEmulationStationPath() + "/filehashes.cache";
+	load();
+}
+
+FileHashCache::~FileHashCache()
+{
+	if (mFile != nullptr)
+		fclose(mFile);
+}
+
+void FileHashCache::load()
+{
+	std::ifstream file(WINSTRINGW(mPath));
+	if (!file.is_open())
+		return;
+
+	// kind|size|time|hash|path
+	std::string line;
+	while (std::getline(file, line))
+	{
+		mLines++;
+
+		std::vector<std::string> parts;
+
+		size_t start = 0;
+		while (parts.size() < 4)
+		{
+			size_t end = line.find('|', start);
+			if (end == std::string::npos)
+				break;
+
+			parts.push_back(line.substr(start, end - start));
+			start = end + 1;
+		}
+
+		if (parts.size() < 4 || start >= line.size())
+			continue;
+
+		Entry entry;
+		entry.size = strtoull(parts[1].c_str(), nullptr, 10);
+		entry.time = (time_t) strtoll(parts[2].c_str(), nullptr, 10);
+		entry.hash = parts[3];
+
+		// Last line for a file wins
+		mEntries[parts[0] + "|" + line.substr(start)] = entry;
+	}
+
+	file.close();
+
+	// Rehashed files leave stale lines behind
+	if (mLines > mEntries.size() * 2 + 256)
+		save();
+}
+
+void FileHashCache::save()
+{
+	if (mFile != nullptr)
+	{
+		fclose(mFile);
+		mFile = nullptr;
+	}
+
+	std::string tmpPath = mPath + ".tmp";
+
+	FILE* file = openFile(tmpPath, "wb");
+	if (file == nullptr)
+		return;
+
+	for (auto& item : mEntries)
+	{
+		size_t pos = item.first.find('|');
+		fprintf(file, "%s|%llu|%lld|%s|%s\n", item.first.substr(0, pos).c_str(), item.second.size, (long long) item.second.time, item.second.hash.c_str(), item.first.substr(pos + 1).c_str());
+	}
+
+	fclose(file);
+
+	Utils::FileSystem::renameFile(tmpPath, mPath);
+	mLines = mEntries.size();
+}
+
+bool FileHashCache::getFileInfo(const std::string& path, unsigned long long& size, time_t& time)
+{
+	if (!Utils::FileSystem::exists(path))
+		return false;
+
+	size = Utils::FileSystem::getFileSize(path);
+	time = Utils::FileSystem::getFileModificationDate(path).getTime();
+	return true;
+}
+
+bool FileHashCache::find(const std::string& kind, const std::string& path, std::string& hash)
+{
+	unsigned long long size;
+	time_t time;
+
+	if (isTemporaryPath(path) || !getFileInfo(path, size, time))
+		return false;
+
+	std::unique_lock<std::mutex> lock(mLock);
+
+	auto it = mEntries.find(kind + "|" + path);
+	if (it == mEntries.cend() || it->second.size != size || it->second.time != time)
+		return false;
+
+	hash = it->second.hash;
+	return true;
+}
+
+void FileHashCache::update(const std::string& kind, const std::string& path, const std::string& hash)
+{
+	if (hash.empty() || isTemporaryPath(path))
+		return;
+
+	Entry entry;
+	entry.hash = hash;
+
+	if (!getFileInfo(path, entry.size, entry.time))
+		return;
+
+	std::unique_lock<std::mutex> lock(mLock);
+	mEntries[kind + "|" + path] = entry;
+
+	if (mFile == nullptr)
+	{
+		mFile = openFile(mPath, "ab");
+		if (mFile == nullptr)
+			return;
+	}
+
+	fprintf(mFile, "%s|%llu|%lld|%s|%s\n", kind.c_str(), entry.size, (long long)entry.time, hash.c_str(), path.c_str());
+	fflush(mFile);
+
+	mLines++;
+}
+
+void FileHashCache::setMaxReaders(int count)
+{
+	std::unique_lock<std::mutex> lock(mReadersLock);
+	mMaxReaders = count;
+	mReadersChanged.notify_all();
+}
+
+bool FileHashCache::computeFileHashes(const std::string& path, std::string* crc32, std::string* md5)
+{
+	{
+		std::unique_lock<std::mutex> lock(mReadersLock);
+		mReadersChanged.wait(lock, [this] { return mMaxReaders <= 0 || mReaders < mMaxReaders; });
+		mReaders++;
+	}
+
+	bool ret = Utils::FileSystem::getFileHashes(path, crc32, md5);
+
+	{
+		std::unique_lock<std::mutex> lock(mReadersLock);
+		mReaders--;
+	}
+
+	mReadersChanged.notify_one();
+
+	if (!ret)
+		return false;
+
+	if (crc32 != nullptr)
+		update("crc32", path, *crc32);
+
+	if (md5 != nullptr)
+		update("md5", path, *md5);
+
+	return true;
+}
+
+std::string FileHashCache::getFileCrc32(const std::string& path)
+{
+	// Without md5, the read stops at the size RetroArch uses for CRC32
+	std::string crc32;
+	if (find("crc32", path, crc32) || computeFileHashes(path, &crc32, nullptr))
+		return crc32;
+
+	return "";
+}
+
+std::string FileHashCache::getFileMd5(const std::string& path)
+{
+	std::string crc32, md5;
+	if (find("md5", path, md5) || computeFileHashes(path, &crc32, &md5))
+		return md5;
+
+	return "";
+}
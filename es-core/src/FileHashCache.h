@@ -0,0 +1,60 @@
+#pragma once
+#ifndef ES_CORE_FILE_HASH_CACHE_H
+#define ES_CORE_FILE_HASH_CACHE_H
+
+#include <string>
+#include <unordered_map>
+#include <condition_variable>
+#include <mutex>
+#include <cstdio>
+
+//
+// Hashes computed in previous runs ( filehashes.cache ), keyed by kind ( crc32, md5... ), path, size & modification time.
+// Results are appended to the file as soon as they are known : an interrupted hashing session resumes where it stopped.
+//
+class FileHashCache
+{
+public:
+	static FileHashCache* getInstance();
+
+	bool find(const std::string& kind, const std::string& path, std::string& hash);
+	void update(const std::string& kind, const std::string& path, const std::string& hash);
+
+	// getFileMd5 reads the whole file & caches its CRC32 too. getFileCrc32 only reads the part RetroArch hashes.
+	// Files of the temp folder ( archive contents ) are never cached
+	std::string getFileCrc32(const std::string& path);
+	std::string getFileMd5(const std::string& path);
+
+	// Number of files read at the same time by getFileCrc32/getFileMd5, 0 for no limit
+	void setMaxReaders(int count);
+
+private:
+	FileHashCache();
+	~FileHashCache();
+
+	struct Entry
+	{
+		unsigned long long	size;
+		time_t				time;
+		std::string			hash;
+	};
+
+	bool getFileInfo(const std::string& path, unsigned long long& size, time_t& time);
+	bool computeFileHashes(const std::string& path, std::string* crc32, std::string* md5); // nullptr to skip one
+
+	void load();
+	void save();
+
+	std::string							   mPath;
+	std::unordered_map<std::string, Entry> mEntries;
+	std::mutex							   mLock;
+	FILE*								   mFile;
+	size_t								   mLines;
+
+	std::mutex							   mReadersLock;
+	std::condition_variable				   mReadersChanged;
+	int									   mMaxReaders;
+	int									   mReaders;
+};
+
+#endif // ES_CORE_FILE_HASH_CACHE_H
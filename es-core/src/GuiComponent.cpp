@@ -16,11 +16,13 @@
 #include "BindingManager.h"
 
 bool GuiComponent::isLaunchTransitionRunning = false;
+std::atomic<unsigned int> GuiComponent::sBindingExpressionsVersion(0);
 
 GuiComponent::GuiComponent(Window* window) : mWindow(window), mParent(NULL), mOpacity(255), mAmbientOpacity(255),
 	mPosition(Vector3f::Zero()), mOrigin(Vector2f::Zero()), mRotationOrigin(0.5, 0.5), mScaleOrigin(0.5f, 0.5f), mSourceBounds(Vector4f::Zero()),
 	mSize(Vector2f::Zero()), mTransform(Transform4x4f::Identity()), mVisible(true), mShowing(false), mPadding(Vector4f(0, 0, 0, 0)), mClipChildren(false),
-	mExtraType(ExtraType::BUILTIN), mStoryboardAnimator(nullptr), mScreenOffset(0.0f), mTransformDirty(true), mIsMouseOver(false), mMousePressed(false), mChildZIndexDirty(false)
+	mExtraType(ExtraType::BUILTIN), mStoryboardAnimator(nullptr), mScreenOffset(0.0f), mTransformDirty(true), mIsMouseOver(false), mMousePressed(false), mChildZIndexDirty(false),
+	mBindingOrderVersion(0)
 {
 	mClipRect = Vector4f();
 }
@@ -897,8 +899,13 @@ void GuiComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std
 		setClickAction("");
 
 	for (auto prop : elem->properties)
+	{
 		if (prop.second.type == ThemeData::ThemeElement::Property::PropertyType::String && Utils::String::endsWith(prop.first, "_binding"))
+		{
 			mBindingExpressions[Utils::String::replace(prop.first, "_binding", "")] = prop.second.s;
+			sBindingExpressionsVersion++;
+		}
+	}
 
 	applyStoryboard(elem);
 	loadThemedChildren(elem);
@@ -968,6 +975,12 @@ void GuiComponent::onScreenSaverDeactivate()
 		child->onScreenSaverDeactivate();
 }
 
+void GuiComponent::setLoadPriority(int priority)
+{
+	for (auto child : mChildren)
+		child->setLoadPriority(priority);
+}
+
 void GuiComponent::topWindow(bool isTop)
 {
 	for (auto child : mChildren)
@@ -1456,7 +1469,7 @@ static void visit(const std::vector<GuiComponent*>& items, const std::string& it
 		GuiComponent* comp = *itemIt;
 		visited[comp] = true;
 
-		for (auto expression : comp->getBindingExpressions())
+		for (auto& expression : comp->getBindingExpressions())
 		{
 			for (auto name : Utils::String::extractStrings(expression.second, "{", ":"))
 			{
@@ -1482,15 +1495,23 @@ void GuiComponent::updateBindings(IBindable* bindable)
 	auto recursiveExtraChildrens = enumerateExtraChildrens();
 
 	// Sort items by inter-dependency -> The ones that references another one are last
-	std::vector<GuiComponent*> sortedItems;
-	std::unordered_map<GuiComponent*, bool> visited;
+	// The order only changes with the visible extras or with the theme, keep it between selections
+	if (mBindingOrderVersion != sBindingExpressionsVersion || mBindingOrderSource != recursiveExtraChildrens)
+	{
+		std::vector<GuiComponent*> sortedItems;
+		std::unordered_map<GuiComponent*, bool> visited;
 
-	for (auto child : recursiveExtraChildrens)
-		visit(recursiveExtraChildrens, child->getTag(), sortedItems, visited);
+		for (auto child : recursiveExtraChildrens)
+			visit(recursiveExtraChildrens, child->getTag(), sortedItems, visited);
+
+		mBindingOrder = sortedItems;
+		mBindingOrderSource = recursiveExtraChildrens;
+		mBindingOrderVersion = sBindingExpressionsVersion;
+	}
 
 	bool hasStackPanel = false;
 
-	for (auto child : sortedItems) // recursiveExtraChildrens
+	for (auto child : mBindingOrder) // recursiveExtraChildrens
 	{
 		hasStackPanel |= child->getThemeTypeName() == "stackpanel";
 		BindingManager::updateBindings(child, bindable, false);
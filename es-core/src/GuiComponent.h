@@ -10,6 +10,7 @@
 #include <functional>
 #include "ThemeData.h"
 #include <memory>
+#include <atomic>
 #include "anim/ThemeStoryboard.h"
 
 class Animation;
@@ -189,7 +190,7 @@ public:
 	void			setClickAction(const std::string& action) { mClickAction = action; }
 
 	// Bindings
-	std::map<std::string, std::string> getBindingExpressions() { return mBindingExpressions; }
+	const std::map<std::string, std::string>& getBindingExpressions() { return mBindingExpressions; }
 
 	// Events
 	virtual void	onPositionChanged();
@@ -207,6 +208,7 @@ public:
 	virtual void	onHide();
 	virtual void	onScreenSaverActivate();
 	virtual void	onScreenSaverDeactivate();
+	virtual void	setLoadPriority(int priority); // Texture loading order of the images, see TextureLoadPriority
 	virtual void	onMouseLeave();
 	virtual void	onMouseEnter();
 	virtual void	onPaddingChanged();
@@ -273,6 +275,13 @@ protected:
 	std::map<std::string, std::string> mBindingExpressions;
 	ExtraType mExtraType;
 
+	// Extra childrens sorted by binding dependencies, see updateBindings
+	std::vector<GuiComponent*> mBindingOrder;
+	std::vector<GuiComponent*> mBindingOrderSource;
+	unsigned int mBindingOrderVersion;
+
+	static std::atomic<unsigned int> sBindingExpressionsVersion;
+
 public:
 	const static unsigned char MAX_ANIMATIONS = 4;
 	static bool isLaunchTransitionRunning;
@@ -1,4 +1,5 @@
 #include "ImageIO.h"
+#include "ImageSizeCache.h"
 
 #include "Log.h"
 #include <FreeImage.h>
@@ -12,7 +13,18 @@
 #include <mutex>
 #include "renderers/Renderer.h"
 #include "Paths.h"
+#include "Settings.h"
 #include "math/Vector4f.h"
+#include "utils/BinaryStream.h"
+#include "utils/MemoryMappedFile.h"
+#include "utils/md5.h"
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
 
 const MaxSizeInfo MaxSizeInfo::Empty;
 
@@ -275,172 +287,256 @@ Vector2f ImageIO::getPictureMinSize(Vector2f imageSize, Vector2f maxSize)
 	return Vector2f(cxDIB, cyDIB);
 }
 
-struct CachedFileInfo
-{
-	CachedFileInfo(int sz, int sx, int sy)
-	{
-		size = sz;
-		x = sx;
-		y = sy;		
-	};
-
-	CachedFileInfo()
-	{
-		size = 0;
-		x = 0;
-		y = 0;		
-	};
-
-	int size;
-	int x;
-	int y;	
-};
-
-static std::unordered_map<std::string, CachedFileInfo> sizeCache;
-static bool sizeCacheDirty = false;
+static ImageSizeCache sizeCache;
 
 std::string getImageCacheFilename()
 {
 	return Paths::getUserEmulationStationPath() + "/imagecache.db";
 }
 
+static std::string getDecodedImageCachePath()
+{
+	return Paths::getUserEmulationStationPath() + "/cache/images";
+}
+
+static std::mutex sDecodedImageCacheLock;
+static bool sDecodedImageCacheScanned = false;
+static unsigned long long sDecodedImageCacheSize = 0; // bytes on disk, once scanned
+
 void ImageIO::clearImageCache()
 {
-	std::string fname = getImageCacheFilename();
-	Utils::FileSystem::removeFile(fname);
 	sizeCache.clear();
+
+	std::unique_lock<std::mutex> lock(sDecodedImageCacheLock);
+	Utils::FileSystem::deleteDirectoryFiles(getDecodedImageCachePath(), true);
+	sDecodedImageCacheScanned = false;
+	sDecodedImageCacheSize = 0;
 }
 
 void ImageIO::loadImageCache()
 {
-	std::string fname = getImageCacheFilename();
+	sizeCache.load(getImageCacheFilename(), Paths::getRootPath());
+}
 
-	std::ifstream f(fname.c_str());
-	if (f.fail())
-		return;
+static bool _isCachablePath(const std::string& path)
+{
+	return 
+		path.find("/themes/") == std::string::npos && 
+		path.find("/tmp/") == std::string::npos &&
+		path.find("/emulationstation.tmp/") == std::string::npos &&
+		path.find("/pdftmp/") == std::string::npos && 
+		path.find("/saves/") == std::string::npos;
+}
 
-	sizeCache.clear();
+void ImageIO::saveImageCache()
+{
+	sizeCache.save();
+}
+
+void ImageIO::removeImageCache(const std::string& fn)
+{
+	sizeCache.remove(fn);
+}
+
+void ImageIO::updateImageCache(const std::string& fn, int sz, int x, int y)
+{
+	sizeCache.update(fn, ImageSizeCache::Info(sz, x, y), sz > 0 && x > 0 && _isCachablePath(fn));
+}
 
-	std::string relativeTo = Paths::getRootPath();
+// Decoded image cache. Each file holds a header with the full key ( guards against name collisions ) followed by the raw RGBA pixels,
+// so a reload only costs a memcpy from the mapped file instead of a decode & rescale.
+// Files are named after the path & target size only : a source file that changed finds & replaces its stale entry.
+// The directory is kept under "DecodedImageCacheSize" MB, least recently used files first ( hits refresh the file modification time ).
+#define DECODED_IMAGE_CACHE_MAGIC	0x43494445 // "EDIC"
+#define DECODED_IMAGE_CACHE_VERSION	2
 
-	std::vector<std::string> splits;
+static bool getDecodedImageCacheKey(const std::string& path, int subImageIndex, const MaxSizeInfo& maxSize, std::string& name, std::string& key)
+{
+	if (!Settings::getInstance()->getBool("DecodedImageCache") || maxSize.empty() || !_isCachablePath(path))
+		return false;
 
-	std::string line;
-	while (std::getline(f, line))
+	auto size = Utils::FileSystem::getFileSize(path);
+	if (size == 0)
+		return false;
+
+	// Screen size is part of the key : loadFromMemoryRGBA32 never rescales beyond it
+	name = path + "|" + std::to_string(subImageIndex) + "|" +
+		std::to_string((int)Math::round(maxSize.x())) + "x" + std::to_string((int)Math::round(maxSize.y())) + "|" +
+		(maxSize.externalZoom() ? "1" : "0") + "|" +
+		std::to_string(Renderer::getScreenWidth()) + "x" + std::to_string(Renderer::getScreenHeight());
+
+	key = name + "|" + std::to_string(size) + "|" + std::to_string((int64_t)Utils::FileSystem::getFileModificationDate(path).getTime());
+	return true;
+}
+
+static std::string getDecodedImageCacheFile(const std::string& name)
+{
+	return getDecodedImageCachePath() + "/" + MD5(name).hexdigest() + ".rgba";
+}
+
+static void touchDecodedImageCacheFile(const std::string& file)
+{
+#if defined(_WIN32)
+	_wutime(Utils::String::convertToWideString(file).c_str(), nullptr);
+#else
+	utime(file.c_str(), nullptr);
+#endif
+}
+
+// sDecodedImageCacheLock is held. Removes the least recently used files until the cache uses 3/4 of the budget
+static void pruneDecodedImageCache(unsigned long long budget)
+{
+	struct CacheFile
 	{
-		splits.clear();
+		std::string path;
+		time_t time;
+		unsigned long long size;
+	};
 
-		const char* src = line.c_str();
+	std::vector<CacheFile> files;
+	unsigned long long total = 0;
 
-		while (true)
-		{
-			const char* d = strchr(src, '|');
-			size_t len = (d) ? d - src : strlen(src);
+	for (auto& file : Utils::FileSystem::getDirectoryFiles(getDecodedImageCachePath()))
+	{
+		if (file.directory)
+			continue;
 
-			if (len)
-				splits.push_back(std::string(src, len)); // capture token
+		CacheFile item;
+		item.path = file.path;
+		item.time = Utils::FileSystem::getFileModificationDate(file.path).getTime();
+		item.size = Utils::FileSystem::getFileSize(file.path);
+		files.push_back(item);
 
-			if (d) src += len + 1; else break;
-		}
+		total += item.size;
+	}
 
-		if (splits.size() == 4)
-		{
-			std::string file = Utils::FileSystem::resolveRelativePath(splits[0], relativeTo, true);
+	std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) { return a.time < b.time; });
 
-			CachedFileInfo fi;
-			fi.size = Utils::String::toInteger(splits[1]);
-			fi.x = Utils::String::toInteger(splits[2]);
-			fi.y = Utils::String::toInteger(splits[3]);
+	int removed = 0;
 
-			sizeCache[file] = fi;
+	for (auto& file : files)
+	{
+		if (total <= budget / 4 * 3)
+			break;
+
+		if (Utils::FileSystem::removeFile(file.path))
+		{
+			total -= file.size;
+			removed++;
 		}
 	}
 
-	f.close();
+	if (removed > 0)
+		LOG(LogDebug) << "ImageIO : decoded image cache pruned, " << removed << " files removed";
+
+	sDecodedImageCacheSize = total;
+	sDecodedImageCacheScanned = true;
 }
 
-static bool _isCachablePath(const std::string& path)
+static void addDecodedImageCacheSize(unsigned long long size)
 {
-	return 
-		path.find("/themes/") == std::string::npos && 
-		path.find("/tmp/") == std::string::npos &&
-		path.find("/emulationstation.tmp/") == std::string::npos &&
-		path.find("/pdftmp/") == std::string::npos && 
-		path.find("/saves/") == std::string::npos;
+	unsigned long long budget = (unsigned long long)std::max(0, Settings::getInstance()->getInt("DecodedImageCacheSize")) * 1024 * 1024;
+
+	std::unique_lock<std::mutex> lock(sDecodedImageCacheLock);
+
+	// The first write measures the cache left by previous runs
+	if (!sDecodedImageCacheScanned)
+		pruneDecodedImageCache(budget);
+	else
+	{
+		sDecodedImageCacheSize += size;
+
+		if (sDecodedImageCacheSize > budget)
+			pruneDecodedImageCache(budget);
+	}
 }
 
-void ImageIO::saveImageCache()
+unsigned char* ImageIO::loadDecodedImageCache(const std::string& path, int subImageIndex, const MaxSizeInfo& maxSize, size_t& width, size_t& height, Vector2i& baseSize)
 {
-	if (!sizeCacheDirty)
-		return;
+	std::string name, key;
+	if (!getDecodedImageCacheKey(path, subImageIndex, maxSize, name, key))
+		return nullptr;
 
-	std::string fname = getImageCacheFilename();
-	std::ofstream f(fname.c_str(), std::ios::binary);
-	if (f.fail())
-		return;
+	std::string cacheFile = getDecodedImageCacheFile(name);
 
-	std::string relativeTo = Paths::getRootPath();
+	uint32_t w, h;
+	int32_t baseX, baseY;
+	unsigned char* data = nullptr;
+	bool stale = false;
 
-	for (auto it : sizeCache)
 	{
-		if (it.second.size < 0)
-			continue;
+		Utils::MemoryMappedFile file;
+		if (!file.open(cacheFile))
+			return nullptr;
+
+		Utils::BinaryReader reader(file.data(), file.size());
+
+		uint32_t magic, version;
+		std::string fileKey;
+
+		if (!reader.read(magic) || magic != DECODED_IMAGE_CACHE_MAGIC ||
+			!reader.read(version) || version != DECODED_IMAGE_CACHE_VERSION ||
+			!reader.readString(fileKey) || fileKey != key ||
+			!reader.read(baseX) || !reader.read(baseY) ||
+			!reader.read(w) || !reader.read(h) ||
+			w == 0 || h == 0 || reader.remaining() != (size_t)w * h * 4)
+			stale = true;
+		else
+		{
+			data = new unsigned char[(size_t)w * h * 4];
+			memcpy(data, reader.current(), (size_t)w * h * 4);
+		}
+	}
 
-		if (!_isCachablePath(it.first))
-			continue;
+	if (stale)
+	{
+		// The source was modified since : drop the entry now rather than waiting for the pruning
+		std::unique_lock<std::mutex> lock(sDecodedImageCacheLock);
 
-		std::string path = Utils::FileSystem::createRelativePath(it.first, relativeTo, true); 
+		auto size = Utils::FileSystem::getFileSize(cacheFile);
+		if (Utils::FileSystem::removeFile(cacheFile) && sDecodedImageCacheScanned)
+			sDecodedImageCacheSize -= std::min(sDecodedImageCacheSize, size);
 
-		f << path;
-		f << "|";
-		f << std::to_string(it.second.size);
-		f << "|";
-		f << std::to_string(it.second.x);
-		f << "|";
-		f << std::to_string(it.second.y);
-		f << "\n";
+		return nullptr;
 	}
 
-	f.close();
-}
+	touchDecodedImageCacheFile(cacheFile);
 
-static std::mutex sizeCacheLock;
+	width = w;
+	height = h;
+	baseSize = Vector2i(baseX, baseY);
 
-void ImageIO::removeImageCache(const std::string& fn)
-{
-	std::unique_lock<std::mutex> lock(sizeCacheLock);
+	LOG(LogDebug) << "ImageIO::loadDecodedImageCache " << path;
 
-	auto it = sizeCache.find(fn);
-	if (it != sizeCache.cend())
-		sizeCache.erase(fn);
+	return data;
 }
 
-void ImageIO::updateImageCache(const std::string& fn, int sz, int x, int y)
+void ImageIO::saveDecodedImageCache(const std::string& path, int subImageIndex, const MaxSizeInfo& maxSize, const unsigned char* data, size_t width, size_t height, const Vector2i& baseSize)
 {
-	std::unique_lock<std::mutex> lock(sizeCacheLock);
-
-	auto it = sizeCache.find(fn);
-	if (it != sizeCache.cend())
-	{
-		if (x != it->second.x || y != it->second.y || sz != it->second.size)
-		{
-			auto& item = it->second;
+	if (data == nullptr || width == 0 || height == 0)
+		return;
 
-			item.x = x;
-			item.y = y;
-			item.size = sz;
+	std::string name, key;
+	if (!getDecodedImageCacheKey(path, subImageIndex, maxSize, name, key))
+		return;
 
-			if (sz > 0 && x > 0 && _isCachablePath(fn))
-				sizeCacheDirty = true;
-		}
-	}
-	else
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(DECODED_IMAGE_CACHE_MAGIC);
+	writer.write<uint32_t>(DECODED_IMAGE_CACHE_VERSION);
+	writer.writeString(key);
+	writer.write<int32_t>(baseSize.x());
+	writer.write<int32_t>(baseSize.y());
+	writer.write<uint32_t>((uint32_t)width);
+	writer.write<uint32_t>((uint32_t)height);
+	writer.writeBytes(data, width * height * 4);
+
+	if (!writer.saveToFile(getDecodedImageCacheFile(name)))
 	{
-		sizeCache[fn] = CachedFileInfo(sz, x, y);
-
-		if (sz > 0 && x > 0 && _isCachablePath(fn))
-			sizeCacheDirty = true;
+		LOG(LogWarning) << "ImageIO : unable to write decoded image cache for " << path;
+		return;
 	}
+
+	addDecodedImageCacheSize(writer.size());
 }
 
 static bool extractSvgSize(const std::string& svgFilePath, float& width, float& height)
@@ -537,19 +633,15 @@ static int get24bit(const uint8_t* data, int index)
 
 bool ImageIO::loadImageSize(const std::string& fn, unsigned int *x, unsigned int *y)
 {
+	ImageSizeCache::Info info;
+	if (sizeCache.find(fn, info))
 	{
-		std::unique_lock<std::mutex> lock(sizeCacheLock);
-
-		auto it = sizeCache.find(fn);
-		if (it != sizeCache.cend())
-		{
-			if (it->second.size < 0)
-				return false;
+		if (info.size < 0)
+			return false;
 
-			*x = it->second.x;
-			*y = it->second.y;
-			return true;
-		}
+		*x = info.x;
+		*y = info.y;
+		return true;
 	}
 
 	LOG(LogDebug) << "ImageIO::loadImageSize " << fn;
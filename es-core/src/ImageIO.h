@@ -4,6 +4,7 @@
 
 #include <stdlib.h>
 #include <vector>
+#include <string>
 #include "math/Vector2f.h"
 #include "math/Vector2i.h"
 
@@ -57,6 +58,10 @@ public:
 	static void		saveImageCache();
 	static void		clearImageCache();
 
+	// Decoded image cache : downscaled RGBA pixels keyed by path, file size, modification time & target size
+	static unsigned char* loadDecodedImageCache(const std::string& path, int subImageIndex, const MaxSizeInfo& maxSize, size_t& width, size_t& height, Vector2i& baseSize);
+	static void		saveDecodedImageCache(const std::string& path, int subImageIndex, const MaxSizeInfo& maxSize, const unsigned char* data, size_t width, size_t height, const Vector2i& baseSize);
+
 	static bool		getMultiBitmapInformation(const std::string& path, int& totalFrames, int& frameTime);
 };
 
@@ -0,0 +1,575 @@
+#include "ImageSizeCache.h"
+
+#include "Log.h"
+#include "utils/BinaryStream.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include <fstream>
+#include <unordered_map>
+#include <string.h>
+#include <thread>
+
+// Header : magic, version, bucket count, used buckets, end of the record log, root path. Then the buckets ( record offsets, 0 = empty ), then the records.
+// Record : hash, size, x, y, flags, path length, path. Header & records are aligned on 8 bytes.
+#define IMAGE_SIZE_CACHE_MAGIC			0x43534945 // "EISC"
+#define IMAGE_SIZE_CACHE_VERSION		1
+#define IMAGE_SIZE_CACHE_USED_OFFSET	12
+#define IMAGE_SIZE_CACHE_END_OFFSET		16
+#define IMAGE_SIZE_CACHE_RECORD_SIZE	28
+#define IMAGE_SIZE_CACHE_REMOVED		1
+#define IMAGE_SIZE_CACHE_MIN_BUCKETS	1024
+
+static inline uint64_t align8(uint64_t value) { return (value + 7) & ~(uint64_t)7; }
+
+static void writeRecord(Utils::BinaryWriter& writer, uint64_t hash, const ImageSizeCache::Info& info, bool removed, const char* path, uint32_t pathLength)
+{
+	writer.write<uint64_t>(hash);
+	writer.write<int32_t>(info.size);
+	writer.write<int32_t>(info.x);
+	writer.write<int32_t>(info.y);
+	writer.write<uint32_t>(removed ? IMAGE_SIZE_CACHE_REMOVED : 0);
+	writer.write<uint32_t>(pathLength);
+	writer.writeBytes(path, pathLength);
+
+	static const char padding[8] = { 0 };
+	writer.writeBytes(padding, align8(writer.size()) - writer.size());
+}
+
+ImageSizeCache::ImageSizeCache() : mMapped(nullptr), mTable(nullptr), mMappedReaders(0)
+{
+	mTables.push_back(std::unique_ptr<Table>(new Table(IMAGE_SIZE_CACHE_MIN_BUCKETS)));
+	mTable = mTables.back().get();
+}
+
+uint64_t ImageSizeCache::hashPath(const char* data, size_t length)
+{
+	// FNV-1a : stable between runs & builds, the hashes are stored in the file
+	uint64_t hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= (unsigned char)data[i];
+		hash *= 1099511628211ULL;
+	}
+
+	// 0 marks empty slots
+	return hash == 0 ? 1 : hash;
+}
+
+bool ImageSizeCache::readMappedRecord(MappedTable* mapped, uint64_t offset, MappedRecord& record)
+{
+	uint64_t recordsOffset = mapped->bucketsOffset + (uint64_t)mapped->bucketCount * sizeof(uint64_t);
+	if (offset < recordsOffset || offset + IMAGE_SIZE_CACHE_RECORD_SIZE > mapped->dataEnd)
+		return false;
+
+	Utils::BinaryReader reader(mapped->file.data() + offset, (size_t)(mapped->dataEnd - offset));
+
+	uint32_t flags;
+	if (!reader.read(record.hash) || !reader.read(record.info.size) || !reader.read(record.info.x) || !reader.read(record.info.y) ||
+		!reader.read(flags) || !reader.read(record.pathLength) || reader.remaining() < record.pathLength)
+		return false;
+
+	record.removed = (flags & IMAGE_SIZE_CACHE_REMOVED) != 0;
+	record.path = (const char*)reader.current();
+	return true;
+}
+
+ImageSizeCache::MappedTable* ImageSizeCache::openMapped(const std::string& path, const std::string& rootPath)
+{
+	std::unique_ptr<MappedTable> mapped(new MappedTable());
+	if (!mapped->file.open(path))
+		return nullptr;
+
+	Utils::BinaryReader reader(mapped->file.data(), mapped->file.size());
+
+	uint32_t magic, version;
+	std::string root;
+
+	if (!reader.read(magic) || magic != IMAGE_SIZE_CACHE_MAGIC ||
+		!reader.read(version) || version != IMAGE_SIZE_CACHE_VERSION ||
+		!reader.read(mapped->bucketCount) || !reader.read(mapped->usedBuckets) || !reader.read(mapped->dataEnd) ||
+		!reader.readString(root))
+		return nullptr;
+
+	// Paths are stored absolute : the cache is only valid for the same installation
+	if (root != rootPath)
+	{
+		LOG(LogDebug) << "ImageSizeCache : " << path << " was built for another root path";
+		return nullptr;
+	}
+
+	mapped->bucketsOffset = align8(reader.position());
+
+	if (mapped->bucketCount == 0 || (mapped->bucketCount & (mapped->bucketCount - 1)) != 0 ||
+		mapped->bucketsOffset + (uint64_t)mapped->bucketCount * sizeof(uint64_t) > mapped->dataEnd ||
+		mapped->dataEnd > mapped->file.size())
+		return nullptr;
+
+	mapped->buckets = (const uint64_t*)(mapped->file.data() + mapped->bucketsOffset);
+	return mapped.release();
+}
+
+void ImageSizeCache::publishMapped(MappedTable* mapped)
+{
+	if (mapped != nullptr)
+		mMappedTables.push_back(std::unique_ptr<MappedTable>(mapped));
+
+	mMapped.store(mapped, std::memory_order_release);
+}
+
+// mWriteLock is held. Windows can't replace or delete a mapped file : every mapping is released once no reader uses it.
+// Readers miss the entries of the file until a new one is published.
+void ImageSizeCache::unmapAll()
+{
+	mMapped.store(nullptr);
+
+	while (mMappedReaders.load() > 0)
+		std::this_thread::yield();
+
+	mMappedTables.clear();
+}
+
+void ImageSizeCache::load(const std::string& path, const std::string& rootPath)
+{
+	std::unique_lock<std::mutex> lock(mWriteLock);
+
+	mPath = path;
+	mRootPath = rootPath;
+
+	MappedTable* mapped = openMapped(path, rootPath);
+	if (mapped != nullptr)
+	{
+		publishMapped(mapped);
+		return;
+	}
+
+	loadLegacy(path);
+}
+
+void ImageSizeCache::loadLegacy(const std::string& path)
+{
+	// Text format of older versions : "path|size|x|y" lines. The entries are imported & the file is rebuilt on next save
+	std::ifstream f(path.c_str());
+	if (f.fail())
+		return;
+
+	uint32_t magic = 0;
+	if (f.read((char*)&magic, sizeof(uint32_t)) && magic == IMAGE_SIZE_CACHE_MAGIC)
+		return; // Outdated binary file
+
+	f.clear();
+	f.seekg(0);
+
+	std::vector<std::string> splits;
+
+	std::string line;
+	while (std::getline(f, line))
+	{
+		splits.clear();
+
+		const char* src = line.c_str();
+
+		while (true)
+		{
+			const char* d = strchr(src, '|');
+			size_t len = (d) ? d - src : strlen(src);
+
+			if (len)
+				splits.push_back(std::string(src, len)); // capture token
+
+			if (d) src += len + 1; else break;
+		}
+
+		if (splits.size() != 4)
+			continue;
+
+		std::string file = Utils::FileSystem::resolveRelativePath(splits[0], mRootPath, true);
+		Info info(Utils::String::toInteger(splits[1]), Utils::String::toInteger(splits[2]), Utils::String::toInteger(splits[3]));
+
+		Record* record = new Record(hashPath(file.c_str(), file.size()), file, info, false, true);
+		mRecords.push_back(std::unique_ptr<Record>(record));
+		insert(record);
+		mDirty.push_back(record);
+	}
+}
+
+ImageSizeCache::Record* ImageSizeCache::findOverlay(Table* table, uint64_t hash, const std::string& fn)
+{
+	for (size_t i = 0, idx = hash & table->mask; i <= table->mask; i++, idx = (idx + 1) & table->mask)
+	{
+		Slot& slot = table->slots[idx];
+
+		uint64_t slotHash = slot.hash.load(std::memory_order_acquire);
+		if (slotHash == 0)
+			return nullptr;
+
+		if (slotHash != hash)
+			continue;
+
+		Record* record = slot.record.load(std::memory_order_acquire);
+		if (record != nullptr && record->path == fn)
+			return record;
+	}
+
+	return nullptr;
+}
+
+bool ImageSizeCache::findMapped(uint64_t hash, const std::string& fn, Info& info)
+{
+	// Counted before the table is read : unmapAll waits for the readers that may hold it
+	mMappedReaders++;
+	bool found = findMappedRecord(mMapped.load(), hash, fn, info);
+	mMappedReaders--;
+
+	return found;
+}
+
+bool ImageSizeCache::findMappedRecord(MappedTable* mapped, uint64_t hash, const std::string& fn, Info& info)
+{
+	if (mapped == nullptr)
+		return false;
+
+	uint32_t mask = mapped->bucketCount - 1;
+
+	for (uint32_t i = 0, idx = hash & mask; i <= mask; i++, idx = (idx + 1) & mask)
+	{
+		uint64_t offset = mapped->buckets[idx];
+		if (offset == 0)
+			return false;
+
+		MappedRecord record;
+		if (!readMappedRecord(mapped, offset, record) || record.hash != hash)
+			continue;
+
+		if (record.pathLength != fn.size() || memcmp(record.path, fn.c_str(), fn.size()) != 0)
+			continue;
+
+		if (record.removed)
+			return false;
+
+		info = record.info;
+		return true;
+	}
+
+	return false;
+}
+
+bool ImageSizeCache::find(const std::string& fn, Info& info)
+{
+	uint64_t hash = hashPath(fn.c_str(), fn.size());
+
+	Record* record = findOverlay(mTable.load(std::memory_order_acquire), hash, fn);
+	if (record != nullptr)
+	{
+		if (record->removed)
+			return false;
+
+		info = record->info;
+		return true;
+	}
+
+	return findMapped(hash, fn, info);
+}
+
+void ImageSizeCache::insert(Record* record)
+{
+	Table* table = mTable.load(std::memory_order_relaxed);
+
+	// Keep the overlay at most half full, readers go on with the old table while the new one is built
+	if ((table->count + 1) * 2 > table->mask + 1)
+	{
+		Table* grown = new Table((table->mask + 1) * 2);
+
+		for (size_t i = 0; i <= table->mask; i++)
+		{
+			Record* item = table->slots[i].record.load(std::memory_order_relaxed);
+			if (item == nullptr)
+				continue;
+
+			size_t idx = item->hash & grown->mask;
+			while (grown->slots[idx].record.load(std::memory_order_relaxed) != nullptr)
+				idx = (idx + 1) & grown->mask;
+
+			grown->slots[idx].record.store(item, std::memory_order_relaxed);
+			grown->slots[idx].hash.store(item->hash, std::memory_order_relaxed);
+			grown->count++;
+		}
+
+		mTables.push_back(std::unique_ptr<Table>(grown));
+		mTable.store(grown, std::memory_order_release);
+		table = grown;
+	}
+
+	for (size_t idx = record->hash & table->mask; ; idx = (idx + 1) & table->mask)
+	{
+		Slot& slot = table->slots[idx];
+
+		uint64_t slotHash = slot.hash.load(std::memory_order_relaxed);
+		if (slotHash == 0)
+		{
+			// The record is visible before the hash : a reader that matches the hash always finds a record
+			slot.record.store(record, std::memory_order_release);
+			slot.hash.store(record->hash, std::memory_order_release);
+			table->count++;
+			return;
+		}
+
+		if (slotHash == record->hash && slot.record.load(std::memory_order_relaxed)->path == record->path)
+		{
+			slot.record.store(record, std::memory_order_release);
+			return;
+		}
+	}
+}
+
+void ImageSizeCache::update(const std::string& fn, const Info& info, bool persist)
+{
+	std::unique_lock<std::mutex> lock(mWriteLock);
+
+	Info current;
+	if (find(fn, current) && current.size == info.size && current.x == info.x && current.y == info.y)
+		return;
+
+	Record* record = new Record(hashPath(fn.c_str(), fn.size()), fn, info, false, persist);
+	mRecords.push_back(std::unique_ptr<Record>(record));
+	insert(record);
+
+	if (persist)
+		mDirty.push_back(record);
+}
+
+void ImageSizeCache::remove(const std::string& fn)
+{
+	std::unique_lock<std::mutex> lock(mWriteLock);
+
+	uint64_t hash = hashPath(fn.c_str(), fn.size());
+
+	Info info;
+	bool inFile = findMapped(hash, fn, info);
+
+	Record* current = findOverlay(mTable.load(std::memory_order_relaxed), hash, fn);
+	if ((current == nullptr && !inFile) || (current != nullptr && current->removed))
+		return;
+
+	// A tombstone is only written when the file knows the entry
+	Record* record = new Record(hash, fn, Info(), true, inFile);
+	mRecords.push_back(std::unique_ptr<Record>(record));
+	insert(record);
+
+	if (inFile)
+		mDirty.push_back(record);
+}
+
+void ImageSizeCache::clear()
+{
+	std::unique_lock<std::mutex> lock(mWriteLock);
+
+	mTables.push_back(std::unique_ptr<Table>(new Table(IMAGE_SIZE_CACHE_MIN_BUCKETS)));
+	mTable.store(mTables.back().get(), std::memory_order_release);
+
+	unmapAll();
+	mDirty.clear();
+
+	if (!mPath.empty())
+		Utils::FileSystem::removeFile(mPath);
+}
+
+void ImageSizeCache::save()
+{
+	std::unique_lock<std::mutex> lock(mWriteLock);
+
+	if (mDirty.empty() || mPath.empty())
+		return;
+
+	// Only the latest record of every path is written
+	Table* table = mTable.load(std::memory_order_relaxed);
+
+	std::vector<Record*> records;
+	for (auto record : mDirty)
+		if (findOverlay(table, record->hash, record->path) == record)
+			records.push_back(record);
+
+	MappedTable* mapped = mMapped.load(std::memory_order_relaxed);
+
+	bool saved;
+	if (mapped != nullptr && (mapped->usedBuckets + records.size()) * 10 <= (size_t)mapped->bucketCount * 7)
+		saved = append(records);
+	else
+		saved = rewrite();
+
+	if (!saved)
+	{
+		LOG(LogWarning) << "ImageSizeCache : unable to save " << mPath;
+
+		// rewrite released the mapping of the file that is still there
+		if (mMapped.load(std::memory_order_relaxed) == nullptr)
+			publishMapped(openMapped(mPath, mRootPath));
+
+		return;
+	}
+
+	mDirty.clear();
+
+	// Map the new version of the file. The previous mapping stays valid for readers that still use it
+	publishMapped(openMapped(mPath, mRootPath));
+}
+
+bool ImageSizeCache::append(const std::vector<Record*>& records)
+{
+	MappedTable* mapped = mMapped.load(std::memory_order_relaxed);
+
+	std::fstream f(WINSTRINGW(mPath), std::ios::in | std::ios::out | std::ios::binary);
+	if (!f.is_open())
+		return false;
+
+	uint64_t dataEnd = mapped->dataEnd;
+	uint32_t usedBuckets = mapped->usedBuckets;
+	uint32_t mask = mapped->bucketCount - 1;
+
+	// Buckets changed by this save, they are not visible in the mapping yet
+	std::unordered_map<uint32_t, uint64_t> buckets;
+
+	Utils::BinaryWriter writer;
+
+	for (auto record : records)
+	{
+		uint64_t offset = dataEnd + writer.size();
+		writeRecord(writer, record->hash, record->info, record->removed, record->path.c_str(), (uint32_t)record->path.size());
+
+		for (uint32_t idx = record->hash & mask; ; idx = (idx + 1) & mask)
+		{
+			auto it = buckets.find(idx);
+
+			uint64_t current = it != buckets.cend() ? it->second : mapped->buckets[idx];
+			if (current == 0)
+			{
+				usedBuckets++;
+				buckets[idx] = offset;
+				break;
+			}
+
+			const char* path = nullptr;
+			uint32_t pathLength = 0;
+
+			if (it != buckets.cend())
+			{
+				// Record written by this save
+				size_t pos = (size_t)(current - dataEnd) + IMAGE_SIZE_CACHE_RECORD_SIZE;
+				path = writer.data().c_str() + pos;
+				pathLength = *(const uint32_t*)(path - sizeof(uint32_t));
+			}
+			else
+			{
+				MappedRecord mappedRecord;
+				if (readMappedRecord(mapped, current, mappedRecord))
+				{
+					path = mappedRecord.path;
+					pathLength = mappedRecord.pathLength;
+				}
+			}
+
+			if (path != nullptr && pathLength == record->path.size() && memcmp(path, record->path.c_str(), pathLength) == 0)
+			{
+				buckets[idx] = offset;
+				break;
+			}
+		}
+	}
+
+	// Records first, then the buckets that point to them, then the header : an interrupted save leaves offsets beyond the end of the log, which are ignored
+	f.seekp((std::streamoff)dataEnd);
+	f.write(writer.data().c_str(), writer.size());
+
+	for (auto bucket : buckets)
+	{
+		f.seekp((std::streamoff)(mapped->bucketsOffset + (uint64_t)bucket.first * sizeof(uint64_t)));
+		f.write((const char*)&bucket.second, sizeof(uint64_t));
+	}
+
+	dataEnd += writer.size();
+
+	f.seekp(IMAGE_SIZE_CACHE_USED_OFFSET);
+	f.write((const char*)&usedBuckets, sizeof(uint32_t));
+	f.seekp(IMAGE_SIZE_CACHE_END_OFFSET);
+	f.write((const char*)&dataEnd, sizeof(uint64_t));
+
+	f.close();
+	return !f.fail();
+}
+
+bool ImageSizeCache::rewrite()
+{
+	struct Entry
+	{
+		uint64_t	hash;
+		Info		info;
+		const char*	path;
+		uint32_t	pathLength;
+	};
+
+	std::vector<Entry> entries;
+
+	Table* table = mTable.load(std::memory_order_relaxed);
+
+	// Entries of the current file that were not changed during the session
+	MappedTable* mapped = mMapped.load(std::memory_order_relaxed);
+	if (mapped != nullptr)
+	{
+		for (uint32_t i = 0; i < mapped->bucketCount; i++)
+		{
+			MappedRecord record;
+			if (mapped->buckets[i] == 0 || !readMappedRecord(mapped, mapped->buckets[i], record) || record.removed)
+				continue;
+
+			std::string path(record.path, record.pathLength);
+			if (findOverlay(table, record.hash, path) == nullptr)
+				entries.push_back({ record.hash, record.info, record.path, record.pathLength });
+		}
+	}
+
+	for (size_t i = 0; i <= table->mask; i++)
+	{
+		Record* record = table->slots[i].record.load(std::memory_order_relaxed);
+		if (record != nullptr && record->persist && !record->removed)
+			entries.push_back({ record->hash, record->info, record->path.c_str(), (uint32_t)record->path.size() });
+	}
+
+	uint32_t bucketCount = IMAGE_SIZE_CACHE_MIN_BUCKETS;
+	while (bucketCount < entries.size() * 2)
+		bucketCount *= 2;
+
+	Utils::BinaryWriter writer;
+	writer.write<uint32_t>(IMAGE_SIZE_CACHE_MAGIC);
+	writer.write<uint32_t>(IMAGE_SIZE_CACHE_VERSION);
+	writer.write<uint32_t>(bucketCount);
+	writer.write<uint32_t>((uint32_t)entries.size());
+	writer.write<uint64_t>(0);
+	writer.writeString(mRootPath);
+
+	static const char padding[8] = { 0 };
+	writer.writeBytes(padding, align8(writer.size()) - writer.size());
+
+	size_t bucketsOffset = writer.size();
+	std::vector<uint64_t> buckets(bucketCount, 0);
+	writer.writeBytes(buckets.data(), buckets.size() * sizeof(uint64_t));
+
+	uint32_t mask = bucketCount - 1;
+
+	for (const auto& entry : entries)
+	{
+		uint32_t idx = entry.hash & mask;
+		while (buckets[idx] != 0)
+			idx = (idx + 1) & mask;
+
+		buckets[idx] = writer.size();
+		writer.writeAt<uint64_t>(bucketsOffset + idx * sizeof(uint64_t), buckets[idx]);
+
+		writeRecord(writer, entry.hash, entry.info, false, entry.path, entry.pathLength);
+	}
+
+	writer.writeAt<uint64_t>(IMAGE_SIZE_CACHE_END_OFFSET, (uint64_t)writer.size());
+
+	// The records were copied from the mapping, which must be released before the file is replaced
+	unmapAll();
+
+	return writer.saveToFile(mPath);
+}
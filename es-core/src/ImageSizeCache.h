@@ -0,0 +1,129 @@
+#pragma once
+#ifndef ES_CORE_IMAGE_SIZE_CACHE_H
+#define ES_CORE_IMAGE_SIZE_CACHE_H
+
+#include "utils/MemoryMappedFile.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+
+//
+// Image sizes known from previous runs ( imagecache.db ).
+// The file is an open-addressing table of offsets followed by an append-only log of records : it is mapped as is and probed directly, nothing is parsed at startup.
+// Changes made during the session go to an in-memory overlay. Readers never lock : tables are published with atomics & records are never modified once visible.
+// save() appends the changed records to the log & patches their bucket, the file is only rebuilt when the table gets too full.
+//
+class ImageSizeCache
+{
+public:
+	struct Info
+	{
+		Info() : size(0), x(0), y(0) { }
+		Info(int sz, int sx, int sy) : size(sz), x(sx), y(sy) { }
+
+		int size;
+		int x;
+		int y;
+	};
+
+	ImageSizeCache();
+
+	void load(const std::string& path, const std::string& rootPath);
+	void save();
+	void clear();
+
+	bool find(const std::string& fn, Info& info);
+
+	// persist : the entry should be written to disk on save()
+	void update(const std::string& fn, const Info& info, bool persist);
+	void remove(const std::string& fn);
+
+private:
+	struct Record
+	{
+		Record(uint64_t h, const std::string& p, const Info& i, bool rem, bool pers) : hash(h), path(p), info(i), removed(rem), persist(pers) { }
+
+		uint64_t	hash;
+		std::string path;
+		Info		info;
+		bool		removed;
+		bool		persist;
+	};
+
+	struct Slot
+	{
+		Slot() : hash(0), record(nullptr) { }
+
+		std::atomic<uint64_t>	hash;
+		std::atomic<Record*>	record;
+	};
+
+	struct Table
+	{
+		Table(size_t capacity) : slots(new Slot[capacity]), mask(capacity - 1), count(0) { }
+
+		std::unique_ptr<Slot[]>	slots;
+		size_t					mask;
+		size_t					count;
+	};
+
+	// Read-only view of imagecache.db
+	struct MappedTable
+	{
+		MappedTable() : buckets(nullptr), bucketCount(0), usedBuckets(0), bucketsOffset(0), dataEnd(0) { }
+
+		Utils::MemoryMappedFile	file;
+		const uint64_t*			buckets;
+		uint32_t				bucketCount;
+		uint32_t				usedBuckets;
+		uint64_t				bucketsOffset;
+		uint64_t				dataEnd;
+	};
+
+	struct MappedRecord
+	{
+		uint64_t	hash;
+		Info		info;
+		bool		removed;
+		const char*	path;
+		uint32_t	pathLength;
+	};
+
+	static uint64_t hashPath(const char* data, size_t length);
+
+	static bool readMappedRecord(MappedTable* mapped, uint64_t offset, MappedRecord& record);
+	static MappedTable* openMapped(const std::string& path, const std::string& rootPath);
+
+	Record* findOverlay(Table* table, uint64_t hash, const std::string& fn);
+	bool findMapped(uint64_t hash, const std::string& fn, Info& info);
+	static bool findMappedRecord(MappedTable* mapped, uint64_t hash, const std::string& fn, Info& info);
+
+	void insert(Record* record);
+	void publishMapped(MappedTable* mapped);
+	void unmapAll();
+
+	void loadLegacy(const std::string& path);
+	bool append(const std::vector<Record*>& records);
+	bool rewrite();
+
+	std::string	mPath;
+	std::string	mRootPath;
+
+	std::atomic<MappedTable*>	mMapped;
+	std::atomic<Table*>			mTable;
+
+	// Retired tables & replaced records stay allocated until destruction : a reader may still hold them.
+	// Mappings are only released by unmapAll, once mMappedReaders drops to 0
+	std::vector<std::unique_ptr<MappedTable>>	mMappedTables;
+	std::atomic<int>							mMappedReaders;
+	std::vector<std::unique_ptr<Table>>			mTables;
+	std::vector<std::unique_ptr<Record>>		mRecords;
+	std::vector<Record*>						mDirty;
+
+	std::mutex mWriteLock;
+};
+
+#endif // ES_CORE_IMAGE_SIZE_CACHE_H
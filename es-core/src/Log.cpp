@@ -4,6 +4,13 @@
 #include "utils/Platform.h"
 #include <iostream>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <ctime>
 #include "Settings.h"
 #include <iomanip> 
 #include <SDL_timer.h>
@@ -13,10 +20,84 @@
 #include <Windows.h>
 #endif
 
-static std::mutex mLogLock;
+#define LOG_RING_SIZE		1024
+#define LOG_WRITE_DELAY		100 // ms
+
+struct LogLine
+{
+	std::chrono::steady_clock::time_point time;
+	LogLevel	level;
+	std::string text;
+};
+
+// Lines of one thread : pushed by that thread only, popped by the writer only ( single producer, single consumer )
+class LogRingBuffer
+{
+public:
+	LogRingBuffer() : mHead(0), mTail(0), mAbandoned(false) { }
+
+	bool push(LogLine& line)
+	{
+		size_t head = mHead.load(std::memory_order_relaxed);
+		if (head - mTail.load(std::memory_order_acquire) >= LOG_RING_SIZE)
+			return false;
+
+		mLines[head % LOG_RING_SIZE] = std::move(line);
+		mHead.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool pop(LogLine& line)
+	{
+		size_t tail = mTail.load(std::memory_order_relaxed);
+		if (tail == mHead.load(std::memory_order_acquire))
+			return false;
+
+		line = std::move(mLines[tail % LOG_RING_SIZE]);
+		mTail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool empty() { return mTail.load(std::memory_order_acquire) == mHead.load(std::memory_order_acquire); }
+
+	std::atomic<bool> mAbandoned; // The thread has exited
+
+private:
+	LogLine				mLines[LOG_RING_SIZE];
+	std::atomic<size_t> mHead;
+	std::atomic<size_t> mTail;
+};
+
+// Owned by each thread that logs, registered in mRingBuffers on its first line
+struct ThreadRingBuffer
+{
+	~ThreadRingBuffer()
+	{
+		if (ring != nullptr)
+			ring->mAbandoned = true;
+	}
+
+	std::shared_ptr<LogRingBuffer> ring;
+};
+
+static thread_local ThreadRingBuffer			mThreadRingBuffer;
+
+static std::mutex								mRingBuffersLock; // mRingBuffers & mOverflow
+static std::vector<std::shared_ptr<LogRingBuffer>>	mRingBuffers;
+static std::vector<LogLine>						mOverflow; // Lines of threads whose ring buffer was full
+
+static std::mutex								mWriteLock; // Writing to mFile
+static std::mutex								mWriterLock;
+static std::condition_variable					mWriterEvent;
+static std::thread*								mWriterThread = nullptr;
+static bool										mWriterExit = false;
+static bool										mWriterWake = false;
+
+// Wall clock at startup : lines only keep a monotonic time, converted when written
+static const auto mStartSteadyTime = std::chrono::steady_clock::now();
+static const auto mStartTime = std::chrono::system_clock::now();
 
 LogLevel Log::mReportingLevel = (LogLevel) -1;
-bool     Log::mDirty          = false;
 FILE*    Log::mFile           = NULL;
 
 void Log::init()
@@ -56,60 +137,161 @@ void Log::init()
 	Utils::FileSystem::removeFile(bakPath);
 	Utils::FileSystem::renameFile(logPath, bakPath);
 
-	bool locked = mLogLock.try_lock();
+	{
+		std::unique_lock<std::mutex> lock(mWriteLock);
+		mFile = fopen(logPath.c_str(), "w");
+	}
 
-	mFile = fopen(logPath.c_str(), "w");
-	mDirty = false;
 	mReportingLevel = lvl;
 
-	if (locked)
-		mLogLock.unlock();
+	std::unique_lock<std::mutex> lock(mWriterLock);
+	mWriterExit = false;
+
+	if (mWriterThread == nullptr && mFile != NULL)
+		mWriterThread = new std::thread(&Log::writerThread);
 }
 
 std::ostringstream& Log::get(LogLevel level)
 {
-	time_t t = time(nullptr);
-	mStream << std::put_time(localtime(&t), "%F %T\t");
+	mMessageLevel = level;
+	mTime = std::chrono::steady_clock::now();
+	return mStream;
+}
 
-	switch (level)
-	{
-	case LogError:
-		mStream << "ERROR\t";
-		break;
-	case LogWarning:
-		mStream << "WARNING\t";
-		break;
-	case LogDebug:
-		mStream << "DEBUG\t";
-		break;
-	default:
-		mStream << "INFO\t";
-		break;
-	}
+void Log::writerThread()
+{
+	std::unique_lock<std::mutex> lock(mWriterLock);
 
-	mMessageLevel = level;
+	while (!mWriterExit)
+	{
+		mWriterEvent.wait_for(lock, std::chrono::milliseconds(LOG_WRITE_DELAY), [] { return mWriterExit || mWriterWake; });
+		mWriterWake = false;
 
-	return mStream;
+		lock.unlock();
+		writeQueuedLines();
+		lock.lock();
+	}
 }
 
-void Log::flush()
+void Log::writeQueuedLines()
 {
-	if (!mDirty)
+	std::unique_lock<std::mutex> writeLock(mWriteLock);
+
+	std::vector<LogLine> lines;
+
+	{
+		std::unique_lock<std::mutex> lock(mRingBuffersLock);
+
+		lines.swap(mOverflow);
+
+		LogLine line;
+		for (auto it = mRingBuffers.begin(); it != mRingBuffers.end(); )
+		{
+			auto ring = *it;
+			while (ring->pop(line))
+				lines.push_back(std::move(line));
+
+			if (ring->mAbandoned && ring->empty())
+				it = mRingBuffers.erase(it);
+			else
+				it++;
+		}
+	}
+
+	if (lines.size() == 0)
 		return;
 
-	if (mLogLock.try_lock())
+	// Lines of different threads
+	std::stable_sort(lines.begin(), lines.end(), [](const LogLine& a, const LogLine& b) { return a.time < b.time; });
+
+	// Timestamps have a one second resolution : localtime is only called when the second changes
+	static time_t lastTime = -1;
+	static char timeBuffer[32] = { 0 };
+
+	std::string buffer;
+
+	for (auto& line : lines)
 	{
-		if (mFile != nullptr)
-			fflush(mFile);
+		time_t t = std::chrono::system_clock::to_time_t(mStartTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(line.time - mStartSteadyTime));
+		if (t != lastTime)
+		{
+			lastTime = t;
+			strftime(timeBuffer, sizeof(timeBuffer), "%F %T\t", localtime(&t));
+		}
+
+		size_t start = buffer.size();
 
-		mDirty = false;
-		mLogLock.unlock();
+		buffer += timeBuffer;
+
+		switch (line.level)
+		{
+		case LogError:
+			buffer += "ERROR\t";
+			break;
+		case LogWarning:
+			buffer += "WARNING\t";
+			break;
+		case LogDebug:
+			buffer += "DEBUG\t";
+			break;
+		default:
+			buffer += "INFO\t";
+			break;
+		}
+
+		buffer += line.text;
+		buffer += "\n";
+
+		// If it's an error, also print to console
+		// print all messages if using --debug
+		if (line.level == LogError || mReportingLevel >= LogDebug)
+		{
+#if WIN32
+			OutputDebugStringA(buffer.c_str() + start);
+#else
+			fprintf(stderr, "%s", buffer.c_str() + start);
+#endif
+		}
+	}
+
+	if (mFile != NULL)
+	{
+		fwrite(buffer.data(), 1, buffer.size(), mFile);
+		fflush(mFile);
+	}
+}
+
+void Log::flush(bool waitForWrite)
+{
+	if (waitForWrite)
+	{
+		writeQueuedLines();
+		return;
 	}
+
+	std::unique_lock<std::mutex> lock(mWriterLock);
+	mWriterWake = true;
+	mWriterEvent.notify_one();
 }
 
 void Log::close()
 {
-	bool locked = mLogLock.try_lock();
+	{
+		std::unique_lock<std::mutex> lock(mWriterLock);
+		mWriterExit = true;
+		mWriterEvent.notify_one();
+	}
+
+	if (mWriterThread != nullptr)
+	{
+		mWriterThread->join();
+		delete mWriterThread;
+		mWriterThread = nullptr;
+	}
+
+	writeQueuedLines();
+
+	std::unique_lock<std::mutex> writeLock(mWriteLock);
 
 	if (mFile != NULL)
 	{
@@ -117,37 +299,36 @@ void Log::close()
 		fclose(mFile);
 		mFile = NULL;
 	}
-
-	mDirty = false;
-	
-	if (locked)
-		mLogLock.unlock();
 }
 
 Log::~Log()
 {
-	bool locked = mLogLock.try_lock();
+	if (mFile == NULL)
+		return;
 
-	if (mFile != NULL)
+	LogLine line;
+	line.time = mTime;
+	line.level = mMessageLevel;
+	line.text = mStream.str();
+
+	auto& ring = mThreadRingBuffer.ring;
+	if (ring == nullptr)
 	{
-		mStream << std::endl;
-		fprintf(mFile, "%s", mStream.str().c_str());
-		mDirty = true;
+		ring = std::make_shared<LogRingBuffer>();
+
+		std::unique_lock<std::mutex> lock(mRingBuffersLock);
+		mRingBuffers.push_back(ring);
 	}
-	
-	// If it's an error, also print to console
-	// print all messages if using --debug
-	if (mMessageLevel == LogError || mReportingLevel >= LogDebug)
+
+	if (!ring->push(line))
 	{
-#if WIN32
-		OutputDebugStringA(mStream.str().c_str());
-#else
-		fprintf(stderr, "%s", mStream.str().c_str());
-#endif
+		std::unique_lock<std::mutex> lock(mRingBuffersLock);
+		mOverflow.push_back(std::move(line));
 	}
 
-	if (locked)
-		mLogLock.unlock();
+	// Don't keep errors waiting
+	if (mMessageLevel == LogError)
+		flush();
 }
 
 StopWatch::StopWatch(const std::string& elapsedMillisecondsMessage, LogLevel level)
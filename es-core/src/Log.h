@@ -4,15 +4,18 @@
 
 #include <sstream>
 #include <exception>
+#include <chrono>
 	
+// Disabled levels only cost the test : the message is not even formatted
 #define LOG(level) if(!Log::enabled() || level > Log::getReportingLevel()) ; else Log().get(level)
 
 #define TRYCATCH(m, x) { try { x; } \
-catch (const std::exception& e) { LOG(LogError) << m << " Exception " << e.what(); Log::flush(); throw e; } \
-catch (...) { LOG(LogError) << m << " Unknown Exception occured"; Log::flush(); throw; } }
+catch (const std::exception& e) { LOG(LogError) << m << " Exception " << e.what(); Log::flush(true); throw e; } \
+catch (...) { LOG(LogError) << m << " Unknown Exception occured"; Log::flush(true); throw; } }
 
 enum LogLevel { LogError, LogWarning, LogInfo, LogDebug };
 
+// Lines are queued in a ring buffer of the calling thread, then timestamped, formatted & written by a background thread.
 class Log
 {
 public:
@@ -23,17 +26,21 @@ public:
 	static inline bool enabled() { return mFile != NULL; }
 
 	static void init();
-	static void flush();
+	// Asks the writer thread to write the queued lines. waitForWrite writes them on the calling thread before returning
+	static void flush(bool waitForWrite = false);
 	static void close();
 	
 private:
+	static void writeQueuedLines();
+	static void writerThread();
+
 	static LogLevel     mReportingLevel;
-	static bool         mDirty;
 	static FILE*        mFile;
 
 protected:
 	std::ostringstream  mStream;
 	LogLevel		    mMessageLevel;
+	std::chrono::steady_clock::time_point mTime;
 };
 
 class StopWatch
@@ -9,18 +9,46 @@
 #include <set>
 #include <map>
 #include <mutex>
+#include <list>
+#include <condition_variable>
+#include <ctime>
 
 using namespace Utils::Platform;
 
 namespace Scripting
 {
-#if WIN32
+    struct ScriptCommand
+    {
+        std::string script;
+        std::string eventName;
+        std::string command;
+    };
+
     static std::thread*                 mScriptQueueThread = nullptr;
-    static std::list<std::string>       mScriptQueue;
+    static std::list<ScriptCommand>     mScriptQueue;
     static std::mutex			        mScriptQueueLock;
     static std::condition_variable		mScriptQueueEvent;
     static bool                         mExitScriptQueue = false;
 
+    // Only the last pending call of a script matters for these events ( fired for every item while scrolling )
+    static std::set<std::string>        _coalescedEvents = { "game-selected", "system-selected" };
+
+    static void runCommand(const std::string& command, bool waitForExit)
+    {
+        LOG(LogDebug) << "  executing: " << command;
+
+        ProcessStartInfo psi;
+        psi.command = command;
+        psi.waitForExit = waitForExit;
+        psi.showWindow = false;
+#if !WIN32
+        // Don't clobber game logs when running scripts
+        psi.stderrFilename = "es_script_stderr.log";
+        psi.stdoutFilename = "es_script_stdout.log";
+#endif
+        psi.run();
+    }
+
     static void executeCommandsThread()
     {
         while (true)
@@ -34,35 +62,38 @@ namespace Scripting
 
             if (!mScriptQueue.empty())
             {
-                auto command = mScriptQueue.front();
+                auto command = mScriptQueue.front().command;
                 mScriptQueue.pop_front();
 
                 lock.unlock();
                 std::this_thread::yield();
 
-                ProcessStartInfo psi;
-                psi.command = command;
-                psi.waitForExit = false;
-                psi.showWindow = false;
-                psi.run();
-
-                LOG(LogDebug) << "  executing: " << command;
+                runCommand(command, false);
 
                 std::this_thread::yield();
             }
         }
     }
 
-    static std::string _lastCommand;
-
-    static void pushCommand(const std::string& command)
+    static void pushCommand(const ScriptCommand& command)
     {
         std::unique_lock<std::mutex> lock(mScriptQueueLock);
 
-        if (command == _lastCommand)
-            return;
+        bool coalesce = _coalescedEvents.find(command.eventName) != _coalescedEvents.cend();
+
+        for (auto& pending : mScriptQueue)
+        {
+            // Already waiting to run
+            if (pending.command == command.command)
+                return;
 
-        _lastCommand = command;
+            if (coalesce && pending.script == command.script && pending.eventName == command.eventName)
+            {
+                LOG(LogDebug) << "  replacing: " << pending.command;
+                pending.command = command.command;
+                return;
+            }
+        }
 
         if (mScriptQueueThread == nullptr)
             mScriptQueueThread = new std::thread(&executeCommandsThread);
@@ -70,22 +101,19 @@ namespace Scripting
         mScriptQueue.push_back(command);
         mScriptQueueEvent.notify_one();
     }
-#endif
 
     void exitScriptingEngine()
     {
-#if WIN32
         std::unique_lock<std::mutex> lock(mScriptQueueLock);
         mExitScriptQueue = true;
         mScriptQueueEvent.notify_one();
-#endif
     }
 
-    static void executeScript(const std::string& script, const std::string& eventName, const std::string& arg1, const std::string& arg2, const std::string& arg3, bool allowAsync = true)
+    static void executeScript(const std::string& script, const std::string& eventName, bool eventAsArgument, const std::string& arg1, const std::string& arg2, const std::string& arg3)
     {
         std::string command = script;
 
-        if (!eventName.empty())
+        if (eventAsArgument)
             command += " " + eventName;
 
         for (auto arg : { arg1, arg2, arg3 })
@@ -99,40 +127,84 @@ namespace Scripting
 #if WIN32
         if (Utils::FileSystem::getExtension(script) == ".ps1")
             command = "powershell " + command;
+#endif
 
-        if (eventName == "quit" || !allowAsync)
+        if (eventName == "quit")
         {
-            LOG(LogDebug) << "  executing: " << command;
+            runCommand(command, true);
+            return;
+        }
 
-            ProcessStartInfo psi;
-            psi.command = command;
-            psi.waitForExit = true;
-            psi.showWindow = false;
-            psi.run();
+        LOG(LogDebug) << "  queuing: " << command;
+
+        // Start using a thread to avoid lags
+        ScriptCommand item;
+        item.script = script;
+        item.eventName = eventName;
+        item.command = command;
+        pushCommand(item);
+    }
+
+    struct ScriptDirectory
+    {
+        time_t                   time;
+        time_t                   scanTime;
+        std::vector<std::string> scripts;
+    };
+
+    static std::map<std::string, ScriptDirectory> _scriptDirectories;
+    static std::mutex                             _scriptDirectoriesLock;
+
+    static std::set<std::string> _supportedExtensions = { ".exe", ".cmd", ".bat", ".ps1", ".sh", ".py" };
+
+    static bool isSupportedScript(const std::string& path)
+    {
+        auto ext = Utils::String::toLower(Utils::FileSystem::getExtension(path));
+        return _supportedExtensions.find(ext) != _supportedExtensions.cend();
+    }
+
+    // Scripts of a directory. The directory is listed again only when its modification time changes ( a script is added, removed or renamed )
+    static std::vector<std::string> getScripts(const std::string& dir, bool eventDirectory)
+    {
+        time_t time = Utils::FileSystem::getFileModificationDate(dir).getTime();
+
+        std::unique_lock<std::mutex> lock(_scriptDirectoriesLock);
+
+        auto it = _scriptDirectories.find(dir);
+
+        // A change in the same second as the scan would keep the same time : list again until the time is in the past
+        if (it != _scriptDirectories.cend() && it->second.time == time && time < it->second.scanTime)
+            return it->second.scripts;
+
+        ScriptDirectory& entry = _scriptDirectories[dir];
+        entry.time = time;
+        entry.scanTime = ::time(nullptr);
+        entry.scripts.clear();
+
+        if (time == 0 || !Utils::FileSystem::exists(dir))
+            return entry.scripts;
+
+        if (eventDirectory)
+        {
+            for (auto script : Utils::FileSystem::getDirContent(dir))
+            {
+#if WIN32
+                if (!isSupportedScript(script))
+                    continue;
+#endif
+                entry.scripts.push_back(script);
+            }
         }
         else
         {
-            LOG(LogDebug) << "  queuing: " << command;
-
-            // Start using a thread to avoid lags
-            pushCommand(command);
+            for (auto script : Utils::FileSystem::getDirectoryFiles(dir))
+                if (!script.directory && isSupportedScript(script.path))
+                    entry.scripts.push_back(script.path);
         }
-#else            
-        LOG(LogDebug) << "  executing: " << script;
 
-        ProcessStartInfo psi;
-        psi.command = command;
-        psi.waitForExit = (eventName == "quit");
-        psi.showWindow = false;
-        // Don't clobber game logs when running scripts
-        psi.stderrFilename = "es_script_stderr.log";
-        psi.stdoutFilename = "es_script_stdout.log";
-        psi.run();
-#endif
+        return entry.scripts;
     }
 
-    static std::set<std::string> _supportedExtensions = { ".exe", ".cmd", ".bat", ".ps1", ".sh", ".py" };
-
     void fireEvent(const std::string& eventName, const std::string& arg1, const std::string& arg2, const std::string& arg3)
     {
         LOG(LogDebug) << "fireEvent: " << eventName << " " << arg1 << " " << arg2 << " " << arg3;
@@ -148,18 +220,8 @@ namespace Scripting
         };
 
         for (auto dir : VectorHelper::distinct(scriptDirList, [](auto x) { return x; }))
-        {
-            auto scripts = Utils::FileSystem::getDirContent(dir);
-            for (auto script : scripts)
-            {
-#if WIN32
-                auto ext = Utils::String::toLower(Utils::FileSystem::getExtension(script));
-                if (_supportedExtensions.find(ext) == _supportedExtensions.cend())
-                    continue;
-#endif
-                executeScript(script, "", arg1, arg2, arg3, eventName != "quit");
-            }
-        }
+            for (auto script : getScripts(dir, true))
+                executeScript(script, eventName, false, arg1, arg2, arg3);
 
         // Process single scripts. This type of scripts are called with the event name as 1st arg
         std::vector<std::string> paths =
@@ -172,21 +234,7 @@ namespace Scripting
         };
 
         for (auto dir : VectorHelper::distinct(paths, [](auto x) { return x; }))
-        {
-            if (!Utils::FileSystem::exists(dir))
-                continue;
-
-            for (auto script : Utils::FileSystem::getDirectoryFiles(dir))
-            {
-                if (script.directory)
-                    continue;
-
-                auto ext = Utils::String::toLower(Utils::FileSystem::getExtension(script.path));
-                if (_supportedExtensions.find(ext) == _supportedExtensions.cend())
-                    continue;
-
-                executeScript(script.path, eventName, arg1, arg2, arg3);
-            }
-        }
+            for (auto script : getScripts(dir, false))
+                executeScript(script, eventName, true, arg1, arg2, arg3);
     }
 } // Scripting::
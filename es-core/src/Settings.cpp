@@ -161,10 +161,12 @@ void Settings::setDefaults()
     mStringMap["Overclock"] = "none";
 
 	mBoolMap["VSync"] = Settings::_VSync;
+	mBoolMap["BatchRendering"] = true;
 	mStringMap["FolderViewMode"] = "never";
 	mStringMap["HiddenSystems"] = "";
 
 	mBoolMap["PublicWebAccess"] = false;	
+	mIntMap["HttpMediaCacheSize"] = 32; // MB
 	mBoolMap["FirstJoystickOnly"] = false;
     mBoolMap["EnableSounds"] = false;
 	mBoolMap["ShowHelpPrompts"] = true;
@@ -234,7 +236,8 @@ void Settings::setDefaults()
 	mBoolMap["ScreenSaverControls"] = true;
 	mStringMap["ScreenSaverGameInfo"] = "never";
 	mBoolMap["StretchVideoOnScreenSaver"] = false;
-	mStringMap["PowerSaverMode"] = "default"; 
+	mStringMap["PowerSaverMode"] = "default";
+	mStringMap["TextureEvictionPolicy"] = "cost"; // lru, cost 
 
 	mBoolMap["StopMusicOnScreenSaver"] = true;
 
@@ -317,10 +320,14 @@ void Settings::setDefaults()
 	mStringMap["DefaultGridSize"] = "";
 
 	mBoolMap["ThreadedLoading"] = true;
+	mBoolMap["ThreadedFolderScan"] = true;
+	mBoolMap["WatchRomFolders"] = false;
 	mBoolMap["AsyncImages"] = true;
 	mBoolMap["PreloadUI"] = false;
 	mBoolMap["PreloadMedias"] = Settings::_PreloadMedias;
 	mBoolMap["OptimizeVRAM"] = true;
+	mBoolMap["DecodedImageCache"] = true;
+	mIntMap["DecodedImageCacheSize"] = 256; // MB
 	mBoolMap["OptimizeVideo"] = true;
 
 	mBoolMap["ShowFilenames"] = false;
@@ -364,6 +371,10 @@ void Settings::setDefaults()
 	
 	mBoolMap["CheevosCheckIndexesAtStart"] = false;	
 
+	// Game hashing : 0 threads is half the cores. Readers limit the files read at the same time ( NAS )
+	mIntMap["HashingThreads"] = 0;
+	mIntMap["HashingReaders"] = 2;
+
 	mBoolMap["AllImagesAsync"] = true;
 
 #if WIN32
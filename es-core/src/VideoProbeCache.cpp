@@ -0,0 +1,288 @@
+#include "VideoProbeCache.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "Paths.h"
+#include "Log.h"
+
+#include <fstream>
+#include <algorithm>
+
+static FILE* openFile(const std::string& path, const char* mode)
+{
+#if defined(_WIN32)
+	return _wfopen(Utils::String::convertToWideString(path).c_str(), Utils::String::convertToWideString(mode).c_str());
+#else
+	return fopen(path.c_str(), mode);
+#endif
+}
+
+VideoProbeCache* VideoProbeCache::getInstance()
+{
+	static VideoProbeCache instance;
+	return &instance;
+}
+
+VideoProbeCache::VideoProbeCache() : mFile(nullptr), mLines(0), mProbeCount(0), mThread(nullptr), mExit(false)
+{
+	mPath = Paths::getUserEmulationStationPath() + "/videoprobe.cache";
+	load();
+}
+
+VideoProbeCache::~VideoProbeCache()
+{
+	if (mThread != nullptr)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mQueueLock);
+			mExit = true;
+			mQueueEvent.notify_one();
+		}
+
+		mThread->join();
+		delete mThread;
+		mThread = nullptr;
+	}
+
+	if (mFile != nullptr)
+		fclose(mFile);
+}
+
+void VideoProbeCache::load()
+{
+	std::ifstream file(WINSTRINGW(mPath));
+	if (!file.is_open())
+		return;
+
+	// size|time|width|height|duration|audio|path
+	std::string line;
+	while (std::getline(file, line))
+	{
+		mLines++;
+
+		std::vector<std::string> parts;
+
+		size_t start = 0;
+		while (parts.size() < 6)
+		{
+			size_t end = line.find('|', start);
+			if (end == std::string::npos)
+				break;
+
+			parts.push_back(line.substr(start, end - start));
+			start = end + 1;
+		}
+
+		if (parts.size() < 6 || start >= line.size())
+			continue;
+
+		Entry entry;
+		entry.size = strtoull(parts[0].c_str(), nullptr, 10);
+		entry.time = (time_t)strtoll(parts[1].c_str(), nullptr, 10);
+		entry.info.width = atoi(parts[2].c_str());
+		entry.info.height = atoi(parts[3].c_str());
+		entry.info.duration = atoi(parts[4].c_str());
+		entry.info.hasAudio = parts[5] == "1";
+
+		// Last line for a file wins
+		mEntries[line.substr(start)] = entry;
+	}
+
+	file.close();
+
+	// Replaced videos leave stale lines behind
+	if (mLines > mEntries.size() * 2 + 256)
+		save();
+}
+
+void VideoProbeCache::save()
+{
+	if (mFile != nullptr)
+	{
+		fclose(mFile);
+		mFile = nullptr;
+	}
+
+	std::string tmpPath = mPath + ".tmp";
+
+	FILE* file = openFile(tmpPath, "wb");
+	if (file == nullptr)
+		return;
+
+	for (auto& item : mEntries)
+	{
+		const Info& info = item.second.info;
+		fprintf(file, "%llu|%lld|%d|%d|%d|%d|%s\n", item.second.size, (long long)item.second.time, info.width, info.height, info.duration, info.hasAudio ? 1 : 0, item.first.c_str());
+	}
+
+	fclose(file);
+
+	Utils::FileSystem::renameFile(tmpPath, mPath);
+	mLines = mEntries.size();
+}
+
+bool VideoProbeCache::getFileInfo(const std::string& path, unsigned long long& size, time_t& time)
+{
+	if (!Utils::FileSystem::exists(path))
+		return false;
+
+	size = Utils::FileSystem::getFileSize(path);
+	time = Utils::FileSystem::getFileModificationDate(path).getTime();
+	return true;
+}
+
+bool VideoProbeCache::find(const std::string& path, Info& info)
+{
+	unsigned long long size;
+	time_t time;
+
+	if (!getFileInfo(path, size, time))
+		return false;
+
+	std::unique_lock<std::mutex> lock(mLock);
+
+	auto it = mEntries.find(path);
+	if (it == mEntries.cend() || it->second.size != size || it->second.time != time)
+		return false;
+
+	info = it->second.info;
+	return true;
+}
+
+void VideoProbeCache::update(const std::string& path, const Info& info)
+{
+	Entry entry;
+	entry.info = info;
+
+	if (!getFileInfo(path, entry.size, entry.time))
+		return;
+
+	std::unique_lock<std::mutex> lock(mLock);
+	mEntries[path] = entry;
+
+	if (mFile == nullptr)
+	{
+		mFile = openFile(mPath, "ab");
+		if (mFile == nullptr)
+			return;
+	}
+
+	fprintf(mFile, "%llu|%lld|%d|%d|%d|%d|%s\n", entry.size, (long long)entry.time, info.width, info.height, info.duration, info.hasAudio ? 1 : 0, path.c_str());
+	fflush(mFile);
+
+	mLines++;
+}
+
+void VideoProbeCache::setProber(const Prober& prober)
+{
+	std::unique_lock<std::mutex> lock(mQueueLock);
+	mProber = prober;
+}
+
+bool VideoProbeCache::probe(const std::string& path)
+{
+	std::unique_lock<std::mutex> lock(mQueueLock);
+
+	if (mProber == nullptr)
+		return false;
+
+	if (mQueued.find(path) != mQueued.cend())
+	{
+		// Already prefetched : move it first
+		auto it = std::find(mPrefetch.begin(), mPrefetch.end(), path);
+		if (it == mPrefetch.end())
+			return true;
+
+		mPrefetch.erase(it);
+	}
+
+	mUrgent.push_back(path);
+	mQueued.insert(path);
+
+	start();
+	mQueueEvent.notify_one();
+	return true;
+}
+
+void VideoProbeCache::prefetch(const std::vector<std::string>& paths)
+{
+	std::unique_lock<std::mutex> lock(mQueueLock);
+
+	if (mProber == nullptr)
+		return;
+
+	for (auto& path : mPrefetch)
+		mQueued.erase(path);
+
+	mPrefetch.clear();
+
+	for (auto& path : paths)
+	{
+		if (path.empty() || mQueued.find(path) != mQueued.cend())
+			continue;
+
+		mPrefetch.push_back(path);
+		mQueued.insert(path);
+	}
+
+	if (mPrefetch.size() == 0)
+		return;
+
+	start();
+	mQueueEvent.notify_one();
+}
+
+// mQueueLock is held
+void VideoProbeCache::start()
+{
+	if (mThread == nullptr)
+		mThread = new std::thread(&VideoProbeCache::run, this);
+}
+
+void VideoProbeCache::run()
+{
+	std::unique_lock<std::mutex> lock(mQueueLock);
+
+	while (!mExit)
+	{
+		mQueueEvent.wait(lock, [this] { return mExit || mUrgent.size() > 0 || mPrefetch.size() > 0; });
+		if (mExit)
+			break;
+
+		std::deque<std::string>& queue = mUrgent.size() > 0 ? mUrgent : mPrefetch;
+
+		std::string path = queue.front();
+		queue.pop_front();
+
+		Prober prober = mProber;
+
+		lock.unlock();
+
+		Info info;
+		if (prober != nullptr && !find(path, info) && Utils::FileSystem::exists(path))
+		{
+			ProbeResult result = prober(path, info);
+
+			// Files that can't be opened are stored without tracks, so players don't queue them again
+			if (result == PROBE_FAILED)
+			{
+				LOG(LogDebug) << "VideoProbeCache : unable to probe " << path;
+				info = Info();
+			}
+
+			if (result == PROBE_RETRY)
+				LOG(LogDebug) << "VideoProbeCache : probe timed out for " << path;
+			else
+				update(path, info);
+		}
+
+		lock.lock();
+
+		// Removed after the update, so probe() doesn't queue the file a second time while it's parsed
+		mQueued.erase(path);
+
+		// Players wait for the count to change : skipped probes would make them queue the file again at once
+		if (prober != nullptr)
+			mProbeCount++;
+	}
+}
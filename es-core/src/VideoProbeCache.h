@@ -0,0 +1,97 @@
+#pragma once
+#ifndef ES_CORE_VIDEO_PROBE_CACHE_H
+#define ES_CORE_VIDEO_PROBE_CACHE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <cstdio>
+
+//
+// Video properties found by the media parser in previous runs ( videoprobe.cache ), keyed by path, size & modification time.
+// Unknown files are probed by a worker thread : urgent requests come from the players, prefetches from the opened game lists.
+//
+class VideoProbeCache
+{
+public:
+	struct Info
+	{
+		Info() : width(0), height(0), duration(0), hasAudio(false) { }
+
+		int		width;		// 0 when there's no video track
+		int		height;
+		int		duration;	// ms
+		bool	hasAudio;
+	};
+
+	enum ProbeResult
+	{
+		PROBE_DONE,
+		PROBE_FAILED,	// Stored without tracks : it would fail again
+		PROBE_RETRY		// Timed out ( cold storage, busy system ) : not stored, probed again on the next request
+	};
+
+	typedef std::function<ProbeResult(const std::string& path, Info& info)> Prober;
+
+	static VideoProbeCache* getInstance();
+
+	// Set by the video player able to parse medias
+	void setProber(const Prober& prober);
+
+	bool find(const std::string& path, Info& info);
+
+	// Probes the file before any prefetched one. False when no prober is set
+	bool probe(const std::string& path);
+	// Replaces the pending prefetches
+	void prefetch(const std::vector<std::string>& paths);
+
+	// Incremented each time a probe completes
+	unsigned int getProbeCount() { return mProbeCount; }
+
+private:
+	VideoProbeCache();
+	~VideoProbeCache();
+
+	struct Entry
+	{
+		unsigned long long	size;
+		time_t				time;
+		Info				info;
+	};
+
+	bool getFileInfo(const std::string& path, unsigned long long& size, time_t& time);
+	void update(const std::string& path, const Info& info);
+
+	void start();
+	void run();
+
+	void load();
+	void save();
+
+	std::string							   mPath;
+	std::unordered_map<std::string, Entry> mEntries;
+	std::mutex							   mLock;
+	FILE*								   mFile;
+	size_t								   mLines;
+
+	Prober								   mProber;
+
+	std::mutex							   mQueueLock;
+	std::condition_variable				   mQueueEvent;
+	std::deque<std::string>				   mUrgent;
+	std::deque<std::string>				   mPrefetch;
+	std::unordered_set<std::string>		   mQueued;
+
+	std::atomic<unsigned int>			   mProbeCount;
+	std::thread*						   mThread;
+	bool								   mExit;
+};
+
+#endif // ES_CORE_VIDEO_PROBE_CACHE_H
@@ -442,6 +442,8 @@ void Window::update(int deltaTime)
 	processSongTitleNotifications();
 	processNotificationMessages();
 
+	Font::uploadPrewarmedGlyphs();
+
 	if (mNormalizeNextUpdate)
 	{
 		mNormalizeNextUpdate = false;
@@ -477,6 +479,12 @@ void Window::update(int deltaTime)
 
 			ss << "\nFont VRAM: " << fontVramUsageMb << " Tex VRAM: " << textureVramUsageMb << " Known Tex: " << textureTotalUsageMb << " Max VRAM: " << max_texture;
 
+			auto texStats = TextureResource::getCacheStatistics();
+			ss << "\nTex hits: " << texStats.hits << " misses: " << texStats.misses << " evictions: " << texStats.evictions << " dropped: " << texStats.queueDrops;
+
+			auto frameStats = Renderer::getFrameStats();
+			ss << "\nDraw calls: " << frameStats.drawCalls << " batched: " << frameStats.batchedDraws << " vertices: " << frameStats.vertices << " uploads: " << frameStats.textureUploads << " states: " << frameStats.stateChanges;
+
 			mFrameDataText = std::unique_ptr<TextCache>(mDefaultFonts.at(0)->buildTextCache(ss.str(), Vector2f(50.f, 50.f), 0xFFFF40FF, 0.0f, ALIGN_LEFT, 1.2f));			
 		}
 
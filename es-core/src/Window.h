@@ -90,6 +90,7 @@ public:
 	void startScreenSaver();
 	bool cancelScreenSaver();
 	void renderScreenSaver();
+	inline bool isScreenSaverActive() const { return mRenderScreenSaver; }
 
 	void postToUiThread(const std::function<void()>& func, void* data = nullptr);
 	void unregisterPostedFunctions(void* data);
@@ -8,6 +8,7 @@
 #include "Window.h"
 #include "Log.h"
 #include "BindingManager.h"
+#include "resources/TextureData.h"
 
 // buffer values for scrolling velocity (left, stopped, right)
 const int logoBuffersLeft[] = { -5, -2, -1 };
@@ -260,11 +261,19 @@ void CarouselComponent::onCursorChanged(const CursorState& state)
 
 	for (int i = 0; i < mEntries.size(); i++)
 	{
+		auto logo = mEntries.at(i).data.logo;
+		if (logo == nullptr)
+			continue;
+
+		// Logos closest to the new cursor load first, the ones we scrolled past wait
+		int distance = abs(i - mCursor);
+		distance = Math::min(distance, (int)mEntries.size() - distance);
+		logo->setLoadPriority(distance <= mMaxLogoCount ? distance : TEXTURE_LOAD_PRIORITY_OFFSCREEN);
+
 		if ((cursorHasStoryboard && i == mCursor) || (oldCursorHasStoryboard && i == oldCursor))
 			continue;
 
-		auto logo = mEntries.at(i).data.logo;
-		if (logo && logo->selectStoryboard("scroll"))
+		if (logo->selectStoryboard("scroll"))
 			logo->startStoryboard();
 	}
 
@@ -51,6 +51,7 @@ ImageComponent::ImageComponent(Window* window, bool forceLoad, bool dynamic) : G
 	mRoundCorners = 0.0f;
 	
 	mPlaylistTimer = 0;
+	mLoadPriority = TEXTURE_LOAD_PRIORITY_UNSET;
 	updateColors();
 }
 
@@ -58,6 +59,9 @@ ImageComponent::~ImageComponent()
 {
 	if (mTexture != nullptr)
 		mTexture->setRequired(false);
+
+	releaseLoadPriority(mTexture);
+	releaseLoadPriority(mLoadingTexture);
 }
 
 void ImageComponent::setSize(float w, float h)
@@ -324,6 +328,9 @@ void ImageComponent::setImage(const std::string&  path, bool tile, const MaxSize
 	if (mTexture != nullptr)
 		mTexture->setRequired(false);
 
+	releaseLoadPriority(mTexture);
+	releaseLoadPriority(mLoadingTexture);
+
 	// If the previous image is in the async queue, remove it
 	if (mLoadingTexture && mLoadingTexture.use_count() == 1 && !mLoadingTexture->isLoaded())
 		TextureResource::cancelAsync(mLoadingTexture);
@@ -382,6 +389,15 @@ void ImageComponent::setImage(const std::string&  path, bool tile, const MaxSize
 		}
 	}
 
+	if (mLoadPriority != TEXTURE_LOAD_PRIORITY_UNSET)
+	{
+		if (mTexture != nullptr)
+			mTexture->setLoadPriority(mLoadPriority, this);
+
+		if (mLoadingTexture != nullptr)
+			mLoadingTexture->setLoadPriority(mLoadPriority, this);
+	}
+
 	if (mShowing && mTexture != nullptr)
 	{
 		mTexture->reload();
@@ -392,12 +408,35 @@ void ImageComponent::setImage(const std::string&  path, bool tile, const MaxSize
 		resize();
 }
 
+void ImageComponent::setLoadPriority(int priority)
+{
+	if (mLoadPriority == priority)
+		return;
+
+	mLoadPriority = priority;
+
+	if (mTexture != nullptr)
+		mTexture->setLoadPriority(priority, this);
+
+	if (mLoadingTexture != nullptr)
+		mLoadingTexture->setLoadPriority(priority, this);
+
+	GuiComponent::setLoadPriority(priority);
+}
+
+void ImageComponent::releaseLoadPriority(const std::shared_ptr<TextureResource>& texture)
+{
+	if (texture != nullptr && mLoadPriority != TEXTURE_LOAD_PRIORITY_UNSET)
+		texture->setLoadPriority(TEXTURE_LOAD_PRIORITY_UNSET, this);
+}
+
 void ImageComponent::setImage(const char* path, size_t length, bool tile)
 {
 	mPath = "";
 	if (mTexture != nullptr)
 		mTexture->setRequired(false);
 
+	releaseLoadPriority(mTexture);
 	mTexture.reset();
 
 	if (path != nullptr)
@@ -414,8 +453,12 @@ void ImageComponent::setImage(const std::shared_ptr<TextureResource>& texture)
 	if (mTexture != nullptr)
 		mTexture->setRequired(false);
 
+	releaseLoadPriority(mTexture);
 	mTexture = texture;
 
+	if (mTexture != nullptr && mLoadPriority != TEXTURE_LOAD_PRIORITY_UNSET)
+		mTexture->setLoadPriority(mLoadPriority, this);
+
 	if (isShowing() && mTexture != nullptr)
 		mTexture->setRequired(true);
 
@@ -619,6 +662,7 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 		if (mTexture != nullptr)
 			mTexture->setRequired(false);
 
+		releaseLoadPriority(mTexture);
 		mTexture = mLoadingTexture;
 
 		if (isShowing() && mTexture != nullptr)
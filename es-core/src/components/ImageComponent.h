@@ -111,6 +111,7 @@ public:
 	void onHide() override;
 	void update(int deltaTime) override;
 	void onPaddingChanged() override;
+	void setLoadPriority(int priority) override;
 
 	void setPlaylist(std::shared_ptr<IPlaylist> playList);
 
@@ -133,6 +134,7 @@ public:
 protected:
 	std::shared_ptr<TextureResource> mTexture;
 	std::shared_ptr<TextureResource> mLoadingTexture;
+	int mLoadPriority;
 
 	Vector2f mTargetSize;
 
@@ -149,6 +151,8 @@ private:
 	void updateVertices();
 	void updateColors();
 	void updateRoundCorners();
+	// Withdraws our priority from a texture we stop using ( see TextureDataManager::setLoadPriority )
+	void releaseLoadPriority(const std::shared_ptr<TextureResource>& texture);
 
 	void fadeIn(bool textureLoaded);
 
@@ -397,6 +397,9 @@ void ImageGridComponent<T>::ensureVisibleTileExist()
 					entry.data.tile->onShow();
 			}
 
+			// Rows closest to the cursor load their images first
+			entry.data.tile->setLoadPriority(abs(i / dimOpposite - mCursor / dimOpposite));
+
 			if (mScrollLoop && i < startIndex || i > endIndex)
 			{
 				auto tile = createTile(idx, dimOpposite, tileDistance, startPosition);
@@ -407,7 +410,10 @@ void ImageGridComponent<T>::ensureVisibleTileExist()
 		else if (entry.data.tile != nullptr)
 		{
 			if (entry.data.tile->isVisible())
+			{
 				entry.data.tile->setVisible(false);
+				entry.data.tile->setLoadPriority(TEXTURE_LOAD_PRIORITY_OFFSCREEN);
+			}
 
 			auto it = std::find(mVisibleTiles.cbegin(), mVisibleTiles.cend(), entry.data.tile);
 			if (it != mVisibleTiles.cend())
@@ -15,6 +15,7 @@
 #include "utils/Delegate.h"
 #include "CarouselComponent.h"
 #include "BindingManager.h"
+#include "resources/TextureData.h"
 
 #define HOLD_TIME 1000
 
@@ -88,9 +89,27 @@ public:
 
 	inline void setFont(const std::shared_ptr<Font>& font)
 	{
+		bool changed = mFont != font;
+
 		mFont = font;
 		for (auto it = mEntries.begin(); it != mEntries.end(); it++)
 			it->data.textCache.reset();
+
+		if (changed)
+			prewarmGlyphs();
+	}
+
+	// Rasterises the characters of all entries in background, before they scroll into view
+	void prewarmGlyphs()
+	{
+		if (mFont == nullptr || mEntries.empty())
+			return;
+
+		std::string text;
+		for (auto it = mEntries.cbegin(); it != mEntries.cend(); it++)
+			text += it->name;
+
+		mFont->prewarmGlyphs(mUppercase ? Utils::String::toUpper(text) : text);
 	}
 
 	inline void setUppercase(bool uppercase)
@@ -296,7 +315,10 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 					entry.data.itemTemplate->onHide();
 
 				if (entry.data.itemTemplate->isVisible())
+				{
 					entry.data.itemTemplate->setVisible(false);
+					entry.data.itemTemplate->setLoadPriority(TEXTURE_LOAD_PRIORITY_OFFSCREEN);
+				}
 			}
 
 			continue;
@@ -327,6 +349,9 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 		
 		if (entry.data.itemTemplate)
 		{
+			// Rows closest to the cursor load their images first
+			entry.data.itemTemplate->setLoadPriority(abs(i - mCursor));
+
 			if (!entry.data.itemTemplate->isVisible())
 				entry.data.itemTemplate->setVisible(true);
 
@@ -71,6 +71,9 @@ VideoVlcComponent::VideoVlcComponent(Window* window) : VideoComponent(window),
 	mLoops = -1;
 	mCurrentLoop = 0;
 
+	mProbePending = false;
+	mProbeCount = 0;
+
 	// Get an empty texture for rendering the video
 	mTexture = nullptr;// TextureResource::get("");
 	mEffect = VideoVlcFlags::VideoVlcEffect::BUMP;
@@ -677,6 +680,69 @@ void VideoVlcComponent::init()
 	mVLC = libvlc_new(cmdline.size(), theArgs);
 
 	delete[] theArgs;
+
+	if (mVLC != nullptr)
+		VideoProbeCache::getInstance()->setProber(&VideoVlcComponent::probeMedia);
+}
+
+VideoProbeCache::ProbeResult VideoVlcComponent::probeMedia(const std::string& videoPath, VideoProbeCache::Info& info)
+{
+	if (mVLC == nullptr)
+		return VideoProbeCache::PROBE_RETRY;
+
+#ifdef WIN32
+	std::string path(Utils::String::replace(videoPath, "/", "\\"));
+#else
+	std::string path(videoPath);
+#endif
+
+	libvlc_media_t* media = libvlc_media_new_path(mVLC, path.c_str());
+	if (media == nullptr)
+		return VideoProbeCache::PROBE_FAILED;
+
+	// Get the media metadata so we can find the aspect ratio
+#ifdef WIN32
+	// It looks like an older version of the library is being used on Windows
+	libvlc_media_parse(media);
+#else
+	if (libvlc_media_parse_with_options(media, libvlc_media_parse_local, 5000) == -1)
+	{
+		libvlc_media_release(media);
+		return VideoProbeCache::PROBE_FAILED;
+	}
+
+	libvlc_media_parsed_status_t status;
+	while ((status = libvlc_media_get_parsed_status(media)) == 0)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	// Failed parsings are stored : they would fail again. Timed out ones may succeed once the storage is awake
+	if (status == libvlc_media_parsed_status_timeout)
+	{
+		libvlc_media_release(media);
+		return VideoProbeCache::PROBE_RETRY;
+	}
+#endif
+
+	libvlc_media_track_t** tracks;
+	unsigned track_count = libvlc_media_tracks_get(media, &tracks);
+	for (unsigned track = 0; track < track_count; ++track)
+	{
+		if (tracks[track]->i_type == libvlc_track_audio)
+			info.hasAudio = true;
+		else if (tracks[track]->i_type == libvlc_track_video && info.width == 0 && info.height == 0)
+		{
+			info.width = tracks[track]->video->i_width;
+			info.height = tracks[track]->video->i_height;
+		}
+	}
+	libvlc_media_tracks_release(tracks, track_count);
+
+	info.duration = (int)libvlc_media_get_duration(media);
+	if (info.duration < 0)
+		info.duration = 0;
+
+	libvlc_media_release(media);
+	return VideoProbeCache::PROBE_DONE;
 }
 
 void VideoVlcComponent::handleLooping()
@@ -748,6 +814,17 @@ if (!Utils::FileSystem::exists(mVideoPath))
 	
 
 	
+	VideoProbeCache::Info probeInfo;
+	if (!VideoProbeCache::getInstance()->find(mVideoPath, probeInfo))
+	{
+		// Parsed by a worker thread, update() starts the video once the result is known
+		mProbeCount = VideoProbeCache::getInstance()->getProbeCount();
+		mProbePending = VideoProbeCache::getInstance()->probe(mVideoPath);
+		return;
+	}
+
+	mProbePending = false;
+
 	if (hasStoryBoard("", true) && mConfig.startDelay > 0)
 		startStoryboard();
 
@@ -787,34 +864,10 @@ if (!Utils::FileSystem::exists(mVideoPath))
 			if (mPlaylist != nullptr && mConfig.startDelay == 0 && !mConfig.showSnapshotDelay && !mConfig.showSnapshotNoVideo)
 				libvlc_media_add_option(mMedia, ":start-time=0.7");			
 
-			bool hasAudioTrack = false;
-
-			unsigned track_count;
-			// Get the media metadata so we can find the aspect ratio
-#ifdef WIN32
-			// It looks like an older version of the library is being used on Windows
-			libvlc_media_parse(mMedia);
-#else
-			libvlc_media_parse_with_options(mMedia, libvlc_media_parse_local, 0);
-			while (libvlc_media_get_parsed_status(mMedia) != libvlc_media_parsed_status_done)
-				std::this_thread::sleep_for(std::chrono::milliseconds(10));
-#endif
-			libvlc_media_track_t** tracks;
-			track_count = libvlc_media_tracks_get(mMedia, &tracks);
-			for (unsigned track = 0; track < track_count; ++track)
-			{
-				if (tracks[track]->i_type == libvlc_track_audio)
-					hasAudioTrack = true;
-				else if (tracks[track]->i_type == libvlc_track_video)
-				{
-					mVideoWidth = tracks[track]->video->i_width;
-					mVideoHeight = tracks[track]->video->i_height;		
+			bool hasAudioTrack = probeInfo.hasAudio;
 
-					if (hasAudioTrack)
-						break;
-				}
-			}
-			libvlc_media_tracks_release(tracks, track_count);
+			mVideoWidth = probeInfo.width;
+			mVideoHeight = probeInfo.height;
 
 			if (mVideoWidth == 0 && mVideoHeight == 0 && Utils::FileSystem::isAudio(path))
 			{
@@ -882,6 +935,7 @@ if (!Utils::FileSystem::exists(mVideoPath))
 
 void VideoVlcComponent::stopVideo()
 {
+	mProbePending = false;
 	mIsPlaying = false;
 	mIsWaitingForVideoToStart = false;
 	mStartDelayed = false;
@@ -960,6 +1014,10 @@ void VideoVlcComponent::update(int deltaTime)
 {
 	mElapsed += deltaTime;
 
+	// The worker thread has probed a file since startVideo : maybe ours
+	if (mProbePending && mIsWaitingForVideoToStart && !mIsPlaying && mProbeCount != VideoProbeCache::getInstance()->getProbeCount())
+		startVideo();
+
 	if (mConfig.showSnapshotNoVideo || mConfig.showSnapshotDelay)
 		mStaticImage.update(deltaTime);
 
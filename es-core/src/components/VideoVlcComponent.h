@@ -5,6 +5,7 @@
 #include "VideoComponent.h"
 #include "ThemeData.h"
 #include "renderers/Renderer.h"
+#include "VideoProbeCache.h"
 #include <mutex>
 
 struct libvlc_instance_t;
@@ -120,6 +121,9 @@ private:
 	void setupContext();
 	void freeContext();
 
+	// Runs on the VideoProbeCache worker thread
+	static VideoProbeCache::ProbeResult probeMedia(const std::string& videoPath, VideoProbeCache::Info& info);
+
 private:
 	void crop(float left, float top, float right, float bot);
 
@@ -144,6 +148,9 @@ private:
 	bool							mLinearSmooth;
 	float							mSaturation;
 
+	bool							mProbePending;
+	unsigned int					mProbeCount;
+
 	void updateVertices();
 	void updateColors();
 	void updateRoundCorners();
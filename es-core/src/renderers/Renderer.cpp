@@ -3,6 +3,7 @@
 #include "Renderer_GL21.h"
 #include "Renderer_GLES10.h"
 #include "Renderer_GLES20.h"
+#include "Renderer_Null.h"
 
 #include "math/Transform4x4f.h"
 #include "math/Vector2i.h"
@@ -791,6 +792,13 @@ namespace Renderer
 		}
 #endif
 
+		// Headless, not listed in getRendererNames
+		{
+			NullRenderer rd;
+			if (rd.getDriverName() == name)
+				return new NullRenderer();
+		}
+
 		return nullptr;
 	}
 
@@ -971,6 +979,11 @@ namespace Renderer
 		return Instance()->getTotalMemUsage();
 	}
 
+	FrameStats getFrameStats()
+	{
+		return Instance()->getFrameStats();
+	}
+
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 	bool  ScreenSettings::isSmallScreen()
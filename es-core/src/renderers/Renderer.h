@@ -96,6 +96,18 @@ namespace Renderer
 
 	}; // Vertex
 
+	struct FrameStats
+	{
+		FrameStats() : drawCalls(0), batchedDraws(0), vertices(0), textureUploads(0), stateChanges(0) { }
+
+		unsigned int drawCalls;		// glDrawArrays calls
+		unsigned int batchedDraws;	// draws merged into a batch instead of being submitted alone
+		unsigned int vertices;		// vertices uploaded
+		unsigned int textureUploads;	// texture creations with data & texture updates
+		unsigned int stateChanges;	// texture binds, scissor & stencil changes
+
+	}; // FrameStats
+
 	class IRenderer
 	{
 	public:
@@ -137,6 +149,9 @@ namespace Renderer
 
 		virtual size_t		 getTotalMemUsage() { return (size_t) -1; };
 
+		// Statistics of the last rendered frame
+		virtual FrameStats	 getFrameStats() { return FrameStats(); }
+
 		virtual bool		 supportShaders() { return false; }
 		virtual bool		 shaderSupportsCornerSize(const std::string& shader) { return false; };
 	};
@@ -204,6 +219,7 @@ namespace Renderer
 	void		 postProcessShader (const std::string& path, const float _x, const float _y, const float _w, const float _h, const std::map<std::string, std::string>& parameters, unsigned int* data = nullptr);
 
 	size_t		 getTotalMemUsage  ();
+	FrameStats	 getFrameStats     ();
 
 	bool		 supportShaders();
 	bool		 shaderSupportsCornerSize(const std::string& shader);
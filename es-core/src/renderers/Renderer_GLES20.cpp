@@ -53,12 +53,15 @@ namespace Renderer
 
 	static ShaderProgram* currentProgram = nullptr;
 	
-	static void useProgram(ShaderProgram* program)
+	// worldSpace : vertices are already transformed by the world view matrix ( batched draws )
+	static void useProgram(ShaderProgram* program, bool worldSpace = false)
 	{
+		Transform4x4f& matrix = worldSpace ? projectionMatrix : mvpMatrix;
+
 		if (program == currentProgram)
 		{
 			if (currentProgram != nullptr)
-				currentProgram->setMatrix(mvpMatrix);
+				currentProgram->setMatrix(matrix);
 
 			return;
 		}
@@ -71,7 +74,7 @@ namespace Renderer
 		if (currentProgram != nullptr)
 		{
 			currentProgram->select();
-			currentProgram->setMatrix(mvpMatrix);
+			currentProgram->setMatrix(matrix);
 		}
 	}
 
@@ -364,13 +367,54 @@ namespace Renderer
 
 //////////////////////////////////////////////////////////////////////////
 
+	// The vertex buffer is allocated once and used as a ring : each upload is written after the previous one,
+	// the storage is orphaned and written again from the start when it is full.
+	static unsigned int		vertexBufferSize   = 16384;
+	static unsigned int		vertexBufferCursor = 0;
+
+	static const Vertex*	lastUploadVertices = nullptr;
+	static unsigned int		lastUploadCount    = 0;
+	static GLint			lastUploadFirst    = 0;
+
+	static FrameStats		frameStats;
+	static FrameStats		lastFrameStats;
+
 	static void setupVertexBuffer()
 	{
 		GL_CHECK_ERROR(glGenBuffers(1, &vertexBuffer));
 		GL_CHECK_ERROR(glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer));
+		GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexBufferSize, nullptr, GL_STREAM_DRAW));
+
+		vertexBufferCursor = 0;
+		lastUploadVertices = nullptr;
 
 	} // setupVertexBuffer
 
+	// Returns the index of the first uploaded vertex, to give to glDrawArrays
+	static GLint uploadVertices(const Vertex* _vertices, const unsigned int _numVertices)
+	{
+		if (vertexBufferCursor + _numVertices > vertexBufferSize)
+		{
+			while (vertexBufferSize < _numVertices)
+				vertexBufferSize *= 2;
+
+			GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexBufferSize, nullptr, GL_STREAM_DRAW));
+			vertexBufferCursor = 0;
+		}
+
+		GL_CHECK_ERROR(glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexBufferCursor, sizeof(Vertex) * _numVertices, _vertices));
+
+		lastUploadVertices = _vertices;
+		lastUploadCount = _numVertices;
+		lastUploadFirst = vertexBufferCursor;
+
+		vertexBufferCursor += _numVertices;
+		frameStats.vertices += _numVertices;
+
+		return lastUploadFirst;
+
+	} // uploadVertices
+
 //////////////////////////////////////////////////////////////////////////
 
 	static GLenum convertBlendFactor(const Blend::Factor _blendFactor)
@@ -392,6 +436,140 @@ namespace Renderer
 
 	} // convertBlendFactor
 
+//////////////////////////////////////////////////////////////////////////
+
+	static void drawArrays(const GLenum _mode, const GLint _first, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if (_srcBlendFactor != Blend::ONE && _dstBlendFactor != Blend::ONE)
+		{
+			GL_CHECK_ERROR(glEnable(GL_BLEND));
+			GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
+			GL_CHECK_ERROR(glDrawArrays(_mode, _first, _numVertices));
+			GL_CHECK_ERROR(glDisable(GL_BLEND));
+		}
+		else
+		{
+			GL_CHECK_ERROR(glDisable(GL_BLEND));
+			GL_CHECK_ERROR(glDrawArrays(_mode, _first, _numVertices));
+		}
+
+		frameStats.drawCalls++;
+
+	} // drawArrays
+
+//////////////////////////////////////////////////////////////////////////
+
+	//
+	// Consecutive draws sharing the texture, the shader and the blend state are merged into a single glDrawArrays.
+	// Their vertices are moved to world space on the CPU, so setMatrix doesn't break a batch.
+	// Any other state change ( texture, scissor, stencil, viewport, projection, texture upload ) flushes it first.
+	//
+	struct DrawBatch
+	{
+		DrawBatch() : program(nullptr), texture(0), srcBlendFactor(Blend::SRC_ALPHA), dstBlendFactor(Blend::ONE_MINUS_SRC_ALPHA), saturation(1.0f) { }
+
+		std::vector<Vertex>	vertices; // GL_TRIANGLES
+		ShaderProgram*		program;
+		unsigned int		texture;
+		Blend::Factor		srcBlendFactor;
+		Blend::Factor		dstBlendFactor;
+		float				saturation;
+	};
+
+	static DrawBatch		drawBatch;
+	static bool				batchingEnabled = true;
+
+	static void flushBatch()
+	{
+		if (drawBatch.vertices.empty())
+			return;
+
+		GLint first = uploadVertices(drawBatch.vertices.data(), drawBatch.vertices.size());
+
+		useProgram(drawBatch.program, true);
+
+		if (drawBatch.program == &shaderProgramColorTexture)
+		{
+			shaderProgramColorTexture.setSaturation(drawBatch.saturation);
+			shaderProgramColorTexture.setCornerRadius(0.0f);
+		}
+
+		drawArrays(GL_TRIANGLES, first, drawBatch.vertices.size(), drawBatch.srcBlendFactor, drawBatch.dstBlendFactor);
+		drawBatch.vertices.clear();
+
+	} // flushBatch
+
+	static inline void addBatchVertex(const Vertex& _vertex, const float* _matrix)
+	{
+		drawBatch.vertices.push_back(_vertex);
+
+		Vertex& vertex = drawBatch.vertices.back();
+		vertex.pos = Vector2f(
+			_matrix[0] * _vertex.pos.x() + _matrix[4] * _vertex.pos.y() + _matrix[12],
+			_matrix[1] * _vertex.pos.x() + _matrix[5] * _vertex.pos.y() + _matrix[13]);
+		vertex.customShader = nullptr;
+	}
+
+	// Returns false if the draw can't be batched and must be submitted by the caller
+	static bool queueTriangles(ShaderProgram* _program, const GLenum _mode, const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor, const float _saturation)
+	{
+		if (!batchingEnabled)
+			return false;
+
+		if (_numVertices < 3)
+			return true;
+
+		unsigned int count = (_numVertices - 2) * 3;
+		if (count > vertexBufferSize)
+			return false;
+
+		bool blend = _srcBlendFactor != Blend::ONE && _dstBlendFactor != Blend::ONE;
+		bool batchBlend = drawBatch.srcBlendFactor != Blend::ONE && drawBatch.dstBlendFactor != Blend::ONE;
+
+		if (!drawBatch.vertices.empty() && (
+			drawBatch.program != _program ||
+			drawBatch.texture != boundTexture ||
+			blend != batchBlend ||
+			(blend && (drawBatch.srcBlendFactor != _srcBlendFactor || drawBatch.dstBlendFactor != _dstBlendFactor)) ||
+			(_program == &shaderProgramColorTexture && drawBatch.saturation != _saturation) ||
+			drawBatch.vertices.size() + count > vertexBufferSize))
+			flushBatch();
+
+		if (drawBatch.vertices.empty())
+		{
+			drawBatch.program = _program;
+			drawBatch.texture = boundTexture;
+			drawBatch.srcBlendFactor = _srcBlendFactor;
+			drawBatch.dstBlendFactor = _dstBlendFactor;
+			drawBatch.saturation = _saturation;
+		}
+
+		const float* matrix = (const float*)&worldViewMatrix;
+
+		if (_mode == GL_TRIANGLE_FAN)
+		{
+			for (unsigned int i = 1; i < _numVertices - 1; i++)
+			{
+				addBatchVertex(_vertices[0], matrix);
+				addBatchVertex(_vertices[i], matrix);
+				addBatchVertex(_vertices[i + 1], matrix);
+			}
+		}
+		else
+		{
+			for (unsigned int i = 0; i < _numVertices - 2; i++)
+			{
+				addBatchVertex(_vertices[i], matrix);
+				addBatchVertex(_vertices[i + 1], matrix);
+				addBatchVertex(_vertices[i + 2], matrix);
+			}
+		}
+
+		frameStats.batchedDraws++;
+		return true;
+
+	} // queueTriangles
+
 //////////////////////////////////////////////////////////////////////////
 
 	static GLenum convertTextureType(const Texture::Type _type)
@@ -605,6 +783,7 @@ namespace Renderer
 
 	void GLES20Renderer::resetCache()
 	{
+		flushBatch();
 		bindTexture(0);
 
 		for (auto customShader : _customShaderBatch)
@@ -657,6 +836,11 @@ namespace Renderer
 	{
 		const GLenum type = convertTextureType(_type);
 
+		flushBatch();
+
+		if (_data != nullptr)
+			frameStats.textureUploads++;
+
 		unsigned int texture = -1;
 		GL_CHECK_ERROR(glGenTextures(1, &texture));
 
@@ -736,6 +920,8 @@ namespace Renderer
 
 	void GLES20Renderer::destroyTexture(const unsigned int _texture)
 	{
+		flushBatch();
+
 		auto it = _textures.find(_texture);
 		if (it != _textures.cend())
 		{
@@ -758,8 +944,12 @@ namespace Renderer
 	{
 		const GLenum type = convertTextureType(_type);
 
+		// Queued draws may use the previous content
+		flushBatch();
 		bindTexture(_texture);
 
+		frameStats.textureUploads++;
+
 		// Regular GL_ALPHA textures are black + alpha in shaders
 		// Create a GL_LUMINANCE_ALPHA texture instead so its white + alpha
 		if (type == GL_LUMINANCE_ALPHA)
@@ -807,7 +997,9 @@ namespace Renderer
 		if (boundTexture == _texture)
 			return;
 
+		flushBatch();
 		boundTexture = _texture;
+		frameStats.stateChanges++;
 
 		if(_texture == 0)
 		{
@@ -826,24 +1018,15 @@ namespace Renderer
 
 	void GLES20Renderer::drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
+		flushBatch();
+
 		// Pass buffer data
-		GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_DYNAMIC_DRAW));
+		GLint first = uploadVertices(_vertices, _numVertices);
 
 		useProgram(&shaderProgramColorNoTexture);
 
 		// Do rendering
-		if (_srcBlendFactor != Blend::ONE && _dstBlendFactor != Blend::ONE)
-		{
-			GL_CHECK_ERROR(glEnable(GL_BLEND));
-			GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
-			GL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, _numVertices));
-			GL_CHECK_ERROR(glDisable(GL_BLEND));
-		}
-		else
-		{
-			GL_CHECK_ERROR(glDisable(GL_BLEND));
-			GL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, _numVertices));
-		}
+		drawArrays(GL_LINES, first, _numVertices, _srcBlendFactor, _dstBlendFactor);
 
 	} // drawLines
 
@@ -865,6 +1048,7 @@ namespace Renderer
 			return;
 		}
 
+		flushBatch();
 		bindTexture(0);
 		useProgram(&shaderProgramColorNoTexture);
 
@@ -875,8 +1059,9 @@ namespace Renderer
 
 		if ((_fillColor) & 0xFF)
 		{
-			GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * inner.size(), inner.data(), GL_DYNAMIC_DRAW));
-			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_FAN, 0, inner.size()));
+			GLint first = uploadVertices(inner.data(), inner.size());
+			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_FAN, first, inner.size()));
+			frameStats.drawCalls++;
 		}
 
 		if ((_borderColor) & 0xFF && borderWidth > 0)
@@ -889,8 +1074,9 @@ namespace Renderer
 			GL_CHECK_ERROR(glEnable(GL_BLEND));
 			GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(Blend::SRC_ALPHA), convertBlendFactor(Blend::ONE_MINUS_SRC_ALPHA)));
 
-			GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * outer.size(), outer.data(), GL_DYNAMIC_DRAW));
-			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_FAN, 0, outer.size()));
+			GLint first = uploadVertices(outer.data(), outer.size());
+			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_FAN, first, outer.size()));
+			frameStats.drawCalls++;
 			
 			disableStencil();
 		}
@@ -900,20 +1086,35 @@ namespace Renderer
 
 	void GLES20Renderer::drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor, bool verticesChanged)
 	{
-		if (verticesChanged)
-			GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_DYNAMIC_DRAW));
+		auto it = boundTexture == 0 ? _textures.cend() : _textures.find(boundTexture);
+		bool alphaTexture = it != _textures.cend() && it->second != nullptr && it->second->type == GL_ALPHA;
+		bool hasCustomShader = _vertices->customShader != nullptr && !_vertices->customShader->path.empty();
+
+		// Custom shaders & rounded corners need per-draw uniforms : they are not batched
+		if (boundTexture == 0 || alphaTexture || (!hasCustomShader && _vertices->cornerRadius == 0.0f))
+		{
+			ShaderProgram* program = boundTexture == 0 ? &shaderProgramColorNoTexture : (alphaTexture ? &shaderProgramAlpha : &shaderProgramColorTexture);
+			if (queueTriangles(program, GL_TRIANGLE_STRIP, _vertices, _numVertices, _srcBlendFactor, _dstBlendFactor, _vertices->saturation))
+				return;
+		}
+
+		flushBatch();
+
+		// Unchanged vertices are still in the buffer if they were the last upload
+		GLint first = lastUploadFirst;
+		if (verticesChanged || lastUploadVertices != _vertices || lastUploadCount != _numVertices)
+			first = uploadVertices(_vertices, _numVertices);
 
 		// Setup shader
 		if (boundTexture != 0)
 		{
-			auto it = _textures.find(boundTexture);
-			if (it != _textures.cend() && it->second != nullptr && it->second->type == GL_ALPHA)
+			if (alphaTexture)
 				useProgram(&shaderProgramAlpha);
 			else
 			{
 				ShaderProgram* shader = &shaderProgramColorTexture;
 
-				if (_vertices->customShader != nullptr && !_vertices->customShader->path.empty())
+				if (hasCustomShader)
 				{
 					ShaderProgram* customShader = getShaderProgram(_vertices->customShader->path.c_str());
 					if (customShader != nullptr)
@@ -951,7 +1152,7 @@ namespace Renderer
 					shader->setOutputOffset(_vertices[0].pos);
 				}
 
-				if (_vertices->customShader != nullptr && !_vertices->customShader->path.empty())
+				if (hasCustomShader)
 					shader->setCustomUniformsParameters(_vertices->customShader->parameters);
 			}
 		}
@@ -959,18 +1160,7 @@ namespace Renderer
 			useProgram(&shaderProgramColorNoTexture);
 
 		// Do rendering
-		if (_srcBlendFactor != Blend::ONE && _dstBlendFactor != Blend::ONE)
-		{
-			GL_CHECK_ERROR(glEnable(GL_BLEND));
-			GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
-			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, _numVertices));
-			GL_CHECK_ERROR(glDisable(GL_BLEND));
-		}
-		else
-		{
-			GL_CHECK_ERROR(glDisable(GL_BLEND));
-			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, _numVertices));
-		}
+		drawArrays(GL_TRIANGLE_STRIP, first, _numVertices, _srcBlendFactor, _dstBlendFactor);
 
 	} // drawTriangleStrips
 
@@ -978,6 +1168,7 @@ namespace Renderer
 
 	void GLES20Renderer::setProjection(const Transform4x4f& _projection)
 	{
+		flushBatch();
 		projectionMatrix = _projection;
 		mvpMatrix = projectionMatrix * worldViewMatrix;
 	} // setProjection
@@ -995,6 +1186,8 @@ namespace Renderer
 
 	void GLES20Renderer::setViewport(const Rect& _viewport)
 	{
+		flushBatch();
+
 		// glViewport starts at the bottom left of the window
 		GL_CHECK_ERROR(glViewport( _viewport.x, getWindowHeight() - _viewport.y - _viewport.h, _viewport.w, _viewport.h));
 
@@ -1004,6 +1197,9 @@ namespace Renderer
 
 	void GLES20Renderer::setScissor(const Rect& _scissor)
 	{
+		flushBatch();
+		frameStats.stateChanges++;
+
 		if((_scissor.x == 0) && (_scissor.y == 0) && (_scissor.w == 0) && (_scissor.h == 0))
 		{
 			GL_CHECK_ERROR(glDisable(GL_SCISSOR_TEST));
@@ -1042,8 +1238,13 @@ namespace Renderer
 
 	void GLES20Renderer::swapBuffers()
 	{
+		flushBatch();
 		useProgram(nullptr);
 
+		lastFrameStats = frameStats;
+		frameStats = FrameStats();
+		batchingEnabled = Settings::getInstance()->getBool("BatchRendering");
+
 #ifdef WIN32		
 		glFlush();
 		Sleep(0);
@@ -1056,43 +1257,36 @@ namespace Renderer
 	
 	void GLES20Renderer::drawTriangleFan(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{		
+		auto it = boundTexture == 0 ? _textures.cend() : _textures.find(boundTexture);
+		bool alphaTexture = it != _textures.cend() && it->second != nullptr && it->second->type == GL_ALPHA;
+
+		ShaderProgram* program = boundTexture == 0 ? &shaderProgramColorNoTexture : (alphaTexture ? &shaderProgramAlpha : &shaderProgramColorTexture);
+		if (queueTriangles(program, GL_TRIANGLE_FAN, _vertices, _numVertices, _srcBlendFactor, _dstBlendFactor, _vertices->saturation))
+			return;
+
+		flushBatch();
+
 		// Pass buffer data
-		GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_DYNAMIC_DRAW));
+		GLint first = uploadVertices(_vertices, _numVertices);
 
 		// Setup shader
-		if (boundTexture != 0)
+		useProgram(program);
+
+		if (program == &shaderProgramColorTexture)
 		{
-			auto it = _textures.find(boundTexture);
-			if (it != _textures.cend() && it->second != nullptr && it->second->type == GL_ALPHA)
-				useProgram(&shaderProgramAlpha);
-			else
-			{
-				useProgram(&shaderProgramColorTexture);
-				shaderProgramColorTexture.setSaturation(_vertices->saturation);
-				shaderProgramColorTexture.setCornerRadius(0.0f);
-			}
+			shaderProgramColorTexture.setSaturation(_vertices->saturation);
+			shaderProgramColorTexture.setCornerRadius(0.0f);
 		}
-		else
-			useProgram(&shaderProgramColorNoTexture);
 
 		// Do rendering
-		if (_srcBlendFactor != Blend::ONE && _dstBlendFactor != Blend::ONE)
-		{
-			GL_CHECK_ERROR(glEnable(GL_BLEND));
-			GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
-			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_FAN, 0, _numVertices));
-			GL_CHECK_ERROR(glDisable(GL_BLEND));
-		}
-		else
-		{
-			GL_CHECK_ERROR(glDisable(GL_BLEND));
-			GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_FAN, 0, _numVertices));			
-		}
+		drawArrays(GL_TRIANGLE_FAN, first, _numVertices, _srcBlendFactor, _dstBlendFactor);
 	}
 
 	void GLES20Renderer::setStencil(const Vertex* _vertices, const unsigned int _numVertices)
 	{
+		flushBatch();
 		useProgram(&shaderProgramColorNoTexture);
+		frameStats.stateChanges++;
 
 		glEnable(GL_STENCIL_TEST);
 
@@ -1107,8 +1301,9 @@ namespace Renderer
 
 		glEnable(GL_BLEND);
 		glBlendFunc(convertBlendFactor(Blend::SRC_ALPHA), convertBlendFactor(Blend::ONE_MINUS_SRC_ALPHA));
-		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_DYNAMIC_DRAW);
-		glDrawArrays(GL_TRIANGLE_FAN, 0, _numVertices);
+		GLint first = uploadVertices(_vertices, _numVertices);
+		glDrawArrays(GL_TRIANGLE_FAN, first, _numVertices);
+		frameStats.drawCalls++;
 		glDisable(GL_BLEND);
 
 		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -1120,6 +1315,8 @@ namespace Renderer
 
 	void GLES20Renderer::disableStencil()
 	{
+		flushBatch();
+		frameStats.stateChanges++;
 		glDisable(GL_STENCIL_TEST);
 	}
 
@@ -1139,6 +1336,11 @@ namespace Renderer
 		return total;
 	}
 
+	FrameStats GLES20Renderer::getFrameStats()
+	{
+		return lastFrameStats;
+	}
+
 	bool GLES20Renderer::shaderSupportsCornerSize(const std::string& shader)
 	{
 		ShaderProgram* customShader = getShaderProgram(shader.c_str());
@@ -1150,6 +1352,9 @@ namespace Renderer
 
 	void GLES20Renderer::postProcessShader(const std::string& path, const float _x, const float _y, const float _w, const float _h, const std::map<std::string, std::string>& parameters, unsigned int* data)
 	{
+		// The queued draws must be in the framebuffer before it is read
+		flushBatch();
+
 #if OPENGL_EXTENSIONS
 		if (glBlitFramebuffer == nullptr || glFramebufferTexture2D == nullptr)
 			return;
@@ -1283,7 +1488,7 @@ namespace Renderer
 			for (int i = 0; i < 4; ++i)
 				vertices[i].pos.round();
 
-			GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * 4, &vertices, GL_DYNAMIC_DRAW));
+			GLint first = uploadVertices(vertices, 4);
 
 			for (int i = 0; i < shaderBatch->size(); i++)
 			{
@@ -1331,7 +1536,7 @@ namespace Renderer
 
 						for (int i = 0; i < 4; ++i) vertices[i].pos.round();
 
-						GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * 4, &vertices, GL_DYNAMIC_DRAW));
+						first = uploadVertices(vertices, 4);
 
 						GL_CHECK_ERROR(glBindFramebuffer(GL_FRAMEBUFFER, 0));
 					}
@@ -1360,7 +1565,8 @@ namespace Renderer
 				customShader->setCustomUniformsParameters(params);
 
 				GL_CHECK_ERROR(glDisable(GL_BLEND));
-				GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+				GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, first, 4));
+				frameStats.drawCalls++;
 			}
 
 			if (data != nullptr)
@@ -0,0 +1,224 @@
+#include "Renderer_Null.h"
+
+#include "math/Transform4x4f.h"
+
+#include <SDL.h>
+
+namespace Renderer
+{
+	NullRenderer::NullRenderer() : mNextTexture(1), mBoundTexture(0)
+	{
+
+	}
+
+	std::string NullRenderer::getDriverName()
+	{
+		return "NULL";
+	}
+
+	std::vector<std::pair<std::string, std::string>> NullRenderer::getDriverInformation()
+	{
+		std::vector<std::pair<std::string, std::string>> info;
+		info.push_back(std::pair<std::string, std::string>("GRAPHICS API", getDriverName()));
+		return info;
+	}
+
+	unsigned int NullRenderer::getWindowFlags()
+	{
+		return SDL_WINDOW_HIDDEN;
+
+	} // getWindowFlags
+
+	void NullRenderer::setupWindow()
+	{
+
+	} // setupWindow
+
+	void NullRenderer::createContext()
+	{
+
+	} // createContext
+
+	void NullRenderer::destroyContext()
+	{
+		resetCache();
+
+	} // destroyContext
+
+	void NullRenderer::resetCache()
+	{
+		mBoundTexture = 0;
+	}
+
+	unsigned int NullRenderer::createTexture(const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		std::unique_lock<std::mutex> lock(mTexturesLock);
+
+		unsigned int texture = mNextTexture++;
+		mTextures[texture] = { _type, _width, _height };
+
+		if (_data != nullptr)
+			mFrameStats.textureUploads++;
+
+		return texture;
+
+	} // createTexture
+
+	void NullRenderer::destroyTexture(const unsigned int _texture)
+	{
+		std::unique_lock<std::mutex> lock(mTexturesLock);
+		mTextures.erase(_texture);
+
+	} // destroyTexture
+
+	void NullRenderer::updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		std::unique_lock<std::mutex> lock(mTexturesLock);
+
+		// Like the GL renderers, a full update redefines the size
+		auto it = mTextures.find(_texture);
+		if (it != mTextures.cend() && _x == 0 && _y == 0)
+		{
+			it->second.type = _type;
+			it->second.width = _width;
+			it->second.height = _height;
+		}
+
+		mFrameStats.textureUploads++;
+
+	} // updateTexture
+
+	void NullRenderer::bindTexture(const unsigned int _texture)
+	{
+		if (mBoundTexture == _texture)
+			return;
+
+		mBoundTexture = _texture;
+		mFrameStats.stateChanges++;
+
+	} // bindTexture
+
+	void NullRenderer::addDraw(const unsigned int _numVertices)
+	{
+		mFrameStats.drawCalls++;
+		mFrameStats.vertices += _numVertices;
+	}
+
+	void NullRenderer::drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		addDraw(_numVertices);
+
+	} // drawLines
+
+	void NullRenderer::drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor, bool verticesChanged)
+	{
+		addDraw(_numVertices);
+
+	} // drawTriangleStrips
+
+	void NullRenderer::drawTriangleFan(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		addDraw(_numVertices);
+
+	} // drawTriangleFan
+
+	void NullRenderer::drawSolidRectangle(const float _x, const float _y, const float _w, const float _h, const unsigned int _fillColor, const unsigned int _borderColor, float borderWidth, float cornerRadius)
+	{
+		// Same submissions as the GL renderers : square rectangles are drawn with drawRect
+		if (cornerRadius == 0.0f)
+		{
+			if (_fillColor != 0)
+				drawRect(_x + borderWidth, _y + borderWidth, _w - borderWidth - borderWidth, _h - borderWidth - borderWidth, _fillColor);
+
+			if (_borderColor != 0 && borderWidth > 0)
+			{
+				drawRect(_x, _y, _w, borderWidth, _borderColor);
+				drawRect(_x + _w - borderWidth, _y + borderWidth, borderWidth, _h - borderWidth, _borderColor);
+				drawRect(_x, _y + _h - borderWidth, _w - borderWidth, borderWidth, _borderColor);
+				drawRect(_x, _y + borderWidth, borderWidth, _h - borderWidth - borderWidth, _borderColor);
+			}
+			return;
+		}
+
+		auto inner = createRoundRect(_x + borderWidth, _y + borderWidth, _w - borderWidth - borderWidth, _h - borderWidth - borderWidth, cornerRadius, _fillColor);
+
+		bindTexture(0);
+
+		if (_fillColor & 0xFF)
+			addDraw(inner.size());
+
+		if ((_borderColor & 0xFF) && borderWidth > 0)
+		{
+			setStencil(inner.data(), inner.size());
+			addDraw(inner.size());
+			disableStencil();
+		}
+
+	} // drawSolidRectangle
+
+	void NullRenderer::setProjection(const Transform4x4f& _projection)
+	{
+
+	} // setProjection
+
+	void NullRenderer::setMatrix(const Transform4x4f& _matrix)
+	{
+
+	} // setMatrix
+
+	void NullRenderer::setViewport(const Rect& _viewport)
+	{
+		mFrameStats.stateChanges++;
+
+	} // setViewport
+
+	void NullRenderer::setScissor(const Rect& _scissor)
+	{
+		mFrameStats.stateChanges++;
+
+	} // setScissor
+
+	void NullRenderer::setStencil(const Vertex* _vertices, const unsigned int _numVertices)
+	{
+		mFrameStats.stateChanges++;
+		addDraw(_numVertices);
+
+	} // setStencil
+
+	void NullRenderer::disableStencil()
+	{
+		mFrameStats.stateChanges++;
+
+	} // disableStencil
+
+	void NullRenderer::setSwapInterval()
+	{
+
+	} // setSwapInterval
+
+	void NullRenderer::swapBuffers()
+	{
+		mLastFrameStats.drawCalls = mFrameStats.drawCalls.exchange(0);
+		mLastFrameStats.vertices = mFrameStats.vertices.exchange(0);
+		mLastFrameStats.textureUploads = mFrameStats.textureUploads.exchange(0);
+		mLastFrameStats.stateChanges = mFrameStats.stateChanges.exchange(0);
+
+	} // swapBuffers
+
+	size_t NullRenderer::getTotalMemUsage()
+	{
+		std::unique_lock<std::mutex> lock(mTexturesLock);
+
+		size_t total = 0;
+		for (auto tex : mTextures)
+			total += (size_t)tex.second.width * tex.second.height * (tex.second.type == Texture::ALPHA ? 1 : 4);
+
+		return total;
+	}
+
+	FrameStats NullRenderer::getFrameStats()
+	{
+		return mLastFrameStats;
+	}
+
+} // Renderer::
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef ES_CORE_RENDERER_NULL_H
+#define ES_CORE_RENDERER_NULL_H
+
+#include "Renderer.h"
+
+#include <map>
+#include <mutex>
+#include <atomic>
+
+namespace Renderer
+{
+	//
+	// Headless renderer : nothing reaches a GPU, draw calls, vertices, texture uploads and state changes are only counted.
+	// Selected with the "NULL" renderer name ( benchmark, CI boxes without display ).
+	//
+	class NullRenderer : public IRenderer
+	{
+	public:
+		NullRenderer();
+
+		std::string getDriverName() override;
+		std::vector<std::pair<std::string, std::string>> getDriverInformation() override;
+
+		unsigned int getWindowFlags() override;
+		void         setupWindow() override;
+
+		void         createContext() override;
+		void         destroyContext() override;
+
+		void		 resetCache() override;
+
+		unsigned int createTexture(const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data) override;
+		void         destroyTexture(const unsigned int _texture) override;
+		void         updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data) override;
+		void         bindTexture(const unsigned int _texture) override;
+
+		void         drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA) override;
+		void         drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA, bool verticesChanged = true) override;
+		void		 drawTriangleFan(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA) override;
+		void		 drawSolidRectangle(const float _x, const float _y, const float _w, const float _h, const unsigned int _fillColor, const unsigned int _borderColor, float borderWidth = 1, float cornerRadius = 0) override;
+
+		void         setProjection(const Transform4x4f& _projection) override;
+		void         setMatrix(const Transform4x4f& _matrix) override;
+		void         setViewport(const Rect& _viewport) override;
+		void         setScissor(const Rect& _scissor) override;
+
+		void         setStencil(const Vertex* _vertices, const unsigned int _numVertices) override;
+		void		 disableStencil() override;
+
+		void         setSwapInterval() override;
+		void         swapBuffers() override;
+
+		size_t		 getTotalMemUsage() override;
+		FrameStats	 getFrameStats() override;
+
+	private:
+		void		 addDraw(const unsigned int _numVertices);
+
+		struct TextureInfo
+		{
+			Texture::Type	type;
+			unsigned int	width;
+			unsigned int	height;
+		};
+
+		// Textures can be created by loader threads
+		std::mutex							mTexturesLock;
+		std::map<unsigned int, TextureInfo>	mTextures;
+		unsigned int						mNextTexture;
+		unsigned int						mBoundTexture;
+
+		// Texture uploads are counted from loader threads
+		struct AtomicFrameStats
+		{
+			AtomicFrameStats() : drawCalls(0), vertices(0), textureUploads(0), stateChanges(0) { }
+
+			std::atomic<unsigned int> drawCalls;
+			std::atomic<unsigned int> vertices;
+			std::atomic<unsigned int> textureUploads;
+			std::atomic<unsigned int> stateChanges;
+		};
+
+		AtomicFrameStats	mFrameStats;
+		FrameStats			mLastFrameStats;
+	};
+}
+
+#endif // ES_CORE_RENDERER_NULL_H
@@ -12,6 +12,11 @@
 #include "Settings.h"
 #include "ImageIO.h"
 #include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <list>
 #include "math/Transform4x4f.h"
 
 #ifdef WIN32
@@ -25,9 +30,9 @@ int Font::getSize() const { return mSize; }
 std::map< std::pair<std::string, int>, std::weak_ptr<Font> > Font::sFontMap;
 static std::map<unsigned int, std::string> substituableChars;
 
-Font::FontFace::FontFace(ResourceData&& d, int size) : data(d)
+Font::FontFace::FontFace(ResourceData&& d, int size, FT_Library library) : data(d)
 {
-	int err = FT_New_Memory_Face(sLibrary, data.ptr.get(), (FT_Long)data.length, 0, &face);
+	int err = FT_New_Memory_Face(library, data.ptr.get(), (FT_Long)data.length, 0, &face);
 	if (!err)
 		FT_Set_Pixel_Sizes(face, 0, size);
 	else
@@ -112,6 +117,8 @@ Font::Font(int size, const std::string& path, bool menuScaling) : mSize(size), m
 		getGlyph(i);
 
 	clearFaceCache();
+
+	prewarmLanguageGlyphs();
 }
 
 Font::~Font()
@@ -122,6 +129,9 @@ Font::~Font()
 		delete tex;
 
 	mTextures.clear();
+
+	mGlyphMap.forEach([](unsigned int id, Glyph* glyph) { delete glyph; });
+	mGlyphMap.clear();
 }
 
 void Font::reload()
@@ -362,9 +372,9 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	else
 	{
 		// is it already loaded?
-		auto it = mGlyphMap.find(id);
-		if (it != mGlyphMap.cend())
-			return it->second;
+		Glyph* glyph = mGlyphMap.find(id);
+		if (glyph != NULL)
+			return glyph;
 	}
 
 	// nope, need to make a glyph
@@ -383,8 +393,13 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 		return NULL;
 	}
 
-	Vector2i glyphSize(g->bitmap.width, g->bitmap.rows);
+	return addGlyph(id, Vector2i(g->bitmap.width, g->bitmap.rows), g->bitmap.buffer,
+		Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f),
+		Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f));
+}
 
+Font::Glyph* Font::addGlyph(unsigned int id, const Vector2i& glyphSize, const unsigned char* bitmap, const Vector2f& advance, const Vector2f& bearing)
+{
 	FontTexture* tex = NULL;
 	Vector2i cursor;
 	getTextureForNewGlyph(glyphSize, tex, cursor);
@@ -402,20 +417,20 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	pGlyph->texture = tex;
 	pGlyph->texPos = Vector2f((float)cursor.x() / (float)tex->textureSize.x(), (float)cursor.y() / (float)tex->textureSize.y());
 	pGlyph->texSize = Vector2f((float)glyphSize.x() / (float)tex->textureSize.x(), (float)glyphSize.y() / (float)tex->textureSize.y());
-	pGlyph->advance = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
-	pGlyph->bearing = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);	
+	pGlyph->advance = advance;
+	pGlyph->bearing = bearing;
 	pGlyph->cursor = cursor;
 	pGlyph->glyphSize = glyphSize;
 
 	// upload glyph bitmap to texture
 	if (glyphSize.x() > 0 && glyphSize.y() > 0)
-		Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), g->bitmap.buffer);
+		Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), (void*)bitmap);
 
 	// update max glyph height - Limit to ascii table. If we don't it can take in the fallback fonts
 	if (glyphSize.y() > mMaxGlyphHeight && id >= 32 && id < 128)
 		mMaxGlyphHeight = glyphSize.y();
 
-	mGlyphMap[id] = pGlyph;
+	mGlyphMap.insert(id, pGlyph);
 
 	if (id < 255)
 		mGlyphCacheArray[id] = pGlyph;
@@ -424,6 +439,303 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	return pGlyph;
 }
 
+//
+// Rasterises glyphs on a background thread with its own FreeType library : FT_Library & FT_Face can't be shared with the render thread.
+// The bitmaps are handed back to the render thread, which only has to pack & upload them.
+//
+class FontGlyphPrewarmer
+{
+public:
+	struct PreparedGlyph
+	{
+		unsigned int				id;
+		Vector2i					size;
+		Vector2f					advance;
+		Vector2f					bearing;
+		std::vector<unsigned char>	bitmap;
+	};
+
+	struct Job
+	{
+		std::string					path;
+		int							size;
+		std::vector<unsigned int>	ids;
+		std::vector<PreparedGlyph>	glyphs;
+	};
+
+	static FontGlyphPrewarmer& getInstance()
+	{
+		static FontGlyphPrewarmer instance;
+		return instance;
+	}
+
+	~FontGlyphPrewarmer()
+	{
+		{
+			std::unique_lock<std::mutex> lock(mLock);
+			mExit = true;
+			mJobs.clear();
+		}
+
+		mEvent.notify_one();
+
+		if (mThread.joinable())
+			mThread.join();
+	}
+
+	void add(const std::string& path, int size, std::vector<unsigned int>& ids)
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+
+		Job job;
+		job.path = path;
+		job.size = size;
+		job.ids.swap(ids);
+		mJobs.push_back(std::move(job));
+
+		if (!mThread.joinable())
+			mThread = std::thread(&FontGlyphPrewarmer::run, this);
+
+		mEvent.notify_one();
+	}
+
+	bool takeResults(std::list<Job>& results)
+	{
+		if (!mHasResults)
+			return false;
+
+		std::unique_lock<std::mutex> lock(mLock);
+		results.splice(results.end(), mResults);
+		mHasResults = false;
+		return true;
+	}
+
+private:
+	FontGlyphPrewarmer() : mExit(false), mHasResults(false) { }
+
+	typedef std::map<unsigned int, std::unique_ptr<Font::FontFace>> FaceList;
+	typedef std::map<std::string, ResourceData> FileList;
+
+	void run()
+	{
+		FT_Library library;
+		if (FT_Init_FreeType(&library))
+		{
+			LOG(LogError) << "FontGlyphPrewarmer : error initializing FreeType!";
+			return;
+		}
+
+		// Font files are shared by all the sizes
+		FileList files;
+		std::map<std::pair<std::string, int>, FaceList> faces;
+
+		while (true)
+		{
+			Job job;
+
+			{
+				std::unique_lock<std::mutex> lock(mLock);
+				mEvent.wait(lock, [this] { return mExit || !mJobs.empty(); });
+
+				if (mExit)
+					break;
+
+				job = std::move(mJobs.front());
+				mJobs.pop_front();
+			}
+
+			rasterise(library, files, faces[std::pair<std::string, int>(job.path, job.size)], job);
+
+			std::unique_lock<std::mutex> lock(mLock);
+			mResults.push_back(std::move(job));
+			mHasResults = true;
+		}
+
+		faces.clear();
+		files.clear();
+		FT_Done_FreeType(library);
+	}
+
+	// Same face selection as Font::getFaceForChar
+	static FT_Face getFaceForChar(FT_Library library, FileList& files, FaceList& faceCache, const std::string& path, int size, unsigned int id)
+	{
+		static const std::vector<std::string> fallbackFonts = getFallbackFontPaths();
+
+		for (unsigned int i = 0; i < fallbackFonts.size() + 1; i++)
+		{
+			auto fit = faceCache.find(i);
+			if (fit == faceCache.cend())
+			{
+				const std::string& facePath = (i == 0 ? path : fallbackFonts.at(i - 1));
+
+				auto file = files.find(facePath);
+				if (file == files.cend())
+					file = files.insert(std::make_pair(facePath, ResourceManager::getInstance()->getFileData(facePath))).first;
+
+				ResourceData data = file->second;
+				fit = faceCache.insert(std::make_pair(i, std::unique_ptr<Font::FontFace>(new Font::FontFace(std::move(data), size, library)))).first;
+			}
+
+			if (fit->second->face == nullptr || (i == 2 && Utils::String::isKorean(id)))
+				continue;
+
+			if (FT_Get_Char_Index(fit->second->face, id) != 0)
+				return fit->second->face;
+		}
+
+		return faceCache.cbegin()->second->face;
+	}
+
+	static void rasterise(FT_Library library, FileList& files, FaceList& faceCache, Job& job)
+	{
+		job.glyphs.reserve(job.ids.size());
+
+		for (auto id : job.ids)
+		{
+			FT_Face face = getFaceForChar(library, files, faceCache, job.path, job.size, id);
+			if (face == nullptr || FT_Load_Char(face, id, FT_LOAD_RENDER))
+				continue;
+
+			FT_GlyphSlot g = face->glyph;
+
+			PreparedGlyph glyph;
+			glyph.id = id;
+			glyph.size = Vector2i(g->bitmap.width, g->bitmap.rows);
+			glyph.advance = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
+			glyph.bearing = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);
+
+			// Tightly packed rows, like the bitmaps uploaded by Font::getGlyph
+			glyph.bitmap.resize((size_t)glyph.size.x() * glyph.size.y());
+			for (int y = 0; y < glyph.size.y(); y++)
+				memcpy(glyph.bitmap.data() + (size_t)y * glyph.size.x(), g->bitmap.buffer + y * g->bitmap.pitch, glyph.size.x());
+
+			job.glyphs.push_back(std::move(glyph));
+		}
+	}
+
+	std::thread					mThread;
+	std::mutex					mLock;
+	std::condition_variable		mEvent;
+	bool						mExit;
+
+	std::list<Job>				mJobs;
+	std::list<Job>				mResults;
+	std::atomic<bool>			mHasResults;
+};
+
+void Font::prewarmGlyphs(const std::string& text)
+{
+	std::vector<unsigned int> ids;
+
+	size_t cursor = 0;
+	while (cursor < text.length())
+	{
+		unsigned int id = Utils::String::chars2Unicode(text, cursor);
+
+		// ASCII is always loaded
+		if (id >= 128)
+			ids.push_back(id);
+	}
+
+	if (!ids.empty())
+		prewarmGlyphs(ids);
+}
+
+void Font::prewarmGlyphs(const std::vector<unsigned int>& ids)
+{
+	std::vector<unsigned int> missing;
+
+	for (auto id : ids)
+	{
+		if (id < 32 || (id < 255 && mGlyphCacheArray[id] != NULL) || (id >= 255 && mGlyphMap.find(id) != NULL))
+			continue;
+
+		if (mPrewarmRequested.insert(id).second)
+			missing.push_back(id);
+	}
+
+	if (!missing.empty())
+		FontGlyphPrewarmer::getInstance().add(mPath, mSize, missing);
+}
+
+void Font::prewarmLanguageGlyphs()
+{
+	std::string language = Settings::getInstance()->getString("Language");
+	if (language.size() > 2)
+		language = language.substr(0, 2);
+
+	if (language.empty() || language == "en")
+		return;
+
+	// Letters of the language that are outside ASCII. Ideographic scripts are too large, game names cover them ( see prewarmGlyphs )
+	std::vector<std::pair<unsigned int, unsigned int>> ranges;
+
+	if (language == "ru" || language == "uk" || language == "bg" || language == "sr" || language == "be" || language == "mk")
+		ranges.push_back(std::make_pair(0x400, 0x45F)); // Cyrillic
+	else if (language == "el")
+		ranges.push_back(std::make_pair(0x370, 0x3FF)); // Greek
+	else if (language == "ar" || language == "fa")
+		ranges.push_back(std::make_pair(0x600, 0x6FF)); // Arabic
+	else if (language == "he")
+		ranges.push_back(std::make_pair(0x590, 0x5FF)); // Hebrew
+	else if (language == "ja")
+		ranges.push_back(std::make_pair(0x3040, 0x30FF)); // Hiragana & Katakana
+	else if (language == "ko")
+		ranges.push_back(std::make_pair(0x3130, 0x318F)); // Hangul compatibility Jamo
+	else if (language != "zh")
+		ranges.push_back(std::make_pair(0x100, 0x17F)); // Latin Extended-A
+
+	ranges.push_back(std::make_pair(0xA0, 0xFF)); // Latin-1 Supplement
+
+	std::vector<unsigned int> ids;
+	for (auto range : ranges)
+		for (unsigned int id = range.first; id <= range.second; id++)
+			ids.push_back(id);
+
+	prewarmGlyphs(ids);
+}
+
+// Adds the glyphs rasterised by FontGlyphPrewarmer to the font atlases. Called every frame, uploads are spread over several frames.
+void Font::uploadPrewarmedGlyphs()
+{
+	static std::list<FontGlyphPrewarmer::Job> pending;
+	FontGlyphPrewarmer::getInstance().takeResults(pending);
+
+	int budget = 256;
+
+	while (!pending.empty() && budget > 0)
+	{
+		auto& job = pending.front();
+
+		std::vector<Font*> fonts;
+		for (auto it : sFontMap)
+		{
+			auto font = it.second.lock();
+			if (font != nullptr && font->mLoaded && font->mSize == job.size && font->mPath == job.path)
+				fonts.push_back(font.get());
+		}
+
+		while (!job.glyphs.empty() && budget > 0)
+		{
+			auto& glyph = job.glyphs.back();
+
+			for (auto font : fonts)
+			{
+				if ((glyph.id < 255 && font->mGlyphCacheArray[glyph.id] != NULL) || (glyph.id >= 255 && font->mGlyphMap.find(glyph.id) != NULL))
+					continue;
+
+				font->addGlyph(glyph.id, glyph.size, glyph.bitmap.data(), glyph.advance, glyph.bearing);
+				budget--;
+			}
+
+			job.glyphs.pop_back();
+		}
+
+		if (job.glyphs.empty())
+			pending.pop_front();
+	}
+}
+
 // completely recreate the texture data for all textures based on mGlyphs information
 void Font::rebuildTextures()
 {
@@ -432,22 +744,20 @@ void Font::rebuildTextures()
 		tex->initTexture();
 
 	// reupload the texture data
-	for(auto it = mGlyphMap.cbegin(); it != mGlyphMap.cend(); it++)
+	mGlyphMap.forEach([this](unsigned int id, Glyph* glyph)
 	{
-		FT_Face face = getFaceForChar(it->first);
+		FT_Face face = getFaceForChar(id);
 		FT_GlyphSlot glyphSlot = face->glyph;
 
 		// load the glyph bitmap through FT
-		FT_Load_Char(face, it->first, FT_LOAD_RENDER);
-
-		Glyph* glyph = it->second;
+		FT_Load_Char(face, id, FT_LOAD_RENDER);
 		
 		// upload to texture
 		Renderer::updateTexture(glyph->texture->textureId, Renderer::Texture::ALPHA,
 			glyph->cursor.x(), glyph->cursor.y(),
 			glyph->glyphSize.x(), glyph->glyphSize.y(),
 			glyphSlot->bitmap.buffer);
-	}
+	});
 }
 
 void Font::renderSingleGlow(TextCache* cache, const Transform4x4f& parentTrans, float x, float y, bool verticesChanged)
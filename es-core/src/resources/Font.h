@@ -7,12 +7,15 @@
 #include "renderers/Renderer.h"
 #include "resources/ResourceManager.h"
 #include "ThemeData.h"
+#include "resources/GlyphTable.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <vector>
+#include <unordered_set>
 
 class TextCache;
 class TextureResource;
+class FontGlyphPrewarmer;
 
 #define FONT_SIZE_MINI ((unsigned int)(0.030f * Math::min((int)Renderer::getScreenHeight(), (int)Renderer::getScreenWidth())))
 #define FONT_SIZE_SMALL ((unsigned int)(0.035f * Math::min((int)Renderer::getScreenHeight(), (int)Renderer::getScreenWidth())))
@@ -78,6 +81,10 @@ public:
 	size_t getMemUsage() const; // returns an approximation of VRAM used by this font's texture (in bytes)
 	static size_t getTotalMemUsage(); // returns an approximation of total VRAM used by font textures (in bytes)
 
+	// Rasterises the characters of the text on a background thread, they are added to the atlas by uploadPrewarmedGlyphs before they are displayed
+	void prewarmGlyphs(const std::string& text);
+	static void uploadPrewarmedGlyphs();
+
 private:
 	void renderSingleGlow(TextCache* cache, const Transform4x4f& parentTrans, float x, float y, bool verticesChanged = true);
 
@@ -109,7 +116,7 @@ private:
 		const ResourceData data;
 		FT_Face face;
 
-		FontFace(ResourceData&& d, int size);
+		FontFace(ResourceData&& d, int size, FT_Library library = sLibrary);
 		virtual ~FontFace();
 	};
 
@@ -138,9 +145,15 @@ private:
 	};
 
 	Glyph* mGlyphCacheArray[255]; // used to cache 255 first chars
-	std::map<unsigned int, Glyph*> mGlyphMap;
+	GlyphTable<Glyph> mGlyphMap;
 
 	Glyph* getGlyph(unsigned int id);
+	Glyph* addGlyph(unsigned int id, const Vector2i& glyphSize, const unsigned char* bitmap, const Vector2f& advance, const Vector2f& bearing);
+
+	void prewarmGlyphs(const std::vector<unsigned int>& ids);
+	void prewarmLanguageGlyphs();
+
+	std::unordered_set<unsigned int> mPrewarmRequested;
 
 	int mMaxGlyphHeight;
 	
@@ -151,6 +164,7 @@ private:
 	float getNewlineStartOffset(const std::string& text, const unsigned int& charStart, const float& xLen, const Alignment& alignment);
 
 	friend TextCache;
+	friend FontGlyphPrewarmer;
 };
 
 struct TextImageSubstitute
@@ -0,0 +1,96 @@
+#pragma once
+#ifndef ES_CORE_RESOURCES_GLYPH_TABLE_H
+#define ES_CORE_RESOURCES_GLYPH_TABLE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Flat open-addressing table from unicode code points to glyphs. Linear probing, kept under 50% load.
+template<typename T>
+class GlyphTable
+{
+public:
+	GlyphTable() : mCount(0) { mSlots.resize(64); }
+
+	inline T* find(unsigned int id) const
+	{
+		size_t mask = mSlots.size() - 1;
+		for (size_t idx = hash(id) & mask; ; idx = (idx + 1) & mask)
+		{
+			const Slot& slot = mSlots[idx];
+			if (slot.value == nullptr)
+				return nullptr;
+
+			if (slot.id == id)
+				return slot.value;
+		}
+	}
+
+	void insert(unsigned int id, T* value)
+	{
+		if ((mCount + 1) * 2 > mSlots.size())
+			grow();
+
+		if (place(mSlots, id, value))
+			mCount++;
+	}
+
+	template<typename F> void forEach(F func) const
+	{
+		for (const auto& slot : mSlots)
+			if (slot.value != nullptr)
+				func(slot.id, slot.value);
+	}
+
+	inline size_t size() const { return mCount; }
+
+	void clear()
+	{
+		mSlots.assign(64, Slot());
+		mCount = 0;
+	}
+
+private:
+	struct Slot
+	{
+		Slot() : id(0), value(nullptr) { }
+
+		unsigned int	id;
+		T*				value;
+	};
+
+	static inline size_t hash(unsigned int id) { return (size_t)(id * 2654435761u); }
+
+	// Returns true if a new slot was used
+	static bool place(std::vector<Slot>& slots, unsigned int id, T* value)
+	{
+		size_t mask = slots.size() - 1;
+		for (size_t idx = hash(id) & mask; ; idx = (idx + 1) & mask)
+		{
+			Slot& slot = slots[idx];
+			if (slot.value == nullptr || slot.id == id)
+			{
+				bool added = slot.value == nullptr;
+				slot.id = id;
+				slot.value = value;
+				return added;
+			}
+		}
+	}
+
+	void grow()
+	{
+		std::vector<Slot> slots(mSlots.size() * 2);
+		for (const auto& slot : mSlots)
+			if (slot.value != nullptr)
+				place(slots, slot.id, slot.value);
+
+		mSlots.swap(slots);
+	}
+
+	std::vector<Slot>	mSlots;
+	size_t				mCount;
+};
+
+#endif // ES_CORE_RESOURCES_GLYPH_TABLE_H
@@ -9,6 +9,7 @@
 #include <nanosvg/nanosvgrast.h>
 #include <string.h>
 #include <algorithm>
+#include <chrono>
 #include <vlc/vlc.h>
 
 #include "Settings.h"
@@ -30,6 +31,8 @@ TextureData::TextureData(bool tile, bool linear) :
 {
 	mIsExternalDataRGBA = false;
 	mRequired = false;
+	mLoadCost = 0;
+	mLoadPriority = TEXTURE_LOAD_PRIORITY_DEFAULT;
 }
 
 TextureData::~TextureData()
@@ -157,16 +160,23 @@ bool TextureData::initSVGFromMemory(const unsigned char* fileData, size_t length
 	return true;
 }
 
+MaxSizeInfo TextureData::getImageMaxSize()
+{
+	// Don't load images greater than screen resolution
+	MaxSizeInfo maxSize(Renderer::getScreenWidth(), Renderer::getScreenHeight(), false);
+	if (!mMaxSize.empty() && mMaxSize.x() < maxSize.x() && mMaxSize.y() < maxSize.y())
+		maxSize = mMaxSize;
+
+	return maxSize;
+}
+
 bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t length, int subImageIndex)
 {
 	// If already initialised then don't read again
 	if (isLoaded())
 		return true;
 
-	// Don't load images greater than screen resolution
-	MaxSizeInfo maxSize(Renderer::getScreenWidth(), Renderer::getScreenHeight(), false);
-	if (!mMaxSize.empty() && mMaxSize.x() < maxSize.x() && mMaxSize.y() < maxSize.y())
-		maxSize = mMaxSize;
+	MaxSizeInfo maxSize = getImageMaxSize();
 		
 	auto oldSize = mSize;
 
@@ -199,8 +209,14 @@ bool TextureData::initFromRGBA(unsigned char* dataRGBA, size_t width, size_t hei
 		mDataRGBA = nullptr;
 	}
 
+	// Loaded meanwhile by another thread : the buffer given to us is not needed
 	if (mDataRGBA)
+	{
+		if (!copyData)
+			delete[] dataRGBA;
+
 		return true;
+	}
 
 	if (copyData)
 	{
@@ -432,6 +448,16 @@ bool TextureData::loadFromCbz()
 }
 
 bool TextureData::load(bool updateCache)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	bool ret = loadData(updateCache);
+
+	mLoadCost = (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	return ret;
+}
+
+bool TextureData::loadData(bool updateCache)
 {
 	// Need to load. See if there is a file
 	if (mPath.empty())
@@ -461,6 +487,9 @@ bool TextureData::load(bool updateCache)
 		path = mPath.substr(0, idx);
 	}
 
+	if (ext != ".svg" && loadFromDecodedImageCache(path, subImageIndex, updateCache))
+		return true;
+
 	const ResourceData& data = ResourceManager::getInstance()->getFileData(path);
 
 	// is it an SVG?
@@ -475,9 +504,56 @@ bool TextureData::load(bool updateCache)
 	if (updateCache && retval)
 		ImageIO::updateImageCache(mPath, data.length, Math::round((int)mPhysicalSize.x()), Math::round((int)mPhysicalSize.y()));
 
+	// Only keep images that were actually downscaled : full size ones would cost more disk than the decode saves
+	if (retval && mSize.x() < (int)mPhysicalSize.x() && mSize.y() < (int)mPhysicalSize.y())
+	{
+		// Written from a copy : the texture stays usable while the file is written
+		std::vector<unsigned char> pixels;
+		Vector2i size;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			if (mDataRGBA != nullptr && !mIsExternalDataRGBA)
+			{
+				size = mSize;
+				pixels.assign(mDataRGBA, mDataRGBA + (size_t)size.x() * size.y() * 4);
+			}
+		}
+
+		if (pixels.size() > 0)
+			ImageIO::saveDecodedImageCache(path, subImageIndex, getImageMaxSize(), pixels.data(), size.x(), size.y(), Vector2i((int)mPhysicalSize.x(), (int)mPhysicalSize.y()));
+	}
+
 	return retval;
 }
 
+bool TextureData::loadFromDecodedImageCache(const std::string& path, int subImageIndex, bool updateCache)
+{
+	if (isLoaded())
+		return false;
+
+	size_t width, height;
+	Vector2i baseSize;
+
+	unsigned char* imageRGBA = ImageIO::loadDecodedImageCache(path, subImageIndex, getImageMaxSize(), width, height, baseSize);
+	if (imageRGBA == nullptr)
+		return false;
+
+	mPhysicalSize = Vector2f(baseSize.x(), baseSize.y());
+	mScalable = false;
+
+	if (!initFromRGBA(imageRGBA, width, height, false))
+	{
+		delete[] imageRGBA;
+		return false;
+	}
+
+	if (updateCache)
+		ImageIO::updateImageCache(mPath, (int)Utils::FileSystem::getFileSize(path), baseSize.x(), baseSize.y());
+
+	return true;
+}
+
 bool TextureData::isLoaded()
 {
 	std::unique_lock<std::mutex> lock(mMutex);
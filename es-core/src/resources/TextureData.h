@@ -9,6 +9,15 @@
 
 class TextureResource;
 
+// Textures waiting in the loading queue are loaded by increasing priority.
+// Lists give the distance of their items to the cursor, items that left the screen get TEXTURE_LOAD_PRIORITY_OFFSCREEN.
+enum TextureLoadPriority : int
+{
+	TEXTURE_LOAD_PRIORITY_UNSET = -1, // Components that were never given a priority leave the one of the texture
+	TEXTURE_LOAD_PRIORITY_DEFAULT = 0,
+	TEXTURE_LOAD_PRIORITY_OFFSCREEN = 1 << 16
+};
+
 class IPdfHandler
 {
 public:
@@ -92,7 +101,18 @@ public:
 	inline bool isScalable() { return mScalable; }
 	void setScalable(bool value) { mScalable = value; };
 
+	// Time spent by the last load() in ms : used to estimate what releasing the texture costs
+	inline int getLoadCost() { return mLoadCost; }
+
+	inline int getLoadPriority() { return mLoadPriority; }
+	void setLoadPriority(int priority) { mLoadPriority = priority; }
+
 private:
+	bool loadData(bool updateCache);
+	bool loadFromDecodedImageCache(const std::string& path, int subImageIndex, bool updateCache);
+
+	MaxSizeInfo getImageMaxSize();
+
 	bool			mRequired;
 
 	std::mutex		mMutex;
@@ -119,6 +139,8 @@ private:
 */
 
 	bool			mIsExternalDataRGBA;
+	int				mLoadCost;
+	int				mLoadPriority;
 };
 
 #endif // ES_CORE_RESOURCES_TEXTURE_DATA_H
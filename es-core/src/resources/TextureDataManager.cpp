@@ -9,6 +9,8 @@
 
 TextureDataManager::TextureDataManager()
 {
+	mStatistics = { 0, 0, 0, 0 };
+	mEvictionPolicy = std::unique_ptr<ITextureEvictionPolicy>(ITextureEvictionPolicy::create("cost"));
 	mLoader = new TextureLoader(this);
 }
 
@@ -25,6 +27,7 @@ std::shared_ptr<TextureData> TextureDataManager::add(const TextureResource* key,
 	auto it = mTextureLookup.find(key);
 	if (it != mTextureLookup.cend())
 	{
+		mEvictionPolicy->onRemove((*(*it).second).get());
 		// Remove the list entry
 		mTextures.erase((*it).second);
 		// And the lookup
@@ -46,11 +49,50 @@ void TextureDataManager::remove(const TextureResource* key)
 	auto it = mTextureLookup.find(key);
 	if (it != mTextureLookup.cend())
 	{
+		std::shared_ptr<TextureData> tex = *(*it).second;
+
+		// Nobody will use it : don't load it
+		mLoader->remove(tex);
+		mEvictionPolicy->onRemove(tex.get());
 		// Remove the list entry
 		mTextures.erase((*it).second);
 		// And the lookup
 		mTextureLookup.erase(it);
 	}
+
+	mLoadPriorities.erase(key);
+}
+
+void TextureDataManager::setLoadPriority(const TextureResource* key, const void* owner, int priority)
+{
+	std::unique_lock<std::recursive_mutex> lock(mMutex);
+
+	auto it = mTextureLookup.find(key);
+	if (it == mTextureLookup.cend())
+		return;
+
+	auto& owners = mLoadPriorities[key];
+	if (priority == TEXTURE_LOAD_PRIORITY_UNSET)
+		owners.erase(owner);
+	else
+		owners[owner] = priority;
+
+	int lowest = TEXTURE_LOAD_PRIORITY_DEFAULT;
+	if (owners.empty())
+		mLoadPriorities.erase(key);
+	else
+	{
+		lowest = owners.cbegin()->second;
+		for (auto entry : owners)
+			lowest = std::min(lowest, entry.second);
+	}
+
+	std::shared_ptr<TextureData> tex = *(*it).second;
+	if (tex->getLoadPriority() == lowest)
+		return;
+
+	tex->setLoadPriority(lowest);
+	mLoader->reprioritize(tex);
 }
 
 void TextureDataManager::cancelAsync(const TextureResource* key)
@@ -89,15 +131,28 @@ std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key,
 
 		// Make sure it's loaded or queued for loading
 		if (enableLoading == TextureLoadMode::ENABLED && !tex->isLoaded())
-		{
-			//lock.unlock();
 			load(tex);
-		}
 	}
 
 	return tex;
 }
 
+void TextureDataManager::reuse(const TextureResource* key)
+{
+	std::unique_lock<std::recursive_mutex> lock(mMutex);
+
+	auto it = mTextureLookup.find(key);
+	if (it == mTextureLookup.cend())
+		return;
+
+	std::shared_ptr<TextureData> tex = *(*it).second;
+	if (!tex->isLoaded())
+		return; // Counted by load when drawn
+
+	mStatistics.hits++;
+	mEvictionPolicy->onAccess(tex.get());
+}
+
 bool TextureDataManager::bind(const TextureResource* key)
 {
 	std::shared_ptr<TextureData> tex = get(key);
@@ -147,6 +202,37 @@ bool compareTextures(const std::shared_ptr<TextureData>& first, const std::share
 	return (second->isRequired() && !first->isRequired());
 }
 
+TextureDataManager::CacheStatistics TextureDataManager::getStatistics()
+{
+	std::unique_lock<std::recursive_mutex> lock(mMutex);
+	return mStatistics;
+}
+
+void TextureDataManager::updateEvictionPolicy()
+{
+	std::string name = Settings::getInstance()->getString("TextureEvictionPolicy");
+	if (mEvictionPolicy->getName() == name)
+		return;
+
+	mEvictionPolicy = std::unique_ptr<ITextureEvictionPolicy>(ITextureEvictionPolicy::create(name));
+
+	// Seed the new policy with the current usage order
+	for (auto it = mTextures.crbegin(); it != mTextures.crend(); ++it)
+		if ((*it)->isLoaded())
+			mEvictionPolicy->onAccess((*it).get());
+}
+
+void TextureDataManager::evict(const std::shared_ptr<TextureData>& tex)
+{
+	LOG(LogDebug) << "Cleanup VRAM\tReleased : " << tex->getPath().c_str();
+
+	tex->releaseVRAM();
+	tex->releaseRAM();
+
+	mEvictionPolicy->onEvict(tex.get());
+	mStatistics.evictions++;
+}
+
 void TextureDataManager::cleanupVRAM(std::shared_ptr<TextureData> exclude)
 {
 	std::unique_lock<std::recursive_mutex> lock(mMutex);
@@ -159,27 +245,37 @@ void TextureDataManager::cleanupVRAM(std::shared_ptr<TextureData> exclude)
 	if (exclude)
 		size += exclude->getEstimatedVRAMUsage();
 
+	if (size + queuesize < max_texture)
+		return;
+
+	updateEvictionPolicy();
+
+	// Textures that can be released, least recently used first, then ordered by the policy
+	std::vector<std::shared_ptr<TextureData>> candidates;
+	for (auto it = mTextures.crbegin(); it != mTextures.crend(); ++it)
+	{
+		auto tex = *it;
+		if (tex == exclude || !tex->isReloadable() || tex->isRequired() || tex->getEstimatedVRAMUsage() == 0)
+			continue;
+
+		candidates.push_back(tex);
+	}
+
+	mEvictionPolicy->sortCandidates(candidates);
+
 	if (size >= max_texture)
 	{
 		// First Perform cleanup on textures without considering the queue
-		for (auto it = mTextures.crbegin(); it != mTextures.crend(); ++it)
+		for (auto tex : candidates)
 		{
 			if (size < max_texture)
 				break;
 
-			auto tex = *it;
-			if (tex == exclude || !tex->isReloadable() || tex->isRequired() || !tex->isLoaded())
+			if (!tex->isLoaded())
 				continue;
 
 			auto textureSize = tex->getEstimatedVRAMUsage();
-			if (textureSize == 0)
-				continue;
-
-			LOG(LogDebug) << "Cleanup VRAM\tReleased : " << tex->getPath().c_str();
-
-			tex->releaseVRAM();
-			tex->releaseRAM();
-
+			evict(tex);
 			size -= textureSize;
 		}
 	}
@@ -189,31 +285,22 @@ void TextureDataManager::cleanupVRAM(std::shared_ptr<TextureData> exclude)
 	if (size < max_texture)
 		return;
 
-	for (auto it = mTextures.crbegin(); it != mTextures.crend(); ++it)
+	for (auto tex : candidates)
 	{
 		if (size < max_texture)
 			break;
 
-		auto tex = *it;
-		if (tex == exclude || !tex->isReloadable() || tex->isRequired())
-			continue;
-
 		auto textureSize = tex->getEstimatedVRAMUsage();
-		if (textureSize == 0)
-			continue;
 
 		if (tex->isLoaded())
 		{
-			LOG(LogDebug) << "Cleanup VRAM\tReleased : " << tex->getPath().c_str();
-
-			tex->releaseVRAM();
-			tex->releaseRAM();
-
+			evict(tex);
 			size -= textureSize;
 		}
 		else if (mLoader->remove(tex))
 		{
 			LOG(LogDebug) << "Cleanup VRAM\tRemoved from queue : " << tex->getPath().c_str();
+			mStatistics.queueDrops++;
 			size -= textureSize;
 		}
 	}
@@ -238,7 +325,12 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
 		block = true; // Reload instantly or other instances will fade again
 	}
 
-	mLoader->remove(tex);
+	// get() requests queued textures again on every frame : only the first request is a miss
+	if (!mLoader->remove(tex))
+	{
+		mStatistics.misses++;
+		mEvictionPolicy->onAccess(tex.get());
+	}
 
 	cleanupVRAM(tex);
 
@@ -248,7 +340,7 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
 		tex->load();
 }
 
-TextureLoader::TextureLoader(TextureDataManager* mgr) : mManager(mgr), mExit(false)
+TextureLoader::TextureLoader(TextureDataManager* mgr) : mManager(mgr), mExit(false), mQueueSequence(0)
 {
 	int num_threads = std::thread::hardware_concurrency() / 2;
 	if (num_threads == 0)
@@ -284,10 +376,8 @@ void TextureLoader::threadProc()
 
 		if (!mTextureDataQ.empty())
 		{
-			std::shared_ptr<TextureData> textureData = mTextureDataQ.front();
-
-			mTextureDataQ.pop_front();
-			mTextureDataQSet.erase(textureData);
+			std::shared_ptr<TextureData> textureData = mTextureDataQ.cbegin()->second;
+			dequeue(textureData);
 
 			if (textureData && !textureData->isLoaded())
 			{
@@ -327,17 +417,10 @@ void TextureLoader::load(std::shared_ptr<TextureData> textureData)
 	if (mProcessingTextureDataQ.find(textureData) != mProcessingTextureDataQ.cend())
 		return;
 
-	// Remove it from the queue if it is already there
-	if (mTextureDataQSet.erase(textureData) > 0)
-	{
-		auto tx = std::find(mTextureDataQ.cbegin(), mTextureDataQ.cend(), textureData);
-		if (tx != mTextureDataQ.cend())
-			mTextureDataQ.erase(tx);
-	}
-
-	// Put it on the start of the queue as we want the newly requested textures to load first
-	mTextureDataQ.push_front(textureData);
-	mTextureDataQSet.insert(textureData);
+	// Remove it from the queue if it is already there, then queue it again : 
+	// within a priority we want the newly requested textures to load first
+	dequeue(textureData);
+	enqueue(textureData);
 
 	mEvent.notify_one();
 }
@@ -346,17 +429,38 @@ bool TextureLoader::remove(std::shared_ptr<TextureData> textureData)
 {
 	// Just remove it from the queue so we don't attempt to load it
 	std::unique_lock<std::mutex> lock(mLoaderLock);
+	return dequeue(textureData);
+}
 
-	if (mTextureDataQSet.erase(textureData) > 0)
-	{
-		auto tx = std::find(mTextureDataQ.cbegin(), mTextureDataQ.cend(), textureData);
-		if (tx != mTextureDataQ.cend())
-			mTextureDataQ.erase(tx);
+void TextureLoader::reprioritize(std::shared_ptr<TextureData> textureData)
+{
+	std::unique_lock<std::mutex> lock(mLoaderLock);
 
-		return true;
-	}
+	auto it = mTextureDataQKeys.find(textureData.get());
+	if (it == mTextureDataQKeys.cend() || it->second.first == textureData->getLoadPriority())
+		return;
+
+	dequeue(textureData);
+	enqueue(textureData);
+}
+
+void TextureLoader::enqueue(const std::shared_ptr<TextureData>& textureData)
+{
+	QueueKey key(textureData->getLoadPriority(), -(++mQueueSequence));
 
-	return false;
+	mTextureDataQ[key] = textureData;
+	mTextureDataQKeys[textureData.get()] = key;
+}
+
+bool TextureLoader::dequeue(const std::shared_ptr<TextureData>& textureData)
+{
+	auto it = mTextureDataQKeys.find(textureData.get());
+	if (it == mTextureDataQKeys.cend())
+		return false;
+
+	mTextureDataQ.erase(it->second);
+	mTextureDataQKeys.erase(it);
+	return true;
 }
 
 size_t TextureLoader::getQueueSize()
@@ -368,7 +472,7 @@ size_t TextureLoader::getQueueSize()
 	size_t mem = 0;
 
 	for (auto tex : mTextureDataQ)
-		mem += tex->getEstimatedVRAMUsage();
+		mem += tex.second->getEstimatedVRAMUsage();
 
 	for (auto tex : mProcessingTextureDataQ)
 		mem += tex->getEstimatedVRAMUsage();
@@ -381,7 +485,7 @@ void TextureLoader::clearQueue()
 	std::unique_lock<std::mutex> lock(mLoaderLock);
 
 	// Just abort any waiting texture
-	mTextureDataQSet.clear();
+	mTextureDataQKeys.clear();
 	mTextureDataQ.clear();	
 }
 
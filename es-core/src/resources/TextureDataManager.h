@@ -11,6 +11,7 @@
 #include <vector>
 #include <set>
 #include <unordered_map>
+#include "resources/TextureEvictionPolicy.h"
 
 class TextureDataManager;
 class TextureData;
@@ -24,6 +25,8 @@ public:
 
 	void load(std::shared_ptr<TextureData> textureData);
 	bool remove(std::shared_ptr<TextureData> textureData);
+	// Moves a queued texture to the place matching its current load priority
+	void reprioritize(std::shared_ptr<TextureData> textureData);
 	void clearQueue();
 
 	size_t getQueueSize();
@@ -35,9 +38,16 @@ public:
 private:	
 	void threadProc();
 
+	// Queue order : lowest load priority first, then the most recent request first
+	typedef std::pair<int, int64_t> QueueKey;
+
+	void enqueue(const std::shared_ptr<TextureData>& textureData);
+	bool dequeue(const std::shared_ptr<TextureData>& textureData);
+
 	std::set<std::shared_ptr<TextureData>> 											mProcessingTextureDataQ;
-	std::list<std::shared_ptr<TextureData>> 										mTextureDataQ;
-	std::set<std::shared_ptr<TextureData>> 											mTextureDataQSet;
+	std::map<QueueKey, std::shared_ptr<TextureData>> 								mTextureDataQ;
+	std::unordered_map<TextureData*, QueueKey> 										mTextureDataQKeys;
+	int64_t																			mQueueSequence;
 
 	std::vector<std::thread>	mThreads;
 	std::mutex					mLoaderLock;
@@ -85,6 +95,12 @@ public:
 	void cancelAsync(const TextureResource* key);
 	std::shared_ptr<TextureData> get(const TextureResource* key, TextureLoadMode enableLoading = TextureLoadMode::ENABLED);
 	bool bind(const TextureResource* key);
+	// A new user of an existing texture was found ( see TextureResource::get ) : counted as a cache hit
+	void reuse(const TextureResource* key);
+
+	// Lower priorities are loaded first ( see TextureData::getLoadPriority )
+	// A texture shared by several owners gets the lowest of their priorities, TEXTURE_LOAD_PRIORITY_UNSET withdraws the one of the owner
+	void setLoadPriority(const TextureResource* key, const void* owner, int priority);
 
 	// Get the total size of all textures managed by this object, loaded and unloaded in bytes
 	size_t	getTotalSize();
@@ -100,7 +116,20 @@ public:
 	
 	void cleanupVRAM(std::shared_ptr<TextureData> exclude = nullptr);
 
+	struct CacheStatistics
+	{
+		size_t hits;		// reuse() found the texture loaded
+		size_t misses;		// load() had to load it
+		size_t evictions;	// released by cleanupVRAM
+		size_t queueDrops;	// removed from the loading queue by cleanupVRAM
+	};
+
+	CacheStatistics getStatistics();
+
 private:
+	// The policy follows the "TextureEvictionPolicy" setting
+	void updateEvictionPolicy();
+	void evict(const std::shared_ptr<TextureData>& tex);
 
 	std::shared_ptr<TextureData> getBlankTexture();
 
@@ -108,8 +137,12 @@ private:
 
 	std::list<std::shared_ptr<TextureData> >												mTextures;
 	std::unordered_map<const TextureResource*, std::list<std::shared_ptr<TextureData> >::const_iterator > 	mTextureLookup;
+	std::unordered_map<const TextureResource*, std::map<const void*, int> >									mLoadPriorities; // Priority asked by each owner of a texture
 	std::shared_ptr<TextureData>															mBlank;
 	TextureLoader*																			mLoader;
+
+	std::unique_ptr<ITextureEvictionPolicy>													mEvictionPolicy;
+	CacheStatistics																			mStatistics;
 };
 
 #endif // ES_CORE_RESOURCES_TEXTURE_DATA_MANAGER_H
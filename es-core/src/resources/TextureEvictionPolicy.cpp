@@ -0,0 +1,68 @@
+#include "resources/TextureEvictionPolicy.h"
+
+#include "resources/TextureData.h"
+#include <algorithm>
+
+ITextureEvictionPolicy* ITextureEvictionPolicy::create(const std::string& name)
+{
+	if (name == "lru")
+		return new LruTextureEvictionPolicy();
+
+	return new CostTextureEvictionPolicy();
+}
+
+double CostTextureEvictionPolicy::computePriority(TextureData* tex, unsigned int hits)
+{
+	// Cost in ms, at least 1 ms for textures that have not been timed yet
+	double cost = std::max(1.0, (double)tex->getLoadCost());
+	// Size in MB, at least 1 KB
+	double size = std::max((size_t)1024, tex->getEstimatedVRAMUsage()) / (1024.0 * 1024.0);
+
+	return mInflation + (double)hits * cost / size;
+}
+
+void CostTextureEvictionPolicy::onAccess(TextureData* tex)
+{
+	Entry& entry = mEntries[tex];
+	entry.hits++;
+	entry.priority = computePriority(tex, entry.hits);
+}
+
+void CostTextureEvictionPolicy::onEvict(TextureData* tex)
+{
+	auto it = mEntries.find(tex);
+	if (it == mEntries.cend())
+		return;
+
+	mInflation = std::max(mInflation, it->second.priority);
+	it->second.hits = 0;
+	it->second.priority = mInflation;
+}
+
+void CostTextureEvictionPolicy::onRemove(TextureData* tex)
+{
+	mEntries.erase(tex);
+}
+
+void CostTextureEvictionPolicy::sortCandidates(std::vector<std::shared_ptr<TextureData>>& candidates)
+{
+	std::vector<std::pair<double, size_t>> order;
+	order.reserve(candidates.size());
+
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		auto it = mEntries.find(candidates[i].get());
+		order.push_back(std::pair<double, size_t>(it == mEntries.cend() ? mInflation : it->second.priority, i));
+	}
+
+	// Stable on the LRU order for equal priorities
+	std::stable_sort(order.begin(), order.end(), [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) { return a.first < b.first; });
+
+	std::vector<std::shared_ptr<TextureData>> sorted;
+	sorted.reserve(candidates.size());
+
+	for (auto item : order)
+		sorted.push_back(candidates[item.second]);
+
+	candidates.swap(sorted);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef ES_CORE_RESOURCES_TEXTURE_EVICTION_POLICY_H
+#define ES_CORE_RESOURCES_TEXTURE_EVICTION_POLICY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+class TextureData;
+
+//
+// Decides which textures TextureDataManager::cleanupVRAM releases first.
+// All calls are made with the TextureDataManager lock held.
+//
+class ITextureEvictionPolicy
+{
+public:
+	virtual ~ITextureEvictionPolicy() { }
+
+	virtual std::string getName() = 0;
+
+	virtual void onAccess(TextureData* tex) { }
+	virtual void onEvict(TextureData* tex) { }
+	virtual void onRemove(TextureData* tex) { }
+
+	// Candidates are given least recently used first. The first ones after sorting are released first.
+	virtual void sortCandidates(std::vector<std::shared_ptr<TextureData>>& candidates) { }
+
+	// "lru" or "cost". Unknown names give the cost policy
+	static ITextureEvictionPolicy* create(const std::string& name);
+};
+
+// Releases the least recently used textures first
+class LruTextureEvictionPolicy : public ITextureEvictionPolicy
+{
+public:
+	std::string getName() override { return "lru"; }
+};
+
+//
+// Greedy-Dual-Size-Frequency : priority = L + hits * reloadCost / size.
+// Large textures that are cheap to reload ( small jpg ) go first, textures that are expensive to rebuild
+// ( svg rasterisation, pdf/cbz pages, video thumbnails ) and frequently used ones stay longer.
+// L is raised to the priority of every evicted texture so old entries age out.
+//
+class CostTextureEvictionPolicy : public ITextureEvictionPolicy
+{
+public:
+	CostTextureEvictionPolicy() : mInflation(0) { }
+
+	std::string getName() override { return "cost"; }
+
+	void onAccess(TextureData* tex) override;
+	void onEvict(TextureData* tex) override;
+	void onRemove(TextureData* tex) override;
+
+	void sortCandidates(std::vector<std::shared_ptr<TextureData>>& candidates) override;
+
+private:
+	struct Entry
+	{
+		Entry() : priority(0), hits(0) { }
+
+		double			priority;
+		unsigned int	hits;
+	};
+
+	double computePriority(TextureData* tex, unsigned int hits);
+
+	std::unordered_map<TextureData*, Entry>	mEntries;
+	double									mInflation;
+};
+
+#endif // ES_CORE_RESOURCES_TEXTURE_EVICTION_POLICY_H
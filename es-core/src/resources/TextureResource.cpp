@@ -135,6 +135,9 @@ std::shared_ptr<TextureResource> TextureResource::get(const std::string& path, b
 		{
 			std::shared_ptr<TextureResource> rc = foundTexture->second.lock();
 
+			if (rc->mTextureData == nullptr)
+				sTextureDataManager.reuse(rc.get());
+
 			if (maxSize != nullptr && !maxSize->empty() && Settings::getInstance()->getBool("OptimizeVRAM"))
 			{
 				std::shared_ptr<TextureData> dt;
@@ -264,6 +267,12 @@ void TextureResource::prioritize() const
 		sTextureDataManager.get(this, TextureDataManager::TextureLoadMode::MOVETOTOPONLY);
 }
 
+void TextureResource::setLoadPriority(int priority, const void* owner) const
+{
+	if (mTextureData == nullptr)
+		sTextureDataManager.setLoadPriority(this, owner, priority);
+}
+
 void TextureResource::setRequired(bool value) const
 {
 	if (mTextureData != nullptr)
@@ -349,6 +358,11 @@ size_t TextureResource::getTotalTextureSize()
 	return total;
 }
 
+TextureDataManager::CacheStatistics TextureResource::getCacheStatistics()
+{
+	return sTextureDataManager.getStatistics();
+}
+
 bool TextureResource::unload()
 {
 	// Release the texture's resources
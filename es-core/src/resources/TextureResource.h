@@ -40,6 +40,7 @@ public:
 	bool isLoaded() const;
 	bool isTiled() const;
 	void prioritize() const;
+	void setLoadPriority(int priority, const void* owner) const;
 	void setRequired(bool value) const;
 	bool isScalable() const;
 
@@ -47,6 +48,7 @@ public:
 
 	static size_t getTotalMemUsage(bool includeQueueSize = true); // returns an approximation of total VRAM used by textures (in bytes)
 	static size_t getTotalTextureSize(); // returns the number of bytes that would be used if all textures were in memory
+	static TextureDataManager::CacheStatistics getCacheStatistics();
 	
 	virtual bool unload();
 	virtual void reload();
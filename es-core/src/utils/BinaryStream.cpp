@@ -0,0 +1,38 @@
+#include "utils/BinaryStream.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+
+#include <fstream>
+
+namespace Utils
+{
+	bool BinaryWriter::saveToFile(const std::string& path) const
+	{
+		std::string parent = Utils::FileSystem::getParent(path);
+		if (!Utils::FileSystem::exists(parent))
+			Utils::FileSystem::createDirectory(parent);
+
+		std::string tmpFile = path + ".tmp";
+
+		{
+			std::ofstream stream(WINSTRINGW(tmpFile), std::ios::out | std::ios::binary | std::ios::trunc);
+			if (!stream.is_open())
+				return false;
+
+			stream.write(mBuffer.data(), mBuffer.size());
+			stream.close();
+
+			if (stream.fail())
+			{
+				Utils::FileSystem::removeFile(tmpFile);
+				return false;
+			}
+		}
+
+		if (Utils::FileSystem::renameFile(tmpFile, path, true))
+			return true;
+
+		Utils::FileSystem::removeFile(tmpFile);
+		return false;
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+#ifndef ES_CORE_UTILS_BINARY_STREAM_H
+#define ES_CORE_UTILS_BINARY_STREAM_H
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+namespace Utils
+{
+	// Appends native endian values to a memory buffer. Used to build binary cache files.
+	class BinaryWriter
+	{
+	public:
+		template<typename T> void write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter::write requires a trivially copyable type");
+			mBuffer.append((const char*)&value, sizeof(T));
+		}
+
+		void writeString(const std::string& value)
+		{
+			write<uint32_t>((uint32_t)value.size());
+			mBuffer.append(value);
+		}
+
+		void writeBytes(const void* data, size_t size) { mBuffer.append((const char*)data, size); }
+
+		// Overwrites a value previously written at offset ( sizes & counts known after the payload is written )
+		template<typename T> void writeAt(size_t offset, const T& value)
+		{
+			if (offset + sizeof(T) <= mBuffer.size())
+				memcpy(&mBuffer[offset], &value, sizeof(T));
+		}
+
+		inline size_t size() const { return mBuffer.size(); }
+		inline const std::string& data() const { return mBuffer; }
+		inline void clear() { mBuffer.clear(); }
+
+		// Writes the buffer to a temporary file, then renames it so readers never see a partial file
+		bool saveToFile(const std::string& path) const;
+
+	private:
+		std::string mBuffer;
+	};
+
+	// Reads values written by BinaryWriter from a memory block ( usually a MemoryMappedFile ). Never reads past the end.
+	class BinaryReader
+	{
+	public:
+		BinaryReader(const void* data, size_t size) : mData((const unsigned char*)data), mSize(size), mPosition(0), mValid(data != nullptr) { }
+
+		template<typename T> bool read(T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "BinaryReader::read requires a trivially copyable type");
+
+			if (!mValid || mPosition + sizeof(T) > mSize)
+				return mValid = false;
+
+			memcpy(&value, mData + mPosition, sizeof(T));
+			mPosition += sizeof(T);
+			return true;
+		}
+
+		bool readString(std::string& value)
+		{
+			uint32_t length;
+			if (!read(length) || mPosition + length > mSize)
+				return mValid = false;
+
+			value.assign((const char*)mData + mPosition, length);
+			mPosition += length;
+			return true;
+		}
+
+		bool skip(size_t size)
+		{
+			if (!mValid || mPosition + size > mSize)
+				return mValid = false;
+
+			mPosition += size;
+			return true;
+		}
+
+		// Returns a reader over the next 'size' bytes & advances past them
+		BinaryReader subReader(size_t size)
+		{
+			if (!mValid || mPosition + size > mSize)
+			{
+				mValid = false;
+				return BinaryReader(nullptr, 0);
+			}
+
+			BinaryReader ret(mData + mPosition, size);
+			mPosition += size;
+			return ret;
+		}
+
+		inline const unsigned char* current() const { return mData + mPosition; }
+		inline size_t position() const { return mPosition; }
+		inline size_t remaining() const { return mSize - mPosition; }
+		inline bool isValid() const { return mValid; }
+		inline bool eof() const { return mPosition >= mSize; }
+
+	private:
+		const unsigned char* mData;
+		size_t mSize;
+		size_t mPosition;
+		bool   mValid;
+	};
+}
+
+#endif // ES_CORE_UTILS_BINARY_STREAM_H
@@ -1463,78 +1463,81 @@ namespace Utils
 			return pdfpath;
 		}
 		
-		std::string getFileCrc32(const std::string& filename)
+		bool getFileHashes(const std::string& filename, std::string* crc32, std::string* md5)
 		{
-			std::string hex;
-
 #if defined(_WIN32)
 			FILE* file = _wfopen(Utils::String::convertToWideString(filename).c_str(), L"rb");
 #else			
 			FILE* file = fopen(filename.c_str(), "rb");
 #endif
-			if (file)
+			if (file == nullptr)
+				return false;
+
+			// Retroarch CRC calculations are limited in size. See encoding_crc32.c
+			#define CRC32_MAX_SIZE (64 * 1024 * 1024)
+			// Large sequential reads, network shares are much faster with few big requests
+			#define HASH_BUFFER_SIZE (4 * 1024 * 1024)
+
+			char* buffer = new char[HASH_BUFFER_SIZE];
+			setvbuf(file, nullptr, _IONBF, 0);
+
+			MD5 md5Hash;
+			unsigned int file_crc32 = 0;
+			size_t crcSize = 0;
+
+			bool ok = true;
+
+			while (true)
 			{
-				// Retroarch CRC calculations are limited in size. See encoding_crc32.c
-				#define CRC32_BUFFER_SIZE 1048576
-				#define CRC32_MAX_MB 64
+				size_t size = fread(buffer, 1, HASH_BUFFER_SIZE, file);
+				if (size == 0)
+				{
+					ok = !ferror(file);
+					break;
+				}
 
-				char* buffer = new char[CRC32_BUFFER_SIZE];
-				if (buffer)
+				if (crc32 != nullptr && crcSize < CRC32_MAX_SIZE)
 				{
-					size_t size;
-					unsigned int file_crc32 = 0;
+					size_t len = std::min(size, (size_t) CRC32_MAX_SIZE - crcSize);
+					file_crc32 = Utils::Zip::ZipFile::computeCRC(file_crc32, buffer, len);
+					crcSize += len;
+				}
 
-					for (int i = 0; i < CRC32_MAX_MB; i++)
-					{
-						size = fread(buffer, 1, CRC32_BUFFER_SIZE, file);
-						if (size == 0)
-							break;
+				if (md5 != nullptr)
+					md5Hash.update(buffer, (MD5::size_type) size);
+				else if (crcSize >= CRC32_MAX_SIZE)
+					break;
+			}
 
-						file_crc32 = Utils::Zip::ZipFile::computeCRC(file_crc32, buffer, size);
-					}
+			delete[] buffer;
+			fclose(file);
 
-					hex = Utils::String::toHexString(file_crc32);
+			if (!ok)
+				return false;
 
-					delete buffer;
-				}
+			if (crc32 != nullptr)
+				*crc32 = Utils::String::toHexString(file_crc32);
 
-				fclose(file);
+			if (md5 != nullptr)
+			{
+				md5Hash.finalize();
+				*md5 = md5Hash.hexdigest();
 			}
 
+			return true;
+		}
+
+		std::string getFileCrc32(const std::string& filename)
+		{
+			std::string hex;
+			getFileHashes(filename, &hex, nullptr);
 			return hex;
 		}
 
 		std::string getFileMd5(const std::string& filename)
 		{
 			std::string hex;
-
-#if defined(_WIN32)
-			FILE* file = _wfopen(Utils::String::convertToWideString(filename).c_str(), L"rb");
-#else			
-			FILE* file = fopen(filename.c_str(), "rb");
-#endif
-			if (file)
-			{
-				#define CRCBUFFERSIZE 64 * 1024
-				char* buffer = new char[CRCBUFFERSIZE];
-
-				if (buffer)
-				{
-					MD5 md5;
-
-					size_t size;
-					while (size = fread(buffer, 1, CRCBUFFERSIZE, file))
-						md5.update(buffer, size);
-
-					md5.finalize();
-					hex = md5.hexdigest();
-
-					delete buffer;
-				}
-
-				fclose(file);
-			}
-
+			getFileHashes(filename, nullptr, &hex);
 			return hex;
 		}		
 
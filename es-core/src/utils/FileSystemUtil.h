@@ -84,6 +84,7 @@ namespace Utils
 
 		std::string getFileCrc32(const std::string& filename);
 		std::string getFileMd5(const std::string& filename);
+		bool		getFileHashes(const std::string& filename, std::string* crc32, std::string* md5); // Single read for both, nullptr to skip one
 
 		std::string changeExtension(const std::string& _path, const std::string& extension);
 
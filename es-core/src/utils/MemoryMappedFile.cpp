@@ -0,0 +1,115 @@
+#include "utils/MemoryMappedFile.h"
+#include "utils/StringUtil.h"
+
+#if WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Utils
+{
+#if WIN32
+	MemoryMappedFile::MemoryMappedFile() : mData(nullptr), mSize(0), mFile(INVALID_HANDLE_VALUE), mMapping(nullptr) { }
+#else
+	MemoryMappedFile::MemoryMappedFile() : mData(nullptr), mSize(0), mFile(-1) { }
+#endif
+
+	MemoryMappedFile::MemoryMappedFile(const std::string& path) : MemoryMappedFile()
+	{
+		open(path);
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		close();
+	}
+
+	bool MemoryMappedFile::open(const std::string& path)
+	{
+		close();
+
+#if WIN32
+		mFile = CreateFileW(Utils::String::convertToWideString(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (mFile == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(mFile, &fileSize) || fileSize.QuadPart == 0)
+		{
+			close();
+			return false;
+		}
+
+		mMapping = CreateFileMappingW(mFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (mMapping == nullptr)
+		{
+			close();
+			return false;
+		}
+
+		mData = MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0);
+		if (mData == nullptr)
+		{
+			close();
+			return false;
+		}
+
+		mSize = (size_t)fileSize.QuadPart;
+#else
+		mFile = ::open(path.c_str(), O_RDONLY);
+		if (mFile < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(mFile, &info) != 0 || info.st_size <= 0)
+		{
+			close();
+			return false;
+		}
+
+		void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, mFile, 0);
+		if (data == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+
+		mData = data;
+		mSize = (size_t)info.st_size;
+#endif
+
+		return true;
+	}
+
+	void MemoryMappedFile::close()
+	{
+#if WIN32
+		if (mData != nullptr)
+			UnmapViewOfFile(mData);
+
+		if (mMapping != nullptr)
+			CloseHandle(mMapping);
+
+		if (mFile != INVALID_HANDLE_VALUE)
+			CloseHandle(mFile);
+
+		mMapping = nullptr;
+		mFile = INVALID_HANDLE_VALUE;
+#else
+		if (mData != nullptr)
+			munmap(mData, mSize);
+
+		if (mFile >= 0)
+			::close(mFile);
+
+		mFile = -1;
+#endif
+
+		mData = nullptr;
+		mSize = 0;
+	}
+}
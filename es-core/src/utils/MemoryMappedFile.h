@@ -0,0 +1,41 @@
+#pragma once
+#ifndef ES_CORE_UTILS_MEMORY_MAPPED_FILE_H
+#define ES_CORE_UTILS_MEMORY_MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+namespace Utils
+{
+	// Read-only view of a whole file mapped in memory
+	class MemoryMappedFile
+	{
+	public:
+		MemoryMappedFile();
+		MemoryMappedFile(const std::string& path);
+		~MemoryMappedFile();
+
+		bool open(const std::string& path);
+		void close();
+
+		inline bool isOpen() const { return mData != nullptr; }
+		inline const unsigned char* data() const { return (const unsigned char*)mData; }
+		inline size_t size() const { return mSize; }
+
+	private:
+		MemoryMappedFile(const MemoryMappedFile&) = delete;
+		MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+		void*	mData;
+		size_t	mSize;
+
+#if WIN32
+		void*	mFile;
+		void*	mMapping;
+#else
+		int		mFile;
+#endif
+	};
+}
+
+#endif // ES_CORE_UTILS_MEMORY_MAPPED_FILE_H
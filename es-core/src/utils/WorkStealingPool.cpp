@@ -0,0 +1,177 @@
+#include "WorkStealingPool.h"
+#include "Log.h"
+
+namespace Utils
+{
+	static thread_local WorkStealingPool* sCurrentPool = nullptr;
+	static thread_local int sCurrentIndex = -1;
+
+	WorkStealingPool::WorkStealingPool(int threadCount) : mRunning(true), mQueuedCount(0)
+	{
+		if (threadCount <= 0)
+			threadCount = std::thread::hardware_concurrency();
+
+		if (threadCount <= 0)
+			threadCount = 1;
+
+		for (int i = 0; i <= threadCount; i++)
+			mQueues.push_back(new WorkQueue());
+
+		mThreads.reserve(threadCount);
+
+		for (int i = 0; i < threadCount; i++)
+			mThreads.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+	}
+
+	WorkStealingPool::~WorkStealingPool()
+	{
+		{
+			std::unique_lock<std::mutex> lock(mSleepLock);
+			mRunning = false;
+		}
+
+		mSleepCondition.notify_all();
+
+		for (std::thread& t : mThreads)
+			if (t.joinable())
+				t.join();
+
+		for (auto queue : mQueues)
+			delete queue;
+
+		mQueues.clear();
+	}
+
+	WorkStealingPool* WorkStealingPool::getInstance()
+	{
+		static WorkStealingPool instance;
+		return &instance;
+	}
+
+	void WorkStealingPool::queueWorkItem(TaskGroup& group, work_function work)
+	{
+		group.mPending++;
+
+		int index = (sCurrentPool == this && sCurrentIndex >= 0) ? sCurrentIndex : (int)mQueues.size() - 1;
+
+		WorkQueue* queue = mQueues[index];
+		queue->lock.lock();
+		queue->tasks.push_back({ work, &group });
+		queue->lock.unlock();
+
+		{
+			std::unique_lock<std::mutex> lock(mSleepLock);
+			mQueuedCount++;
+		}
+
+		mSleepCondition.notify_one();
+	}
+
+	bool WorkStealingPool::popTask(int index, Task& task)
+	{
+		if (index < 0 || index >= (int)mQueues.size())
+			return false;
+
+		WorkQueue* queue = mQueues[index];
+
+		std::unique_lock<std::mutex> lock(queue->lock);
+		if (queue->tasks.empty())
+			return false;
+
+		task = std::move(queue->tasks.back());
+		queue->tasks.pop_back();
+		return true;
+	}
+
+	bool WorkStealingPool::stealTask(int index, Task& task)
+	{
+		int count = (int)mQueues.size();
+
+		for (int i = 1; i <= count; i++)
+		{
+			int victim = (index + i) % count;
+			if (victim < 0)
+				victim += count;
+
+			if (victim == index)
+				continue;
+
+			WorkQueue* queue = mQueues[victim];
+
+			std::unique_lock<std::mutex> lock(queue->lock, std::try_to_lock);
+			if (!lock.owns_lock() || queue->tasks.empty())
+				continue;
+
+			task = std::move(queue->tasks.front());
+			queue->tasks.pop_front();
+			return true;
+		}
+
+		return false;
+	}
+
+	bool WorkStealingPool::tryRunTask(int index)
+	{
+		if (mQueuedCount.load() == 0)
+			return false;
+
+		Task task;
+		if (!popTask(index, task) && !stealTask(index, task))
+			return false;
+
+		mQueuedCount--;
+
+		try
+		{
+			task.work();
+		}
+		catch (const std::exception& e)
+		{
+			LOG(LogError) << "WorkStealingPool : task failed : " << e.what();
+		}
+		catch (...)
+		{
+			LOG(LogError) << "WorkStealingPool : task failed : unknown exception";
+		}
+
+		if (--task.group->mPending == 0)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mSleepLock);
+			}
+
+			mSleepCondition.notify_all();
+		}
+
+		return true;
+	}
+
+	void WorkStealingPool::workerLoop(int index)
+	{
+		sCurrentPool = this;
+		sCurrentIndex = index;
+
+		while (mRunning)
+		{
+			if (tryRunTask(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(mSleepLock);
+			mSleepCondition.wait_for(lock, std::chrono::milliseconds(50), [this] { return !mRunning || mQueuedCount.load() > 0; });
+		}
+	}
+
+	void WorkStealingPool::wait(TaskGroup& group)
+	{
+		int index = (sCurrentPool == this) ? sCurrentIndex : -1;
+
+		while (!group.isDone())
+		{
+			if (tryRunTask(index))
+				continue;
+
+			std::unique_lock<std::mutex> lock(mSleepLock);
+			mSleepCondition.wait_for(lock, std::chrono::milliseconds(5), [this, &group] { return group.isDone() || mQueuedCount.load() > 0; });
+		}
+	}
+}
@@ -0,0 +1,77 @@
+#ifndef __WORKSTEALINGPOOL
+#define __WORKSTEALINGPOOL
+
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+namespace Utils
+{
+	// Thread pool where each worker owns a deque of tasks.
+	// Tasks queued from a worker go to its own deque ( LIFO ), idle workers steal from the front of other deques.
+	// Well suited for recursive workloads ( directory scans ) where tasks spawn subtasks.
+	class WorkStealingPool
+	{
+	public:
+		typedef std::function<void(void)> work_function;
+
+		// Tracks the completion of a set of tasks ( and the subtasks they queue in the same group )
+		class TaskGroup
+		{
+		public:
+			TaskGroup() : mPending(0) { }
+			bool isDone() { return mPending.load() == 0; }
+
+		private:
+			friend class WorkStealingPool;
+			std::atomic<int> mPending;
+		};
+
+		WorkStealingPool(int threadCount = 0);
+		~WorkStealingPool();
+
+		void queueWorkItem(TaskGroup& group, work_function work);
+
+		// Waits for all tasks of the group to be processed. The calling thread helps processing tasks while waiting.
+		void wait(TaskGroup& group);
+
+		int getThreadCount() { return (int)mThreads.size(); }
+
+		// Process-wide pool, shared so that concurrent users don't oversubscribe the CPU
+		static WorkStealingPool* getInstance();
+
+	private:
+		struct Task
+		{
+			work_function work;
+			TaskGroup*	  group;
+		};
+
+		struct WorkQueue
+		{
+			std::mutex		 lock;
+			std::deque<Task> tasks;
+		};
+
+		void workerLoop(int index);
+		bool tryRunTask(int index);
+		bool popTask(int index, Task& task);
+		bool stealTask(int index, Task& task);
+
+		// The last queue receives tasks from threads that are not part of the pool
+		std::vector<WorkQueue*>	 mQueues;
+		std::vector<std::thread> mThreads;
+
+		std::atomic<bool>		 mRunning;
+		std::atomic<int>		 mQueuedCount;
+
+		std::mutex				 mSleepLock;
+		std::condition_variable	 mSleepCondition;
+	};
+}
+
+#endif